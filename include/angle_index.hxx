@@ -0,0 +1,148 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_ANGLE_INDEX_HXX)
+#define PCS_ANGLE_INDEX_HXX
+
+#include "bam64.hxx"
+#include "radix_sort.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// a sorted, flat index of bam64 angles, each with a payload, e.g., the index of a target in some other array. the keys and
+	// payloads are separate arrays, so the searches only touch the keys.
+	//
+	// an arc query is everything from a start angle, going in the positive direction, to an end angle, both included. an arc
+	// that crosses zero is split into the part up to the end of the keys and the part from the start of them, so every query
+	// is at most two binary searches, and its result is at most two ranges of positions in the sorted arrays.
+	//
+
+	// positions [begin, end) in an angle_index
+	struct angle_index_range
+	{
+		std::size_t begin = 0;
+		std::size_t end = 0;
+
+		[[nodiscard]] constexpr std::size_t size() const noexcept						{ return end - begin; }
+		[[nodiscard]] constexpr bool empty() const noexcept								{ return end == begin; }
+	};
+
+	// the result of an arc query. the ranges are in arc order, so the first one holds the keys closest to the start.
+	struct angle_index_arc
+	{
+		angle_index_range ranges[2];
+
+		[[nodiscard]] constexpr std::size_t size() const noexcept						{ return ranges[0].size() + ranges[1].size(); }
+		[[nodiscard]] constexpr bool empty() const noexcept								{ return size() == 0; }
+	};
+
+	struct angle_index
+	{
+		private:
+
+			std::vector<bam64> keys;		// sorted
+			std::vector<std::size_t> payloads;
+
+			// first position with a key >= value, or > value
+			std::size_t lower_bound(bam64 value) const noexcept
+			{
+				return static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), value) - keys.begin());
+			}
+
+			std::size_t upper_bound(bam64 value) const noexcept
+			{
+				return static_cast<std::size_t>(std::upper_bound(keys.begin(), keys.end(), value) - keys.begin());
+			}
+
+		public:
+
+			angle_index() = default;
+
+			// the payload of each angle is its position in angles
+			explicit angle_index(std::span<const bam64> angles)
+				: keys(angles.begin(), angles.end()), payloads(angles.size())
+			{
+				for (std::size_t i = 0; i < angles.size(); ++i)
+					payloads[i] = i;
+
+				radix_sort(std::span<bam64>(keys), std::span<std::size_t>(payloads));
+			}
+
+			angle_index(std::span<const bam64> angles, std::span<const std::size_t> angle_payloads)
+				: keys(angles.begin(), angles.end()), payloads(angle_payloads.begin(), angle_payloads.end())
+			{
+				if (angles.size() != angle_payloads.size())
+					throw std::invalid_argument("angle_index: angles and payloads need the same size");
+
+				radix_sort(std::span<bam64>(keys), std::span<std::size_t>(payloads));
+			}
+
+			[[nodiscard]] std::size_t size() const noexcept								{ return keys.size(); }
+			[[nodiscard]] bool empty() const noexcept									{ return keys.empty(); }
+
+			// the angle and payload at a position in sorted order
+			[[nodiscard]] bam64 angle(std::size_t position) const noexcept				{ return keys[position]; }
+			[[nodiscard]] std::size_t payload(std::size_t position) const noexcept		{ return payloads[position]; }
+
+			// all the payloads, in sorted order of their angles
+			[[nodiscard]] std::span<const std::size_t> sorted_payloads() const noexcept	{ return payloads; }
+
+			// everything from start to end, going in the positive direction, including both. when start == end, that is just the
+			// one angle, not the whole circle.
+			[[nodiscard]] angle_index_arc arc(bam64 start, bam64 end) const noexcept
+			{
+				if (start <= end)
+					return angle_index_arc{ .ranges = { { .begin = lower_bound(start), .end = upper_bound(end) }, {} } };
+
+				// across zero
+				return angle_index_arc{ .ranges = { { .begin = lower_bound(start), .end = keys.size() },
+													{ .begin = 0, .end = upper_bound(end) } } };
+			}
+
+			// everything where within_distance(angle, center, tolerance) is true
+			[[nodiscard]] angle_index_arc within(bam64 center, bam64 tolerance) const noexcept
+			{
+				if (tolerance.value >= pcs::half)
+					return angle_index_arc{ .ranges = { { .begin = 0, .end = keys.size() }, {} } };
+
+				return arc(center - tolerance, center + tolerance);
+			}
+
+			// call f(angle, payload) for everything in an arc, in arc order
+			template <typename F>
+			void for_each(const angle_index_arc &found, F &&f) const
+			{
+				for (const auto &range : found.ranges)
+				{
+					for (std::size_t i = range.begin; i < range.end; ++i)
+						f(keys[i], payloads[i]);
+				}
+			}
+
+			// append the payloads in an arc, in arc order
+			void payloads_in(const angle_index_arc &found, std::vector<std::size_t> &output) const
+			{
+				for (const auto &range : found.ranges)
+					output.insert(output.end(), payloads.begin() + static_cast<std::ptrdiff_t>(range.begin), payloads.begin() + static_cast<std::ptrdiff_t>(range.end));
+			}
+	};
+
+}	// namespace pcs
+
+// closing include guard
+#endif
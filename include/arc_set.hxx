@@ -0,0 +1,396 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_ARC_SET_HXX)
+#define PCS_ARC_SET_HXX
+
+#include "bam64.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// a set of arcs on the circle, in bam64.
+	//
+	// arcs come in as [start, end), going in the positive direction from start, so an arc with start > end crosses zero. inside
+	// the set, they are kept as sorted intervals that don't overlap or touch, and don't wrap, so an arc across zero is split in
+	// two: one that ends at the top of the bam64 range, and one that starts at zero. the intervals include both of their ends,
+	// which lets the whole circle be one interval.
+	//
+	// since the intervals are always sorted, union, intersection, difference, complement, and the coverage of both of two sets
+	// are one merge over both sets, add() is one pass over the set, and contains() is a binary search. the first InlineCapacity
+	// intervals are stored in the set itself, so sets of a few arcs never allocate.
+	//
+
+	// first to last, including both, where first <= last
+	struct arc_interval
+	{
+		bam64 first;
+		bam64 last;
+
+		[[nodiscard]] constexpr bool operator ==(const arc_interval &other) const noexcept = default;
+	};
+
+	template <std::size_t InlineCapacity = 8>
+	struct basic_arc_set
+	{
+		static_assert(InlineCapacity > 0, "basic_arc_set needs some inline capacity");
+
+		private:
+
+			static constexpr unsigned long long top = ~0ULL;
+
+			// only the first count are ever read, so these aren't initialized, and copies only copy those
+			arc_interval inline_intervals[InlineCapacity];
+			std::vector<arc_interval> heap_intervals;			// only used when there are more than InlineCapacity
+			std::size_t count = 0;
+
+			[[nodiscard]] constexpr arc_interval *data() noexcept
+			{
+				return heap_intervals.empty() ? inline_intervals : heap_intervals.data();
+			}
+
+			[[nodiscard]] constexpr const arc_interval *data() const noexcept
+			{
+				return heap_intervals.empty() ? inline_intervals : heap_intervals.data();
+			}
+
+			// moves to the heap once the inline intervals are full
+			constexpr void push_back(arc_interval next)
+			{
+				if (!heap_intervals.empty())
+				{
+					heap_intervals.push_back(next);
+				}
+				else if (count < InlineCapacity)
+				{
+					inline_intervals[count] = next;
+				}
+				else
+				{
+					heap_intervals.reserve(2 * InlineCapacity);
+					heap_intervals.assign(inline_intervals, inline_intervals + count);
+					heap_intervals.push_back(next);
+				}
+
+				++count;
+			}
+
+			// intervals have to be added in order of first. one that overlaps or touches the last one is merged into it.
+			constexpr void append(arc_interval next)
+			{
+				if (count > 0)
+				{
+					arc_interval &back = data()[count - 1];
+					if ((back.last.value == top) || (next.first.value <= back.last.value + 1))
+					{
+						if (back.last < next.last)
+							back.last = next.last;
+
+						return;
+					}
+				}
+
+				push_back(next);
+			}
+
+			// merge first to last into the set where it belongs
+			constexpr void insert(bam64 first, bam64 last)
+			{
+				arc_interval next{ .first = first, .last = last };
+				arc_interval *intervals = data();
+
+				// [overlap, after) overlap or touch next. the intervals are sorted, so these are counts, which don't need a branch for
+				// each interval like searches do.
+				std::size_t overlap = 0;
+				std::size_t after = 0;
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					overlap += (intervals[i].last.value < next.first.value - 1) && (next.first.value != 0);
+					after += (next.last.value == top) || (intervals[i].first.value <= next.last.value + 1);
+				}
+
+				if (overlap == after)
+				{
+					// carry each interval after it up one, which is quicker than a memmove for a few
+					for (std::size_t i = overlap; i < count; ++i)
+						std::swap(next, intervals[i]);
+
+					push_back(next);
+					return;
+				}
+
+				if (intervals[overlap].first < next.first)
+					next.first = intervals[overlap].first;
+
+				if (next.last < intervals[after - 1].last)
+					next.last = intervals[after - 1].last;
+
+				intervals[overlap] = next;
+				const std::size_t removed = after - overlap - 1;
+				for (std::size_t i = after; i < count; ++i)
+					intervals[i - removed] = intervals[i];
+
+				count -= removed;
+				if (!heap_intervals.empty())
+					heap_intervals.resize(count);
+			}
+
+		public:
+
+			constexpr basic_arc_set() noexcept = default;
+
+			constexpr basic_arc_set(const basic_arc_set &other)
+				: heap_intervals(other.heap_intervals), count(other.count)
+			{
+				if (heap_intervals.empty())
+					std::copy(other.inline_intervals, other.inline_intervals + count, inline_intervals);
+			}
+
+			constexpr basic_arc_set(basic_arc_set &&other) noexcept
+				: heap_intervals(std::move(other.heap_intervals)), count(other.count)
+			{
+				if (heap_intervals.empty())
+					std::copy(other.inline_intervals, other.inline_intervals + count, inline_intervals);
+
+				other.clear();
+			}
+
+			constexpr basic_arc_set &operator =(const basic_arc_set &other)
+			{
+				if (this != &other)
+				{
+					heap_intervals = other.heap_intervals;
+					count = other.count;
+					if (heap_intervals.empty())
+						std::copy(other.inline_intervals, other.inline_intervals + count, inline_intervals);
+				}
+
+				return *this;
+			}
+
+			constexpr basic_arc_set &operator =(basic_arc_set &&other) noexcept
+			{
+				if (this != &other)
+				{
+					heap_intervals = std::move(other.heap_intervals);
+					count = other.count;
+					if (heap_intervals.empty())
+						std::copy(other.inline_intervals, other.inline_intervals + count, inline_intervals);
+
+					other.clear();
+				}
+
+				return *this;
+			}
+
+			// the arc [start, end), going in the positive direction. when start == end, the set is empty.
+			constexpr basic_arc_set(bam64 start, bam64 end)
+			{
+				add(start, end);
+			}
+
+			[[nodiscard]] static constexpr basic_arc_set full()
+			{
+				basic_arc_set everything;
+				everything.append({ .first = { .value = 0 }, .last = { .value = top } });
+				return everything;
+			}
+
+			// the intervals, sorted
+			[[nodiscard]] constexpr std::size_t size() const noexcept								{ return count; }
+			[[nodiscard]] constexpr bool empty() const noexcept										{ return count == 0; }
+			[[nodiscard]] constexpr const arc_interval &operator [](std::size_t i) const noexcept	{ return data()[i]; }
+			[[nodiscard]] constexpr const arc_interval *begin() const noexcept						{ return data(); }
+			[[nodiscard]] constexpr const arc_interval *end() const noexcept						{ return data() + count; }
+
+			[[nodiscard]] constexpr bool is_full() const noexcept
+			{
+				return (count == 1) && (data()[0].first.value == 0) && (data()[0].last.value == top);
+			}
+
+			// keeps the heap storage, if there is any, for reuse
+			constexpr void clear() noexcept
+			{
+				heap_intervals.clear();
+				count = 0;
+			}
+
+			// add the arc [start, end), in place. one across zero is added as two intervals.
+			constexpr void add(bam64 start, bam64 end)
+			{
+				if (start == end)
+					return;
+
+				if (start < end)
+				{
+					insert(start, { .value = end.value - 1 });
+				}
+				else
+				{
+					if (end.value != 0)
+						insert({ .value = 0 }, { .value = end.value - 1 });
+
+					insert(start, { .value = top });
+				}
+			}
+
+			[[nodiscard]] constexpr bool contains(bam64 angle) const noexcept
+			{
+				// the last interval that starts at or before angle
+				std::size_t low = 0;
+				std::size_t high = count;
+				while (low < high)
+				{
+					const std::size_t middle = low + (high - low) / 2;
+					if (data()[middle].first <= angle)
+						low = middle + 1;
+					else
+						high = middle;
+				}
+
+				return (low > 0) && (angle <= data()[low - 1].last);
+			}
+
+			// the fraction of the circle covered, in [0, 1]
+			[[nodiscard]] constexpr double coverage() const noexcept
+			{
+				if (is_full())
+					return 1.0;
+
+				// anything less than the whole circle fits
+				unsigned long long covered = 0;
+				for (const auto &interval : *this)
+					covered += interval.last.value - interval.first.value + 1;
+
+				return static_cast<double>(covered) * 0x1p-64;
+			}
+
+			// the fraction of the circle covered by both this and other, without making their intersection
+			[[nodiscard]] constexpr double coverage(const basic_arc_set &other) const noexcept
+			{
+				if (is_full())
+					return other.coverage();
+
+				unsigned long long covered = 0;
+				const arc_interval *left = begin();
+				const arc_interval *right = other.begin();
+				while ((left != end()) && (right != other.end()))
+				{
+					const bam64 first = (left->first < right->first) ? right->first : left->first;
+					const bam64 last = (left->last < right->last) ? left->last : right->last;
+					if (first <= last)
+						covered += last.value - first.value + 1;
+
+					if (left->last < right->last)
+						++left;
+					else
+						++right;
+				}
+
+				return static_cast<double>(covered) * 0x1p-64;
+			}
+
+			// everything not in the set
+			[[nodiscard]] constexpr basic_arc_set complement() const
+			{
+				basic_arc_set others;
+				unsigned long long next = 0;
+				for (const auto &interval : *this)
+				{
+					if (next < interval.first.value)
+						others.append({ .first = { .value = next }, .last = { .value = interval.first.value - 1 } });
+
+					if (interval.last.value == top)
+						return others;
+
+					next = interval.last.value + 1;
+				}
+
+				others.append({ .first = { .value = next }, .last = { .value = top } });
+				return others;
+			}
+
+			// union
+			[[nodiscard]] friend constexpr basic_arc_set operator |(const basic_arc_set &lhs, const basic_arc_set &rhs)
+			{
+				basic_arc_set both;
+				const arc_interval *left = lhs.begin();
+				const arc_interval *right = rhs.begin();
+				while ((left != lhs.end()) || (right != rhs.end()))
+				{
+					if ((right == rhs.end()) || ((left != lhs.end()) && (left->first <= right->first)))
+						both.append(*left++);
+					else
+						both.append(*right++);
+				}
+
+				return both;
+			}
+
+			// intersection
+			[[nodiscard]] friend constexpr basic_arc_set operator &(const basic_arc_set &lhs, const basic_arc_set &rhs)
+			{
+				basic_arc_set common;
+				const arc_interval *left = lhs.begin();
+				const arc_interval *right = rhs.begin();
+				while ((left != lhs.end()) && (right != rhs.end()))
+				{
+					const bam64 first = (left->first < right->first) ? right->first : left->first;
+					const bam64 last = (left->last < right->last) ? left->last : right->last;
+					if (first <= last)
+						common.append({ .first = first, .last = last });
+
+					// the one that ends first can't overlap anything else
+					if (left->last < right->last)
+						++left;
+					else
+						++right;
+				}
+
+				return common;
+			}
+
+			// difference, everything in lhs that isn't in rhs
+			[[nodiscard]] friend constexpr basic_arc_set operator -(const basic_arc_set &lhs, const basic_arc_set &rhs)
+			{
+				return lhs & rhs.complement();
+			}
+
+			constexpr basic_arc_set &operator |=(const basic_arc_set &rhs)					{ return *this = *this | rhs; }
+			constexpr basic_arc_set &operator &=(const basic_arc_set &rhs)					{ return *this = *this & rhs; }
+			constexpr basic_arc_set &operator -=(const basic_arc_set &rhs)					{ return *this = *this - rhs; }
+
+			[[nodiscard]] friend constexpr bool operator ==(const basic_arc_set &lhs, const basic_arc_set &rhs) noexcept
+			{
+				if (lhs.count != rhs.count)
+					return false;
+
+				for (std::size_t i = 0; i < lhs.count; ++i)
+				{
+					if (lhs[i] != rhs[i])
+						return false;
+				}
+
+				return true;
+			}
+	};
+
+	using arc_set = basic_arc_set<>;
+
+}	// namespace pcs
+
+// closing include guard
+#endif
@@ -0,0 +1,234 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_BAM128_HXX)
+#define PCS_BAM128_HXX
+
+#include "bam64.hxx"
+#include "periodic.hxx"
+
+#include <bit>
+#include <compare>
+
+// bam128 needs a native 128-bit integer, which gcc and clang have, but msvc doesn't
+#if defined(__SIZEOF_INT128__)
+#define PCS_HAS_BAM128 1
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// a 128-bit bam, for phase that is accumulated for a very long time. a frequency word that isn't a dyadic fraction of a
+	// turn has a rounding error in its last bit, and with 64 bits that error adds up to a visible drift after about 2^40 steps.
+	// with 128 bits it is 2^64 times smaller.
+	//
+	// a double has only 53 bits, so the builders take a dd_real, which has about 106 bits, and fraction() gives a dd_real back.
+	//
+
+	// the double-double type from cxcm
+	using dd_real = cxcm::dd_real::dd_real;
+
+	namespace detail
+	{
+		__extension__ using uint128 = unsigned __int128;
+
+		// 2pi as a double-double
+		inline constexpr dd_real dd_two_pi = dd_real(6.283185307179586, 2.4492935982947064e-16);
+
+		// exact 128-bit bam from a turn value, like bam64::from_turns_exact(). a double is mantissa * 2^exponent with an
+		// integral 53-bit mantissa, so the bam is the mantissa shifted by (exponent + 128), modulo 2^128. nan and infinity give zero.
+		inline constexpr uint128 bam128_from_double(double turns, bam_rounding rounding) noexcept
+		{
+			const unsigned long long bits = std::bit_cast<unsigned long long>(turns);
+			const bool negative = (bits >> 63) != 0;
+			const int biased_exponent = static_cast<int>((bits >> 52) & 0x7ff);
+			if (biased_exponent == 0x7ff)
+				return 0;
+
+			const bool is_normal = (biased_exponent != 0);
+			const unsigned long long mantissa = (bits & 0x000fffffffffffff) | (is_normal ? 0x0010000000000000 : 0);
+			const int shift = (is_normal ? biased_exponent : 1) - 1075 + 128;
+
+			uint128 magnitude = 0;
+			bool round_up = false;
+			if (shift >= 128)
+			{
+				// only whole turns
+			}
+			else if (shift >= 0)
+			{
+				magnitude = static_cast<uint128>(mantissa) << shift;
+			}
+			else
+			{
+				// same rounding as bam64::from_turns_exact()
+				const int right = (-shift < 63) ? -shift : 63;
+				magnitude = mantissa >> right;
+				const unsigned long long lost = mantissa & ((1ULL << right) - 1);
+				const unsigned long long halfway = 1ULL << (right - 1);
+				round_up = (rounding == bam_rounding::nearest) ? ((lost > halfway) || ((lost == halfway) && ((magnitude & 1) != 0)))
+																: (negative && (lost != 0));
+			}
+
+			const uint128 rounded = magnitude + (round_up ? 1 : 0);
+			return negative ? (0 - rounded) : rounded;
+		}
+
+		// 2^exponent, for exponents that give a normal double
+		inline constexpr double bam128_pow2(int exponent) noexcept
+		{
+			return std::bit_cast<double>(static_cast<unsigned long long>(exponent + 1023) << 52);
+		}
+
+	}	// namespace detail
+
+	// binary angular measurement with 128 bits of precision. see bam<UInt> for what a bam is.
+	struct bam128
+	{
+		// the bam value
+		detail::uint128 value;
+
+
+		// builders
+
+		[[nodiscard]] static constexpr bam128 from_bam_value(detail::uint128 bam_value) noexcept	{ return { .value = bam_value }; }
+
+		// the most significant 64 bits, then the least significant 64 bits
+		[[nodiscard]] static constexpr bam128 from_words(unsigned long long high, unsigned long long low) noexcept
+		{
+			return { .value = (static_cast<detail::uint128>(high) << 64) | low };
+		}
+
+		// lossless, with zeros for the extra low bits
+		[[nodiscard]] static constexpr bam128 from_bam64(bam64 bam) noexcept
+		{
+			return { .value = static_cast<detail::uint128>(bam.value) << 64 };
+		}
+
+		// bam from a turn value, where whole turns wrap. the high part is converted exactly, and the rounding only applies to the
+		// low part, so the result is exact when it has a precision of 128 bits or less. that is true whenever |turns| is
+		// at least 2^-75 and the parts don't overlap, which is the case for every normalized dd_real.
+		[[nodiscard]] static constexpr bam128 from_turns(dd_real turns, bam_rounding rounding = bam_rounding::nearest) noexcept
+		{
+			return { .value = detail::bam128_from_double(turns[0], bam_rounding::truncate) + detail::bam128_from_double(turns[1], rounding) };
+		}
+
+		// bam from value / base. the division is done with dd_real, so it is good to about 2^-104 of value / base, which means
+		// the number of whole periods in value takes bits away from the fraction, the same as it does for bam64::from_base().
+		[[nodiscard]] static constexpr bam128 from_base(dd_real value, dd_real base, bam_rounding rounding = bam_rounding::nearest) noexcept
+		{
+			if (base[0] == 0.0)	{ return { .value = 0 }; }
+			return bam128::from_turns(value / base, rounding);
+		}
+
+
+		// modifier functions
+
+		// change underlying bam value
+		constexpr void operator()(detail::uint128 arg) noexcept										{ this->value = arg; }
+
+		// the position half a period away
+		[[nodiscard]] constexpr bam128 make_opposite() const noexcept								{ return { .value = this->value + (static_cast<detail::uint128>(1) << 127) }; }
+
+
+		// width conversions
+
+		// the most significant 64 bits
+		[[nodiscard]] constexpr unsigned long long high_word() const noexcept						{ return static_cast<unsigned long long>(this->value >> 64); }
+
+		// the least significant 64 bits
+		[[nodiscard]] constexpr unsigned long long low_word() const noexcept						{ return static_cast<unsigned long long>(this->value); }
+
+		// the same as bam<UInt>::narrow(), rounding to nearest, ties to even by default, and wrapping around to zero from
+		// just below a full period
+		[[nodiscard]] constexpr bam64 to_bam64(bam_rounding rounding = bam_rounding::nearest) const noexcept
+		{
+			const unsigned long long low = this->low_word();
+			const bool round_up = (rounding == bam_rounding::nearest) && ((low > 0x8000000000000000) || ((low == 0x8000000000000000) && ((this->high_word() & 1) != 0)));
+			return { .value = this->high_word() + (round_up ? 1 : 0) };
+		}
+
+
+		// periodic properties
+
+		// fraction - period value in range [0, 1), as a dd_real. the high part is the leading 53 bits, truncated, so unlike
+		// rounding, it is always less than 1.0. the low part is the rest of the bits rounded to a double, which is less
+		// than an ulp of the high part, so the pair has at least 106 bits.
+		[[nodiscard]] constexpr dd_real fraction() const noexcept
+		{
+			const unsigned long long high = this->high_word();
+			const int width = 128 - ((high != 0) ? std::countl_zero(high) : (64 + std::countl_zero(this->low_word())));
+			const int shift = (width > 53) ? (width - 53) : 0;
+
+			// only the top 64 bits of the rest matter, and 64-bit integers convert to double much faster than 128-bit ones
+			const auto leading = static_cast<unsigned long long>(this->value >> shift);
+			const int rest_shift = (shift > 64) ? (shift - 64) : 0;
+			const auto rest = static_cast<unsigned long long>((this->value & ((detail::uint128{1} << shift) - 1)) >> rest_shift);
+
+			return dd_real(static_cast<double>(leading) * detail::bam128_pow2(shift - 128), static_cast<double>(rest) * detail::bam128_pow2(rest_shift - 128));
+		}
+
+		// fraction - period value in range [0, 1) * base
+		[[nodiscard]] constexpr dd_real fraction(dd_real base) const noexcept						{ return base * this->fraction(); }
+
+
+		// unary operators
+
+		// unary plus is identity operation
+		[[nodiscard]] constexpr bam128 operator +() const noexcept									{ return { .value = this->value }; }
+
+		// two's complement negation
+		[[nodiscard]] constexpr bam128 operator ~() const noexcept									{ return { .value = ~(this->value) + 1 }; }
+
+		// negation is same as complement for a bam
+		[[nodiscard]] constexpr bam128 operator -() const noexcept									{ return { .value = ~(this->value) + 1 }; }
+
+
+		// binary operators
+
+		// relies on unsigned overflow
+		[[nodiscard]] constexpr bam128 operator +(bam128 rhs) const noexcept						{ return { .value = this->value + rhs.value }; }
+
+		// relies on unsigned underflow
+		[[nodiscard]] constexpr bam128 operator -(bam128 rhs) const noexcept						{ return { .value = this->value - rhs.value }; }
+
+
+		// comparison functions
+
+		[[nodiscard]] constexpr std::strong_ordering operator <=>(const bam128 &other) const noexcept		{ return this->value <=> other.value; }
+
+		[[nodiscard]] constexpr bool operator ==(const bam128 &other) const noexcept						{ return this->value == other.value; }
+
+	};	// struct bam128
+
+	static_assert(sizeof(bam128) == 16);
+
+
+	// make bam128s from various periodic units, with the whole periods wrapped away
+
+	[[nodiscard]] inline constexpr bam128 bam128_from_turns(dd_real turns) noexcept					{ return bam128::from_turns(turns); }
+	[[nodiscard]] inline constexpr bam128 bam128_from_degrees(dd_real degrees) noexcept				{ return bam128::from_base(degrees,	dd_real(detail::degree_base)); }
+	[[nodiscard]] inline constexpr bam128 bam128_from_radians(dd_real radians) noexcept				{ return bam128::from_base(radians,	detail::dd_two_pi); }
+	[[nodiscard]] inline constexpr bam128 bam128_from_base(dd_real value, dd_real base) noexcept		{ return bam128::from_base(value,	base); }
+
+
+	// convert bam128 to various periodic units
+
+	[[nodiscard]] inline constexpr dd_real to_fraction(bam128 bam) noexcept							{ return bam.fraction(); }
+	[[nodiscard]] inline constexpr dd_real to_degrees(bam128 bam) noexcept							{ return bam.fraction(dd_real(detail::degree_base)); }
+	[[nodiscard]] inline constexpr dd_real to_radians(bam128 bam) noexcept							{ return bam.fraction(detail::dd_two_pi); }
+	[[nodiscard]] inline constexpr dd_real to_base(bam128 bam, dd_real base) noexcept				{ return bam.fraction(base); }
+
+}	// namespace pcs
+
+#endif
+
+// closing include guard
+#endif
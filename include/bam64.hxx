@@ -8,8 +8,18 @@
 #if !defined(PCS_BAM64_HXX)
 #define PCS_BAM64_HXX
 
+#include <bit>
 #include <compare>
+#include <concepts>
+#include <limits>
 #include <numbers>
+#include <span>
+#include <cstddef>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+#include <intrin.h>
+#endif
 
 namespace pcs
 {
@@ -53,6 +63,101 @@ namespace pcs
 		// absolute value
 		inline constexpr double abs(double value) noexcept				{ return (value < 0) ? -value : value; }
 
+		// full 64-bit x 64-bit -> 128-bit unsigned multiply. returns the low 64 bits, and sets high to the high 64 bits.
+		inline constexpr unsigned long long umul128(unsigned long long a, unsigned long long b, unsigned long long &high) noexcept
+		{
+#if defined(__SIZEOF_INT128__)
+			__extension__ using uint128 = unsigned __int128;
+			const uint128 product = static_cast<uint128>(a) * b;
+			high = static_cast<unsigned long long>(product >> 64);
+			return static_cast<unsigned long long>(product);
+#else
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+			if (!std::is_constant_evaluated())
+			{
+				return _umul128(a, b, &high);
+			}
+#endif
+			// schoolbook multiply with 32-bit halves
+			const unsigned long long a_lo = a & 0xffffffff;
+			const unsigned long long a_hi = a >> 32;
+			const unsigned long long b_lo = b & 0xffffffff;
+			const unsigned long long b_hi = b >> 32;
+
+			const unsigned long long lo_lo = a_lo * b_lo;
+			const unsigned long long lo_hi = a_lo * b_hi;
+			const unsigned long long hi_lo = a_hi * b_lo;
+			const unsigned long long hi_hi = a_hi * b_hi;
+
+			const unsigned long long middle = (lo_lo >> 32) + (lo_hi & 0xffffffff) + (hi_lo & 0xffffffff);
+			high = hi_hi + (lo_hi >> 32) + (hi_lo >> 32) + (middle >> 32);
+			return (middle << 32) | (lo_lo & 0xffffffff);
+#endif
+		}
+
+		// 128-bit / 64-bit unsigned divide of (high, low) by divisor. high must be less than divisor, so the quotient fits in
+		// 64 bits. returns the quotient, and sets remainder.
+		inline constexpr unsigned long long udiv128(unsigned long long high, unsigned long long low, unsigned long long divisor, unsigned long long &remainder) noexcept
+		{
+#if defined(__SIZEOF_INT128__)
+			__extension__ using uint128 = unsigned __int128;
+			const uint128 dividend = (static_cast<uint128>(high) << 64) | low;
+			remainder = static_cast<unsigned long long>(dividend % divisor);
+			return static_cast<unsigned long long>(dividend / divisor);
+#else
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+			if (!std::is_constant_evaluated())
+			{
+				return _udiv128(high, low, divisor, &remainder);
+			}
+#endif
+			// shift and subtract, one quotient bit at a time. the running remainder is always less than divisor, and the
+			// bit shifted out of the top of it is kept in carry.
+			unsigned long long quotient = 0;
+			for (int i = 63; i >= 0; --i)
+			{
+				const bool carry = (high >> 63) != 0;
+				high = (high << 1) | ((low >> i) & 1);
+				quotient <<= 1;
+				if (carry || (high >= divisor))
+				{
+					high -= divisor;
+					quotient |= 1;
+				}
+			}
+			remainder = high;
+			return quotient;
+#endif
+		}
+
+		// 1/(2pi) in binary, most significant word first, after enough zero words that a window for the smallest subnormal
+		// doesn't start before the table. bit i of the bits after the zero words has a weight of 2^-(i + 1). 1280 bits
+		// is enough to reduce any finite double.
+		inline constexpr int inverse_two_pi_zero_words = 17;
+		inline constexpr unsigned long long inverse_two_pi_bits[] =
+		{
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0x28be60db9391054a, 0x7f09d5f47d4d3770, 0x36d8a5664f10e410, 0x7f9458eaf7aef158,
+			0x6dc91b8e909374b8, 0x01924bba82746487, 0x3f877ac72c4a69cf, 0xba208d7d4baed121,
+			0x3a671c09ad17df90, 0x4e64758e60d4ce7d, 0x272117e2ef7e4a0e, 0xc7fe25fff7816603,
+			0xfbcbc462d6829b47, 0xdb4d9fb3c9f2c26d, 0xd3d18fd9a797fa8b, 0x5d49eeb1faf97c5e,
+			0xcf41ce7de294a4ba, 0x9afed7ec47e35742, 0x1580cc11bf1edaea, 0xfc33ef0826bd0d87
+		};
+
+		// 256 bits of 1/(2pi) as four words, starting at bit first_bit, which is at least -1074 for the smallest subnormal
+		inline constexpr void inverse_two_pi_window(int first_bit, unsigned long long (&window)[4]) noexcept
+		{
+			const int index = first_bit + 64 * inverse_two_pi_zero_words;
+			const int word = index / 64;
+			const int shift = index % 64;
+
+			// the double shift of the next word avoids an undefined shift by 64 when shift is 0
+			for (int i = 0; i < 4; ++i)
+			{
+				window[i] = (inverse_two_pi_bits[word + i] << shift) | ((inverse_two_pi_bits[word + i + 1] >> 1) >> (63 - shift));
+			}
+		}
+
 	}	// namespace detail
 
 	// convert an angle to a representation that is in the range [0, 2pi)
@@ -140,9 +245,24 @@ namespace pcs
 		return static_cast<std::underlying_type_t<E>>(e);
 	}
 
-	// 64-bit binary angular measurement (bam).
-	// a bam has 64 bits of precision, while a double has only 53 bits of precision,
+	// how to handle the bits of a value that are finer than the 64 bits of a bam
+	enum class bam_rounding
+	{
+		truncate,			// towards negative infinity, the same direction as casting the scaled fraction in from_base()
+		nearest				// to nearest, ties to even
+	};
+
+	// the simd kernels in bam64_simd.hxx fall back to the private scalar implementation
+	namespace simd
+	{
+		struct kernels;
+	}
+
+	// binary angular measurement (bam), with as many bits of precision as the unsigned integer type UInt.
+	// bam64 has 64 bits of precision, while a double has only 53 bits of precision,
 	// which means that multiple adjacent bam values can map to a single double value.
+	// the narrower widths, bam8, bam16, and bam32, are smaller for storage and wire formats, and every one of their
+	// values is exactly representable as a double.
 	// this is a position, not a quantity. size comparison makes no sense.
 	// distance between values can make sense, but what units? bam is more of a measure rather than a quantity.
 	// but can we use the same representation for a swept angle -- but a periodic swept
@@ -155,21 +275,40 @@ namespace pcs
 	//  60 minutes is a complete period of an hour
 	// 360 degrees is a complete period of a circle
 	// 2pi radians is a complete period of a circle
-	struct bam64
+	template <std::unsigned_integral UInt>
+		requires (!std::same_as<UInt, bool>)
+	struct bam
 	{
 		private:
 
+			friend struct simd::kernels;
+
+			// all the bam widths can see each other, for converting between them
+			template <std::unsigned_integral Other>
+				requires (!std::same_as<Other, bool>)
+			friend struct bam;
+
+			// number of bits of precision
+			static constexpr int bits = std::numeric_limits<UInt>::digits;
+
+			// number of bits a double can hold
+			static constexpr int double_bits = std::numeric_limits<double>::digits;
+
 			// format converters used for going to or from bam format
-			static constexpr double unit_period_to_bam = 0x1p64;			// a multiplier constant to create a bam value from a fractional value in [0.0, 1.0)
-			static constexpr double bam_to_unit_period = 0x1p-64;			// a multiplier constant to create a [0.0, 1.0) value from a bam value
+			static constexpr double unit_period_to_bam = 2.0 * static_cast<double>(UInt{1} << (bits - 1));		// a multiplier constant to create a bam value from a fractional value in [0.0, 1.0)
+			static constexpr double bam_to_unit_period = 1.0 / unit_period_to_bam;								// a multiplier constant to create a [0.0, 1.0) value from a bam value
+
+			// half period bam value constant, 0x8000000000000000 for bam64
+			static constexpr UInt half =		UInt{1} << (bits - 1);
 
-			// half period bam value constant
-			static constexpr unsigned long long half =		0x8000000000000000;
+			// the bits below the top 53 bits, 11 for bam64, and none for the narrower widths
+			static constexpr int alt_shift =	(bits > double_bits) ? (bits - double_bits) : 0;
 
 			// for the alternate version, number of consecutive bam values that map to a single double value, going from 64 bits to 53 bits.
 			// this is used to skip over neighboring bam values that map to the same double value.
 			// for the non-alternate version, this value is the average spacing between bam values that map to neighboring consecutive double values.
-			static constexpr unsigned long long epsilon =	0x0000000000000800;
+			// 0x0000000000000800 for bam64, and 1 for the narrower widths.
+			static constexpr UInt epsilon =	UInt{1} << alt_shift;
 
 			// absolute value
 			[[nodiscard]] static constexpr double abs(double value) noexcept		{ return (value < 0) ? -value : value; }
@@ -181,10 +320,10 @@ namespace pcs
 			[[nodiscard]] static constexpr double fmod(double x, double y) noexcept
 			{
 				double turns = x / y;					// gives value in turns
-				if (bam64::abs(turns) > 2.0)
+				if (bam::abs(turns) > 2.0)
 				{
 					// this way sems to be more accurate for larger values
-					return turns - bam64::trunc(turns);
+					return turns - bam::trunc(turns);
 				}
 				else
 				{
@@ -201,62 +340,218 @@ namespace pcs
 			}
 
 			// workhorse function for creating a bam from a fractional part of a full period
-			[[nodiscard]] static constexpr bam64 fractional_base(double value, double base) noexcept
+			[[nodiscard]] static constexpr bam fractional_base(double value, double base) noexcept
 			{
-				double fraction = bam64::fmod(value, base);
+				double fraction = bam::fmod(value, base);
 				if (fraction < 0)	{ fraction += 1.0; }	// don't allow negative values if you are casting to an unsigned type
-				return bam64{ .value = static_cast<unsigned long long>(fraction * bam64::unit_period_to_bam) };
+				return bam{ .value = static_cast<UInt>(fraction * bam::unit_period_to_bam) };
 			}
 
 
 			// for alternate version, nearby bam values that map to neighboring consecutive double values
 
 			// skip over neighboring bam values that map to the same double value
-			[[nodiscard]] constexpr bam64 next_alt() noexcept			{ return { .value = this->value + bam64::epsilon }; }
+			[[nodiscard]] constexpr bam next_alt() noexcept			{ return { .value = static_cast<UInt>(this->value + bam::epsilon) }; }
 
 			// skip over neighboring bam values that map to the same double value
-			[[nodiscard]] constexpr bam64 previous_alt() noexcept		{ return { .value = this->value - bam64::epsilon }; }
+			[[nodiscard]] constexpr bam previous_alt() noexcept		{ return { .value = static_cast<UInt>(this->value - bam::epsilon) }; }
 
 			// alternate method for creating a bam from a fractional part of a full period - captures only the top 53 bits of precision
-			[[nodiscard]] static constexpr bam64 fractional_base_alt(double value, double base) noexcept
+			[[nodiscard]] static constexpr bam fractional_base_alt(double value, double base) noexcept
 			{
-				double fraction = bam64::fmod(value, base);
-				if (fraction < 0)	{ fraction += 1.0; }							// don't allow negative values if you are casting to an unsigned type
-				auto u = static_cast<unsigned long long>(fraction * (1ULL << 53));	// capture top 53 bits
-				u <<= 11;															// shift to top bits
-				return bam64{ .value = u };
+				if constexpr (bam::alt_shift == 0)
+				{
+					// every bit fits in a double already
+					return bam::fractional_base(value, base);
+				}
+				else
+				{
+					double fraction = bam::fmod(value, base);
+					if (fraction < 0)	{ fraction += 1.0; }							// don't allow negative values if you are casting to an unsigned type
+					auto u = static_cast<UInt>(fraction * (1ULL << 53));				// capture top 53 bits
+					u <<= bam::alt_shift;												// shift to top bits
+					return bam{ .value = u };
+				}
 			}
 
 			// alternate version that only captures the top 53 bits of precision
-			[[nodiscard]] constexpr double fraction_alt(double base = 1.0) const noexcept	{ return base * ((this->value >> 11) / static_cast<double>(1ULL << 53)); }
+			[[nodiscard]] constexpr double fraction_alt(double base = 1.0) const noexcept
+			{
+				if constexpr (bam::alt_shift == 0)
+					return this->fraction(base);
+				else
+					return base * ((this->value >> bam::alt_shift) / static_cast<double>(1ULL << 53));
+			}
+
+			// exact bam from value / 2^base_exponent, straight from the ieee bits. a double is mantissa * 2^exponent with an integral
+			// 53-bit mantissa, so the bam is the mantissa shifted by (exponent + bits - base_exponent), modulo 2^bits. whole periods
+			// shift out the top, and the bits shifted out the bottom decide the rounding. negative values are negated modulo 2^bits.
+			// there are no data-dependent branches, just selects. nan and infinity give zero.
+			[[nodiscard]] static constexpr bam exact_pow2_base(double value, int base_exponent, bam_rounding rounding) noexcept
+			{
+				const unsigned long long bits = std::bit_cast<unsigned long long>(value);
+				const bool negative = (bits >> 63) != 0;
+				const int biased_exponent = static_cast<int>((bits >> 52) & 0x7ff);
+				const bool is_finite = (biased_exponent != 0x7ff);
+				const bool is_normal = (biased_exponent != 0);
+
+				// subnormals have no implicit bit, and use the same exponent as the smallest normals
+				const unsigned long long mantissa = (bits & 0x000fffffffffffff) | (is_normal ? 0x0010000000000000 : 0);
+				const int shift = (is_normal ? biased_exponent : 1) - 1075 + bam::bits - base_exponent;
+
+				// a right shift of 54 or more leaves nothing of the 53-bit mantissa, so 63 is as far as we need to go.
+				// the math is done with 64 bits, and narrower widths keep the low bits, which is the same modulo 2^bits.
+				const int right = (shift < 0) ? ((-shift < 63) ? -shift : 63) : 0;
+				const unsigned long long magnitude = (shift >= 64) ? 0 : (shift >= 0) ? (mantissa << shift) : (mantissa >> right);
+				const unsigned long long lost = (shift >= 0) ? 0 : (mantissa & ((1ULL << right) - 1));
+				const unsigned long long halfway = (shift >= 0) ? 0 : (1ULL << (right - 1));
+
+				// truncation is towards negative infinity, so any lost bits from a negative value push its magnitude up
+				const bool round_up = (rounding == bam_rounding::nearest) ? ((lost > halfway) || ((lost == halfway) && (lost != 0) && ((magnitude & 1) != 0)))
+																			: (negative && (lost != 0));
+				const unsigned long long rounded = magnitude + (round_up ? 1 : 0);
+				const unsigned long long signed_value = negative ? (0 - rounded) : rounded;
+
+				return bam{ .value = static_cast<UInt>(is_finite ? signed_value : 0) };
+			}
+
+			// a bam from a float number of turns, without leaving float. dropping the whole turns is exact, and so is moving the
+			// fraction into [-0.5, 0.5), so the only rounding is the floor of fraction * 2^bits, which fits in an int, and is the
+			// bam value modulo 2^bits. nan and infinity give zero. the simd kernels do exactly the same steps.
+			[[nodiscard]] static constexpr bam float_turns(float turns) noexcept
+				requires (bits <= 32)
+			{
+				const float whole = (((turns < 0.0f) ? -turns : turns) < 0x1p23f) ? static_cast<float>(static_cast<int>(turns)) : turns;
+				float fraction = turns - whole;
+				if (fraction != fraction)	{ return { .value = 0 }; }
+
+				fraction -= (fraction >= 0.5f) ? 1.0f : 0.0f;
+				fraction += (fraction < -0.5f) ? 1.0f : 0.0f;
+
+				const float scaled = fraction * static_cast<float>(bam::unit_period_to_bam);
+				int floored = static_cast<int>(scaled);
+				floored -= (static_cast<float>(floored) > scaled) ? 1 : 0;
+				return { .value = static_cast<UInt>(static_cast<unsigned int>(floored)) };
+			}
 
 		public:
 
 			// the bam value
-			unsigned long long value;
+			UInt value;
 
 
 			// builders
 
 			// can use one of the enum values defined after the struct definition to create a bam64 from a known constant
-			[[nodiscard]] static constexpr bam64 from_bam_value(unsigned long long bam_value) noexcept		{ return { .value = bam_value }; }
+			[[nodiscard]] static constexpr bam from_bam_value(UInt bam_value) noexcept						{ return { .value = bam_value }; }
 
 			// whether you are trying make a bam from a turn, a minute, an hour, a degree, or radian value, all the whole amounts of
 			// whichever representation you are using, it will use the fraction of the value for making the bam value.
-			[[nodiscard]] static constexpr bam64 from_base(double value, double base) noexcept
+			[[nodiscard]] static constexpr bam from_base(double value, double base) noexcept
 			{
 				if (base == 0.0)	{ return { .value = 0 }; }
-				return bam64::fractional_base(value, base);
+				return bam::fractional_base(value, base);
+			}
+
+			// exact bam from a turn value -- all the bits of the double that are in the fundamental period are used.
+			// unlike from_base(), there is no division or scaling of the fraction, so there is no intermediate rounding.
+			[[nodiscard]] static constexpr bam from_turns_exact(double turns, bam_rounding rounding = bam_rounding::truncate) noexcept
+			{
+				return bam::exact_pow2_base(turns, 0, rounding);
+			}
+
+			// exact bam from a value whose base is a power of two, i.e., base == 2^base_exponent
+			[[nodiscard]] static constexpr bam from_pow2_base_exact(double value, int base_exponent, bam_rounding rounding = bam_rounding::truncate) noexcept
+			{
+				return bam::exact_pow2_base(value, base_exponent, rounding);
+			}
+
+			// from_base() for float values, for widths up to 32 bits, where a float has enough bits. everything is done in float,
+			// so simd versions get twice the lanes. the results are within a float ulp of value / base, in turns, of from_base().
+			[[nodiscard]] static constexpr bam from_base_float(float value, float base) noexcept
+				requires (bits <= 32)
+			{
+				if (base == 0.0f)	{ return { .value = 0 }; }
+				return bam::float_turns(value / base);
+			}
+
+			// batch version of from_base_float(), with the same reciprocal caveat as the double version below
+			static constexpr void from_base(std::span<const float> values, float base, std::span<bam> bams) noexcept
+				requires (bits <= 32)
+			{
+				const std::size_t count = (values.size() < bams.size()) ? values.size() : bams.size();
+				const float reciprocal = (base == 0.0f) ? 0.0f : (1.0f / base);
+
+				for (std::size_t i = 0; i < count; ++i)
+					bams[i] = (base == 0.0f) ? bam{ .value = 0 } : bam::float_turns(values[i] * reciprocal);
+			}
+
+			// batch version of from_base() that converts the first min(values.size(), bams.size()) values.
+			// the reciprocal of the base is computed once outside of the loop, and the loop body has no data-dependent
+			// control flow, so the compiler is free to auto-vectorize it. multiplying by the reciprocal may round differently
+			// than dividing by the base, so a result can differ from from_base() by a bam epsilon or so. when base is a
+			// power of two, e.g., turns, the results are identical.
+			static constexpr void from_base(std::span<const double> values, double base, std::span<bam> bams) noexcept
+			{
+				const std::size_t count = (values.size() < bams.size()) ? values.size() : bams.size();
+
+				if (base == 0.0)
+				{
+					for (std::size_t i = 0; i < count; ++i)		{ bams[i].value = 0; }
+					return;
+				}
+
+				const double reciprocal = 1.0 / base;
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					// subtracting the truncated value gives the same answer as bam::fmod() does, but without its loops
+					double turns = values[i] * reciprocal;
+					double fraction = turns - bam::trunc(turns);
+					fraction += (fraction < 0.0) ? 1.0 : 0.0;
+					bams[i].value = static_cast<UInt>(fraction * bam::unit_period_to_bam);
+				}
 			}
 
 
 			// modifier functions
 
 			// change underlying bam value
-			constexpr void operator()(unsigned long long arg) noexcept						{ this->value = arg; }
+			constexpr void operator()(UInt arg) noexcept									{ this->value = arg; }
 
 			// the position half a period away
-			[[nodiscard]] constexpr bam64 make_opposite() const noexcept					{ return { .value = this->value + bam64::half }; }
+			[[nodiscard]] constexpr bam make_opposite() const noexcept						{ return { .value = static_cast<UInt>(this->value + bam::half) }; }
+
+
+			// width conversions
+
+			// lossless conversion to a bam with at least as many bits. the extra low bits are zero.
+			template <std::unsigned_integral Wider>
+				requires (!std::same_as<Wider, bool>) && (std::numeric_limits<Wider>::digits >= std::numeric_limits<UInt>::digits)
+			[[nodiscard]] constexpr bam<Wider> widen() const noexcept
+			{
+				return { .value = static_cast<Wider>(static_cast<Wider>(this->value) << (bam<Wider>::bits - bam::bits)) };
+			}
+
+			// conversion to a bam with at most as many bits. the default rounds to nearest, ties to even, and rounding up
+			// from just below a full period wraps around to zero. truncation keeps the top bits.
+			template <std::unsigned_integral Narrower>
+				requires (!std::same_as<Narrower, bool>) && (std::numeric_limits<Narrower>::digits <= std::numeric_limits<UInt>::digits)
+			[[nodiscard]] constexpr bam<Narrower> narrow(bam_rounding rounding = bam_rounding::nearest) const noexcept
+			{
+				constexpr int shift = bam::bits - bam<Narrower>::bits;
+				if constexpr (shift == 0)
+				{
+					return { .value = static_cast<Narrower>(this->value) };
+				}
+				else
+				{
+					// adding just under half of the dropped bits, plus the lowest kept bit, rounds ties to even
+					const UInt round_bit = static_cast<UInt>((this->value >> shift) & 1);
+					const UInt addend = (rounding == bam_rounding::nearest) ? static_cast<UInt>((UInt{1} << (shift - 1)) - 1 + round_bit) : UInt{0};
+					return { .value = static_cast<Narrower>(static_cast<UInt>(this->value + addend) >> shift) };
+				}
+			}
 
 
 			// periodic properties
@@ -264,14 +559,19 @@ namespace pcs
 			// fraction - period value in range [0, 1) * base
 			[[nodiscard]] constexpr double fraction(double base = 1.0) const noexcept
 			{ 
-				unsigned long long bam_value = this->value;
+				UInt bam_value = this->value;
 
 				// shenanigans to avoid having an erroneous double value of 1.0 when converting
-				// a bam value to a double, for values that are very close to a full turn
-				if (bam_value > 0xfffffffffffff800)
-					bam_value = 0xfffffffffffff800;
+				// a bam value to a double, for values that are very close to a full turn.
+				// only widths with more bits than a double need it, and the limit is 0xfffffffffffff800 for bam64.
+				if constexpr (bam::alt_shift != 0)
+				{
+					constexpr UInt max_value = static_cast<UInt>(~UInt{0} << bam::alt_shift);
+					if (bam_value > max_value)
+						bam_value = max_value;
+				}
 
-				return base * bam_value * bam64::bam_to_unit_period;
+				return base * static_cast<double>(bam_value) * bam::bam_to_unit_period;
 			}
 
 			// complement - complementary period value in range [0, 1) * base
@@ -281,67 +581,132 @@ namespace pcs
 			[[nodiscard]] constexpr double opposite(double base = 1.0) const noexcept		{ return (this->make_opposite()).fraction(base); }
 
 			// normal - normalized period value in range (-0.5, 0.5] * base
-			[[nodiscard]] constexpr double normal(double base = 1.0) const noexcept			{ return ((this->value > bam64::half) ? -(this->complement(base)) : this->fraction(base)); }
+			[[nodiscard]] constexpr double normal(double base = 1.0) const noexcept			{ return ((this->value > bam::half) ? -(this->complement(base)) : this->fraction(base)); }
 
 
 			// unary operators
 
+			// the integer promotions turn narrow values into int, so results are cast back to UInt to wrap them
+
 			// unary plus is identity operation
-			[[nodiscard]] constexpr bam64 operator +() const noexcept						{ return { .value = this->value }; }
+			[[nodiscard]] constexpr bam operator +() const noexcept							{ return { .value = this->value }; }
 
 			// two's complement negation
 			// for a BAM, negation is its complement
-			[[nodiscard]] constexpr bam64 operator ~() const noexcept						{ return { .value = ~(this->value) + 1ULL }; }
+			[[nodiscard]] constexpr bam operator ~() const noexcept							{ return { .value = static_cast<UInt>(~(this->value) + 1ULL) }; }
 
 			// negation is same as complement for a bam
-			[[nodiscard]] constexpr bam64 operator -() const noexcept						{ return { .value = ~(this->value) + 1ULL }; }
+			[[nodiscard]] constexpr bam operator -() const noexcept							{ return { .value = static_cast<UInt>(~(this->value) + 1ULL) }; }
 
-			// indirection operator returns a reference to the value underlying bam64
-			[[nodiscard]] unsigned long long & operator*() noexcept							{ return this->value; }
+			// indirection operator returns a reference to the value underlying bam
+			[[nodiscard]] UInt & operator*() noexcept										{ return this->value; }
 
 
 			// binary operators
 
 			// relies on unsigned overflow
-			[[nodiscard]] constexpr bam64 operator +(bam64 rhs) const noexcept				{ return { .value = this->value + rhs.value }; }
+			[[nodiscard]] constexpr bam operator +(bam rhs) const noexcept					{ return { .value = static_cast<UInt>(this->value + rhs.value) }; }
 
 			// relies on unsigned underflow
-			[[nodiscard]] constexpr bam64 operator -(bam64 rhs) noexcept					{ return { .value = this->value - rhs.value }; }
+			[[nodiscard]] constexpr bam operator -(bam rhs) const noexcept					{ return { .value = static_cast<UInt>(this->value - rhs.value) }; }
 
-			[[nodiscard]] constexpr bam64 operator *(double multiplier) const noexcept		{ return bam64::from_base(this->fraction() * multiplier, 1.0); }
+			[[nodiscard]] constexpr bam operator *(double multiplier) const noexcept		{ return bam::from_base(this->fraction() * multiplier, 1.0); }
 
-			[[nodiscard]] friend constexpr bam64 operator *(double multiplier, bam64 bam) noexcept			{ return bam * multiplier; }
+			[[nodiscard]] friend constexpr bam operator *(double multiplier, bam angle) noexcept			{ return angle * multiplier; }
 
-			[[nodiscard]] constexpr bam64 operator /(double divisor) const noexcept
+			[[nodiscard]] constexpr bam operator /(double divisor) const noexcept
 			{
 				if (divisor == 0.0)	{ return { .value = 0 }; }
-				return bam64::from_base(this->fraction() / divisor, 1.0);
+				return bam::from_base(this->fraction() / divisor, 1.0);
+			}
+
+			// integer multiples wrap around, and are exact
+			template <std::integral Int>
+				requires (!std::same_as<Int, bool>)
+			[[nodiscard]] constexpr bam operator *(Int multiplier) const noexcept
+			{
+				return { .value = static_cast<UInt>(static_cast<unsigned long long>(this->value) * static_cast<unsigned long long>(multiplier)) };
+			}
+
+			template <std::integral Int>
+				requires (!std::same_as<Int, bool>)
+			[[nodiscard]] friend constexpr bam operator *(Int multiplier, bam angle) noexcept				{ return angle * multiplier; }
+
+			// integer division rounds to nearest, ties to even. dividing by zero gives zero, like the double version.
+			template <std::integral Int>
+				requires (!std::same_as<Int, bool>)
+			[[nodiscard]] constexpr bam operator /(Int divisor) const noexcept
+			{
+				if constexpr (std::is_signed_v<Int>)
+				{
+					const unsigned long long magnitude = (divisor < 0) ? (0ULL - static_cast<unsigned long long>(divisor)) : static_cast<unsigned long long>(divisor);
+					const bam quotient = this->scale(1, magnitude);
+					return (divisor < 0) ? -quotient : quotient;
+				}
+				else
+				{
+					return this->scale(1, divisor);
+				}
+			}
+
+
+			// exact scaling
+
+			// value * numerator / denominator. the product is kept in 128 bits, so the only rounding is in the final division,
+			// and whole periods wrap away. unlike operator *(double) and operator /(double), which go through fraction() and
+			// from_base(), the low bits aren't lost, so scaling in a loop doesn't drift. a zero denominator gives zero.
+			[[nodiscard]] constexpr bam scale(unsigned long long numerator, unsigned long long denominator, bam_rounding rounding = bam_rounding::nearest) const noexcept
+			{
+				if (denominator == 0)	{ return { .value = 0 }; }
+
+				unsigned long long high = 0;
+				const unsigned long long low = detail::umul128(this->value, numerator, high);
+
+				// only the quotient modulo 2^64 matters. whole multiples of the denominator in the high word only add
+				// whole multiples of 2^64 to the quotient, so they can be dropped, and then the quotient fits in 64 bits.
+				unsigned long long remainder = 0;
+				const unsigned long long quotient = detail::udiv128(high % denominator, low, denominator, remainder);
+
+				const unsigned long long rest = denominator - remainder;
+				const bool round_up = (rounding == bam_rounding::nearest) && ((remainder > rest) || ((remainder == rest) && ((quotient & 1) != 0)));
+				return { .value = static_cast<UInt>(quotient + (round_up ? 1 : 0)) };
 			}
 
 
 			// comparison functions
 
-			[[nodiscard]] constexpr std::strong_ordering operator <=>(const bam64 &other) const noexcept	{ return this->value <=> other.value; }
+			[[nodiscard]] constexpr std::strong_ordering operator <=>(const bam &other) const noexcept		{ return this->value <=> other.value; }
 
-			[[nodiscard]] constexpr bool operator ==(const bam64 &other) const noexcept						{ return this->value == other.value; }
+			[[nodiscard]] constexpr bool operator ==(const bam &other) const noexcept						{ return this->value == other.value; }
 
 			// is the value within the tolerance range of zero?
-			[[nodiscard]] constexpr bool within_tolerance(bam64 tolerance) const noexcept
+			[[nodiscard]] constexpr bool within_tolerance(bam tolerance) const noexcept
 			{
-				bam64 comp_val = ~(*this);									// we approach zero from both the low and high sides, so we need the complement value too
-				bam64 min_val = ((*this) > comp_val) ? comp_val : *this;	// choose whichever is smaller in magnitude
+				bam comp_val = ~(*this);									// we approach zero from both the low and high sides, so we need the complement value too
+				bam min_val = ((*this) > comp_val) ? comp_val : *this;		// choose whichever is smaller in magnitude
 				return min_val <= tolerance;								// if the smaller magnitude value is within the tolerance, then we are within tolerance
 			}
 
-	};	// struct bam64
+	};	// struct bam
+
+	// the widths of bam
+	using bam8 =	bam<unsigned char>;
+	using bam16 =	bam<unsigned short>;
+	using bam32 =	bam<unsigned int>;
+	using bam64 =	bam<unsigned long long>;
+
+	// a bam is just its value, so arrays of narrow bams pack tightly, and simd loops get more lanes per register
+	static_assert((sizeof(bam8) == 1) && (sizeof(bam16) == 2) && (sizeof(bam32) == 4) && (sizeof(bam64) == 8));
+	static_assert(std::is_trivially_copyable_v<bam16> && std::is_standard_layout_v<bam16>);
 
 
 	// distance comparison
 
 	// are two bam values within the specified tolerance of each other?
-	[[nodiscard]] inline constexpr bool within_distance(bam64 a, bam64 b, bam64 tolerance) noexcept
+	template <typename UInt>
+	[[nodiscard]] inline constexpr bool within_distance(bam<UInt> a, bam<UInt> b, bam<UInt> tolerance) noexcept
 	{
-		bam64 diff = (a - b);
+		bam<UInt> diff = (a - b);
 		return diff.within_tolerance(tolerance);
 	}
 
@@ -356,6 +721,65 @@ namespace pcs
 	[[nodiscard]] inline constexpr bam64 bam64_from_radians(double radians) noexcept			{ return bam64::from_base(radians,	detail::radian_base); }
 	[[nodiscard]] inline constexpr bam64 bam64_from_base(double value, double base) noexcept	{ return bam64::from_base(value,	base); }
 
+	// batch versions of the above, converting the first min(input.size(), bams.size()) values.
+	// see bam64::from_base(std::span<const double>, double, std::span<bam64>) for details.
+	inline constexpr void bam64_from_turns(std::span<const double> turns, std::span<bam64> bams) noexcept					{ bam64::from_base(turns,		detail::turn_base,		bams); }
+	inline constexpr void bam64_from_minutes(std::span<const double> minutes, std::span<bam64> bams) noexcept				{ bam64::from_base(minutes,	detail::minute_base,	bams); }
+	inline constexpr void bam64_from_seconds(std::span<const double> seconds, std::span<bam64> bams) noexcept				{ bam64::from_base(seconds,	detail::second_base,	bams); }
+	inline constexpr void bam64_from_degrees(std::span<const double> degrees, std::span<bam64> bams) noexcept				{ bam64::from_base(degrees,	detail::degree_base,	bams); }
+	inline constexpr void bam64_from_radians(std::span<const double> radians, std::span<bam64> bams) noexcept				{ bam64::from_base(radians,	detail::radian_base,	bams); }
+	inline constexpr void bam64_from_base(std::span<const double> values, double base, std::span<bam64> bams) noexcept	{ bam64::from_base(values,		base,					bams); }
+
+	// exact versions for power of two bases, with no intermediate rounding
+	[[nodiscard]] inline constexpr bam64 bam64_from_turns_exact(double turns, bam_rounding rounding = bam_rounding::truncate) noexcept	{ return bam64::from_turns_exact(turns, rounding); }
+
+	// bam64_from_radians() divides by two_pi, which is only the nearest double to 2pi, and then any whole turns are subtracted
+	// from the quotient. the quotient only has 53 bits, so for large radian values there are few or no fractional bits left.
+	//
+	// this version is a payne-hanek reduction. radians is an integral 53-bit mantissa m times 2^e, and the bam value is
+	// m * 2^e * (1/(2pi)) * 2^64, modulo 2^64. the bits of 1/(2pi) heavier than 2^-e only add whole turns, so they are skipped,
+	// and a 256-bit window of the bits after that is multiplied by m exactly. the top 64 bits of the fractional part of the product
+	// are the bam value, and the rest decide the rounding. the bits of 1/(2pi) beyond the window are worth less than 2^-139 of a bam
+	// unit, so every bam bit is correct for all finite doubles. nan and infinity give zero.
+	[[nodiscard]] inline constexpr bam64 bam64_from_radians_precise(double radians, bam_rounding rounding = bam_rounding::truncate) noexcept
+	{
+		const unsigned long long bits = std::bit_cast<unsigned long long>(radians);
+		const bool negative = (bits >> 63) != 0;
+		const int biased_exponent = static_cast<int>((bits >> 52) & 0x7ff);
+
+		if (biased_exponent == 0x7ff)	{ return bam64{ .value = 0 }; }
+
+		const bool is_normal = (biased_exponent != 0);
+		const unsigned long long mantissa = (bits & 0x000fffffffffffff) | (is_normal ? 0x0010000000000000 : 0);
+		const int exponent = (is_normal ? biased_exponent : 1) - 1075;
+
+		unsigned long long window[4] = {};
+		detail::inverse_two_pi_window(exponent, window);
+
+		// the product m * window, from the least significant word up. only the low 256 bits of the product are needed.
+		unsigned long long high[4] = {};
+		unsigned long long low[4] = {};
+		for (int i = 0; i < 4; ++i)
+		{
+			low[i] = detail::umul128(mantissa, window[3 - i], high[i]);
+		}
+
+		const unsigned long long word1 = high[0] + low[1];
+		const unsigned long long carry1 = (word1 < low[1]) ? 1 : 0;
+		const unsigned long long partial2 = high[1] + low[2];
+		const unsigned long long word2 = partial2 + carry1;
+		const unsigned long long carry2 = ((partial2 < low[2]) ? 1 : 0) + ((word2 < carry1) ? 1 : 0);
+		const unsigned long long magnitude = high[2] + low[3] + carry2;
+
+		// word2, word1, and low[0] are the fraction of a bam unit, which can only be a little short of the true fraction.
+		// 1/(2pi) is irrational, so there are never any ties, and a non-zero value always has a non-zero fraction, even
+		// when it is too small to show up in the window.
+		const bool round_up = (rounding == bam_rounding::nearest) ? (word2 >= 0x8000000000000000) : (negative && (mantissa != 0));
+
+		const unsigned long long rounded = magnitude + (round_up ? 1 : 0);
+		return bam64{ .value = negative ? (0 - rounded) : rounded };
+	}
+
 
 	// convert bam64 to various periodic units
 
@@ -0,0 +1,270 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_BAM64_CORDIC_HXX)
+#define PCS_BAM64_CORDIC_HXX
+
+#include "bam64.hxx"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// integer cordic for bam64 angles. nothing here uses floating point, so results are the same on every target and
+	// at compile time.
+	//
+	// each iteration rotates by +/- atan(2^-i) using only shifts and adds, and the bam64 angles for those rotations come
+	// from a table that is built at compile time. a rotation by a whole number of quarter turns is done exactly first,
+	// so the iterations only ever see angles in [-45, 45) degrees.
+	//
+
+	// a point or vector with integer coordinates
+	struct cordic_vector
+	{
+		long long x;
+		long long y;
+	};
+
+	// sine and cosine as fixed point values, where cordic_one is 1.0
+	struct fixed_sin_cos
+	{
+		long long sin;
+		long long cos;
+	};
+
+	// 1.0 for sincos_fixed(), a fixed point format with 62 fraction bits
+	inline constexpr long long cordic_one = 1LL << 62;
+
+	namespace detail
+	{
+		// 128-bit binary fractions as four 32-bit limbs, most significant first. limb i has a weight of 2^-(32 * (i + 1)).
+		// only used for building the table, so it favors being simple and portable over being fast.
+		using cordic_fraction = std::array<unsigned long long, 4>;
+
+		// 2^-shift / divisor, truncated. shift is in [1, 128), and divisor is less than 2^32.
+		inline constexpr cordic_fraction cordic_power_ratio(int shift, unsigned long long divisor) noexcept
+		{
+			cordic_fraction ratio{};
+			const int limb = (shift - 1) / 32;
+			ratio[static_cast<std::size_t>(limb)] = 1ULL << (32 * (limb + 1) - shift);
+
+			unsigned long long remainder = 0;
+			for (auto &part : ratio)
+			{
+				const unsigned long long dividend = (remainder << 32) | part;
+				part = dividend / divisor;
+				remainder = dividend % divisor;
+			}
+
+			return ratio;
+		}
+
+		// atan(2^-i) as a bam64, rounded to nearest. the series atan(x) = x - x^3/3 + x^5/5 - ... is summed with 128 bits,
+		// then multiplied by 128 bits of 1/(2pi).
+		inline constexpr bam64 cordic_angle(int i) noexcept
+		{
+			// atan(1) is exactly an eighth of a turn, and the series converges too slowly there anyway
+			if (i == 0)
+				return bam64::from_bam_value(pcs::eighth);
+
+			cordic_fraction sum{};
+			for (unsigned long long k = 0; i * static_cast<int>(2 * k + 1) < 128; ++k)
+			{
+				const cordic_fraction term = cordic_power_ratio(i * static_cast<int>(2 * k + 1), 2 * k + 1);
+
+				// add the even terms and subtract the odd ones, carrying or borrowing between limbs
+				unsigned long long carry = 0;
+				for (std::size_t j = 4; j-- > 0;)
+				{
+					const unsigned long long limb = ((k % 2) == 0) ? (sum[j] + term[j] + carry) : (sum[j] - term[j] - carry);
+					sum[j] = limb & 0xffffffff;
+					carry = (limb >> 32) & 1;
+				}
+			}
+
+			const unsigned long long first_word = inverse_two_pi_bits[inverse_two_pi_zero_words];
+			const unsigned long long second_word = inverse_two_pi_bits[inverse_two_pi_zero_words + 1];
+			const cordic_fraction inverse_two_pi = { first_word >> 32, first_word & 0xffffffff, second_word >> 32, second_word & 0xffffffff };
+
+			// schoolbook multiply into eight limbs. the top two limbs are the bam, and the next limb rounds it.
+			unsigned long long product[8]{};
+			for (std::size_t j = 4; j-- > 0;)
+			{
+				unsigned long long carry = 0;
+				for (std::size_t k = 4; k-- > 0;)
+				{
+					const unsigned long long partial = sum[j] * inverse_two_pi[k] + product[j + k + 1] + carry;
+					product[j + k + 1] = partial & 0xffffffff;
+					carry = partial >> 32;
+				}
+				product[j] = carry;
+			}
+
+			return bam64::from_bam_value(((product[0] << 32) | product[1]) + (product[2] >> 31));
+		}
+
+		// number of iterations. the coordinates are scaled to about 2^61, so shifting by any more than this is just noise.
+		inline constexpr int cordic_iterations = 62;
+
+		// atan(2^-i) for each iteration i
+		inline constexpr auto cordic_angles = []() noexcept
+		{
+			std::array<bam64, cordic_iterations> angles{};
+			for (int i = 0; i < cordic_iterations; ++i)
+			{
+				angles[static_cast<std::size_t>(i)] = cordic_angle(i);
+			}
+			return angles;
+		}();
+
+		// 1 / product of sqrt(1 + 2^-2i) for all the iterations, in the cordic_one format. every iteration lengthens
+		// the vector a little, and scaling by this first cancels all of it.
+		inline constexpr unsigned long long cordic_gain = 0x26dd3b6a10d7969a;		// 0.60725293500888126
+
+		// magnitude of a signed value, which is correct even for the most negative value
+		inline constexpr unsigned long long cordic_magnitude(long long value) noexcept
+		{
+			return (value < 0) ? (0ULL - static_cast<unsigned long long>(value)) : static_cast<unsigned long long>(value);
+		}
+
+		// value * cordic_gain, rounded to nearest. |value| must be less than 2^63.
+		inline constexpr long long cordic_scale(long long value) noexcept
+		{
+			unsigned long long high = 0;
+			const unsigned long long low = umul128(cordic_magnitude(value), cordic_gain, high);
+			const auto scaled = static_cast<long long>(((high << 2) | (low >> 62)) + ((low >> 61) & 1));
+			return (value < 0) ? -scaled : scaled;
+		}
+
+		// rotate (x, y) by a whole number of quarter turns, exactly, and return the rest of the angle as a signed
+		// bam64 value in [-45, 45) degrees
+		inline constexpr long long cordic_quarter_turns(long long &x, long long &y, bam64 angle) noexcept
+		{
+			const unsigned long long quarter_turns = (angle.value + pcs::eighth) & 0xc000000000000000;
+
+			const long long old_x = x;
+			switch (quarter_turns >> 62)
+			{
+				case 1:		x = -y;		y = old_x;		break;
+				case 2:		x = -x;		y = -y;			break;
+				case 3:		x = y;		y = -old_x;		break;
+				default:	break;
+			}
+
+			return static_cast<long long>(angle.value - quarter_turns);
+		}
+
+		// rotation mode, driving the angle to zero. (x, y) should already be scaled by cordic_gain.
+		inline constexpr void cordic_rotate(long long &x, long long &y, long long angle) noexcept
+		{
+			for (int i = 0; i < cordic_iterations; ++i)
+			{
+				const long long dx = y >> i;
+				const long long dy = x >> i;
+				const auto step = static_cast<long long>(cordic_angles[static_cast<std::size_t>(i)].value);
+
+				// the direction is random from one iteration to the next, so it is applied with a sign mask instead of
+				// a branch. (v ^ mask) - mask is v when mask is 0, and -v when mask is -1.
+				const long long mask = angle >> 63;
+				x -= (dx ^ mask) - mask;
+				y += (dy ^ mask) - mask;
+				angle -= (step ^ mask) - mask;
+			}
+		}
+
+	}	// namespace detail
+
+	// angle of the vector (x, y) from the positive x axis, like std::atan2(y, x) but as a bam64.
+	// any values work, and (0, 0) gives 0. the result is within 64 bam64 units of the exact angle.
+	[[nodiscard]] inline constexpr bam64 atan2_bam(long long y, long long x) noexcept
+	{
+		unsigned long long x_magnitude = detail::cordic_magnitude(x);
+		unsigned long long y_magnitude = detail::cordic_magnitude(y);
+		const unsigned long long bits = x_magnitude | y_magnitude;
+		if (bits == 0)
+			return bam64::from_bam_value(0);
+
+		// scale so the larger magnitude is in [2^60, 2^61). vectoring lengthens the vector by about 1.65, so that still fits.
+		const int shift = std::countl_zero(bits) - 3;
+		if (shift >= 0)		{ x_magnitude <<= shift;	y_magnitude <<= shift; }
+		else				{ x_magnitude >>= -shift;	y_magnitude >>= -shift; }
+
+		// start in the right half plane, so the iterations converge. a point on the left is rotated by half a turn.
+		long long vx = static_cast<long long>(x_magnitude);
+		long long vy = ((y < 0) != (x < 0)) ? -static_cast<long long>(y_magnitude) : static_cast<long long>(y_magnitude);
+		unsigned long long angle = 0;
+		if (x < 0)
+			angle = pcs::half;
+
+		// vectoring mode, driving y to zero. stopping at zero keeps angles like 0 and 45 degrees exact.
+		for (int i = 0; (i < detail::cordic_iterations) && (vy != 0); ++i)
+		{
+			const long long dx = vy >> i;
+			const long long dy = vx >> i;
+			const unsigned long long step = detail::cordic_angles[static_cast<std::size_t>(i)].value;
+
+			// same sign mask as detail::cordic_rotate(), but all ones when y is negative
+			const long long mask = vy >> 63;
+			vx += (dx ^ mask) - mask;
+			vy -= (dy ^ mask) - mask;
+			angle += (step ^ static_cast<unsigned long long>(mask)) - static_cast<unsigned long long>(mask);
+		}
+
+		return bam64::from_bam_value(angle);
+	}
+
+	// rotate the point (x, y) counterclockwise by angle about the origin, rounding to the nearest integers.
+	// |x| and |y| must be less than 2^62, so the result can't overflow. the error is at most about 1e-17 of the
+	// length of (x, y), plus the final rounding.
+	[[nodiscard]] inline constexpr cordic_vector rotate(long long x, long long y, bam64 angle) noexcept
+	{
+		const long long remaining = detail::cordic_quarter_turns(x, y, angle);
+
+		const unsigned long long bits = detail::cordic_magnitude(x) | detail::cordic_magnitude(y);
+		if (bits == 0)
+			return cordic_vector{ .x = 0, .y = 0 };
+
+		// use all the bits available, with the larger magnitude in [2^61, 2^62)
+		const int shift = std::countl_zero(bits) - 2;
+		x = detail::cordic_scale(x * (1LL << shift));
+		y = detail::cordic_scale(y * (1LL << shift));
+
+		detail::cordic_rotate(x, y, remaining);
+
+		if (shift > 0)
+		{
+			const long long rounding = 1LL << (shift - 1);
+			x = (x + rounding) >> shift;
+			y = (y + rounding) >> shift;
+		}
+
+		return cordic_vector{ .x = x, .y = y };
+	}
+
+	// sine and cosine of angle, where cordic_one is 1.0. each is within 64 units of exact, or about 1.4e-17.
+	[[nodiscard]] inline constexpr fixed_sin_cos sincos_fixed(bam64 angle) noexcept
+	{
+		long long x = static_cast<long long>(detail::cordic_gain);
+		long long y = 0;
+		const long long remaining = detail::cordic_quarter_turns(x, y, angle);
+
+		detail::cordic_rotate(x, y, remaining);
+
+		return fixed_sin_cos{ .sin = y, .cos = x };
+	}
+
+}	// namespace pcs
+
+// closing include guard
+#endif
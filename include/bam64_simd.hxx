@@ -0,0 +1,1208 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_BAM64_SIMD_HXX)
+#define PCS_BAM64_SIMD_HXX
+
+#include "bam64.hxx"
+#include "bam64_trig.hxx"
+
+#include <span>
+#include <cstddef>
+#include <iterator>
+
+// x86-64 is the only architecture with explicit kernels. everything else uses the scalar code.
+#if defined(__x86_64__) || defined(_M_X64)
+	#define PCS_SIMD_X86
+	#include <immintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		#define PCS_SIMD_TARGET(isa)
+	#else
+		#include <cpuid.h>
+		#define PCS_SIMD_TARGET(isa) __attribute__((target(isa)))
+	#endif
+#endif
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// explicit simd kernels for converting between doubles and bam64, with runtime dispatch.
+	//
+	// every kernel gives bit-identical results to the scalar bam64 code it replaces, i.e., bam64::from_base()
+	// and bam64::fraction(), plus the private _alt 53-bit variants. the scalar code has undefined behavior when
+	// value / base is not finite or when its magnitude is 2^63 or greater, so those inputs are not covered.
+	//
+	// the atan2 kernels evaluate the polynomial of bam64_atan2() in the same order, so they are also bit-identical,
+	// unless the compiler fuses the scalar multiplies and adds into fma instructions (e.g. -ffp-contract=fast when fma
+	// is enabled). then they can differ by a few ulps of the polynomial, which is well within the documented error.
+	//
+	// the sincos kernels are the same as sincos(), with the table lookups done by gathers, and the same caveat about fma.
+	//
+	// the ramp kernels only add integers, so they are always exact.
+	//
+	// the bam32 kernels for float values stay in 32-bit lanes, and are bit-identical to bam32::from_base() for floats.
+	//
+
+	namespace simd
+	{
+		// ordered from least to most capable
+		enum class instruction_set : int
+		{
+			scalar,
+			sse42,				// sse4.1 rounding, sse4.2 64-bit compares
+			avx2,				// 4 lanes, variable 64-bit shifts
+			avx512				// 8 lanes, avx512f + avx512dq for native unsigned 64-bit <-> double
+		};
+
+		// ask the cpu (and os) what it supports
+		inline instruction_set detect_instruction_set() noexcept
+		{
+#if defined(PCS_SIMD_X86)
+			unsigned int regs[4] = {};
+			auto cpuid = [&regs](unsigned int leaf, unsigned int subleaf)
+			{
+#if defined(_MSC_VER) && !defined(__clang__)
+				int info[4] = {};
+				__cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+				for (int i = 0; i < 4; ++i)		{ regs[i] = static_cast<unsigned int>(info[i]); }
+#else
+				__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+			};
+
+			auto xgetbv = []() -> unsigned long long
+			{
+#if defined(_MSC_VER) && !defined(__clang__)
+				return _xgetbv(0);
+#else
+				unsigned int lo = 0;
+				unsigned int hi = 0;
+				__asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+				return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+			};
+
+			cpuid(0, 0);
+			const unsigned int max_leaf = regs[0];
+
+			cpuid(1, 0);
+			const bool has_sse42 = (regs[2] & (1u << 20)) != 0;
+			const bool has_osxsave = (regs[2] & (1u << 27)) != 0;
+			const bool has_avx = (regs[2] & (1u << 28)) != 0;
+
+			if (!has_sse42)		{ return instruction_set::scalar; }
+			if (!has_osxsave || !has_avx || (max_leaf < 7))		{ return instruction_set::sse42; }
+
+			// the os needs to save the wider registers on context switches
+			const unsigned long long xcr0 = xgetbv();
+			const bool os_ymm = (xcr0 & 0x06) == 0x06;		// xmm and ymm state
+			const bool os_zmm = (xcr0 & 0xe6) == 0xe6;		// plus opmask and zmm state
+
+			cpuid(7, 0);
+			const bool has_avx2 = (regs[1] & (1u << 5)) != 0;
+			const bool has_avx512f = (regs[1] & (1u << 16)) != 0;
+			const bool has_avx512dq = (regs[1] & (1u << 17)) != 0;
+
+			if (os_zmm && has_avx2 && has_avx512f && has_avx512dq)	{ return instruction_set::avx512; }
+			if (os_ymm && has_avx2)									{ return instruction_set::avx2; }
+
+			return instruction_set::sse42;
+#else
+			return instruction_set::scalar;
+#endif
+		}
+
+		// detection only happens once
+		inline instruction_set supported_instruction_set() noexcept
+		{
+			static const instruction_set supported = detect_instruction_set();
+			return supported;
+		}
+
+		// every instruction set that can run here, from scalar up to supported_instruction_set(), e.g., to test or benchmark
+		// each kernel
+		inline std::span<const instruction_set> runnable_instruction_sets() noexcept
+		{
+			static constexpr instruction_set all[] = { instruction_set::scalar, instruction_set::sse42, instruction_set::avx2, instruction_set::avx512 };
+			return std::span<const instruction_set>(all, static_cast<std::size_t>(supported_instruction_set()) + 1);
+		}
+
+		// the kernels work on raw pointers and a count. they are reached through the span functions at the end of this file.
+		struct kernels
+		{
+			//
+			// scalar - the current bam64 code
+			//
+
+			static void from_base_scalar(const double *values, double base, bam64 *bams, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ bams[i] = bam64::fractional_base(values[i], base); }
+			}
+
+			static void from_base_alt_scalar(const double *values, double base, bam64 *bams, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ bams[i] = bam64::fractional_base_alt(values[i], base); }
+			}
+
+			static void to_base_scalar(const bam64 *bams, double base, double *values, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ values[i] = bams[i].fraction(base); }
+			}
+
+			static void to_base_alt_scalar(const bam64 *bams, double base, double *values, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ values[i] = bams[i].fraction_alt(base); }
+			}
+
+			static void atan2_scalar(const double *ys, const double *xs, bam64 *bams, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ bams[i] = bam64_atan2(ys[i], xs[i]); }
+			}
+
+			template <trig_accuracy Accuracy>
+			static void sincos_scalar(const bam64 *bams, double *sines, double *cosines, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const auto [sin_value, cos_value] = detail::table_sincos(bams[i], Accuracy);
+					sines[i] = sin_value;
+					cosines[i] = cos_value;
+				}
+			}
+
+			// bam32 from float values times the reciprocal of the base, all in float
+			static void from_base_float_scalar(const float *values, float reciprocal, bam32 *bams, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ bams[i] = bam32::float_turns(values[i] * reciprocal); }
+			}
+
+			// start, start + step, start + 2 * step, ..., which wraps just like adding step each time
+			static void ramp_scalar(bam64 start, bam64 step, bam64 *bams, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ bams[i] = start + step * i; }
+			}
+
+			// bits of a bam below a table entry in detail::table_sincos()
+			static constexpr int sincos_entry_shift = 64 - 2 - detail::quarter_wave_bits;
+
+#if defined(PCS_SIMD_X86)
+
+			// bam64::fmod() only has its while loops for |turns| <= 2, where subtracting 1 or 2 is exact, so it always gives the same
+			// answer as turns - trunc(turns). the cast to long long in bam64::trunc() is the same as rounding towards zero.
+
+			//
+			// sse4.2 - 2 lanes
+			//
+
+			// fractional part of value / base, in [0, 1]
+			PCS_SIMD_TARGET("sse4.2") static __m128d fraction_sse42(__m128d values, __m128d base) noexcept
+			{
+				const __m128d turns = _mm_div_pd(values, base);
+				const __m128d fraction = _mm_sub_pd(turns, _mm_round_pd(turns, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+				const __m128d negative = _mm_cmplt_pd(fraction, _mm_setzero_pd());
+				return _mm_add_pd(fraction, _mm_and_pd(negative, _mm_set1_pd(1.0)));
+			}
+
+			// exact conversion from unsigned 64-bit to double, with a single round to nearest.
+			// the high and low 32-bit halves are embedded in the mantissas of 2^84 and 2^52, the offsets are subtracted exactly,
+			// and the final add is the only operation that rounds.
+			PCS_SIMD_TARGET("sse4.2") static __m128d u64_to_double_sse42(__m128i bits) noexcept
+			{
+				const __m128i high = _mm_or_si128(_mm_srli_epi64(bits, 32), _mm_castpd_si128(_mm_set1_pd(0x1p84)));
+				const __m128i low = _mm_blend_epi16(bits, _mm_castpd_si128(_mm_set1_pd(0x1p52)), 0xcc);
+				const __m128d high_value = _mm_sub_pd(_mm_castsi128_pd(high), _mm_set1_pd(0x1p84 + 0x1p52));
+				return _mm_add_pd(high_value, _mm_castsi128_pd(low));
+			}
+
+			// unsigned min() with a constant, using signed compares on sign-flipped values
+			PCS_SIMD_TARGET("sse4.2") static __m128i clamp_u64_sse42(__m128i bits, unsigned long long limit) noexcept
+			{
+				const __m128i sign = _mm_set1_epi64x(static_cast<long long>(0x8000000000000000));
+				const __m128i max_bits = _mm_set1_epi64x(static_cast<long long>(limit));
+				const __m128i too_big = _mm_cmpgt_epi64(_mm_xor_si128(bits, sign), _mm_xor_si128(max_bits, sign));
+				return _mm_blendv_epi8(bits, max_bits, too_big);
+			}
+
+			PCS_SIMD_TARGET("sse4.2") static void from_base_sse42(const double *values, double base, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m128d base_vec = _mm_set1_pd(base);
+				const __m128d scale = _mm_set1_pd(bam64::unit_period_to_bam);
+				alignas(16) double scaled[2];
+
+				// no per-lane variable shifts, so the final double -> unsigned conversion is done a lane at a time
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					_mm_store_pd(scaled, _mm_mul_pd(fraction_sse42(_mm_loadu_pd(values + i), base_vec), scale));
+					bams[i].value = static_cast<unsigned long long>(scaled[0]);
+					bams[i + 1].value = static_cast<unsigned long long>(scaled[1]);
+				}
+
+				from_base_scalar(values + i, base, bams + i, count - i);
+			}
+
+			// bam32::float_turns() for 4 floats. the centered fraction times 2^32 fits in an int32 after the floor, and its bits are
+			// the bam. nan lanes, which include infinities, are zeroed.
+			PCS_SIMD_TARGET("sse4.2") static __m128i float_turns_sse42(__m128 turns) noexcept
+			{
+				const __m128 one = _mm_set1_ps(1.0f);
+				const __m128 fraction = _mm_sub_ps(turns, _mm_round_ps(turns, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+				__m128 centered = _mm_sub_ps(fraction, _mm_and_ps(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f)), one));
+				centered = _mm_add_ps(centered, _mm_and_ps(_mm_cmplt_ps(centered, _mm_set1_ps(-0.5f)), one));
+
+				const __m128i bits = _mm_cvtps_epi32(_mm_round_ps(_mm_mul_ps(centered, _mm_set1_ps(0x1p32f)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+				return _mm_and_si128(bits, _mm_castps_si128(_mm_cmpord_ps(centered, centered)));
+			}
+
+			PCS_SIMD_TARGET("sse4.2") static void from_base_float_sse42(const float *values, float reciprocal, bam32 *bams, std::size_t count) noexcept
+			{
+				const __m128 scale = _mm_set1_ps(reciprocal);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(bams + i), float_turns_sse42(_mm_mul_ps(_mm_loadu_ps(values + i), scale)));
+
+				from_base_float_scalar(values + i, reciprocal, bams + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("sse4.2") static void from_base_alt_sse42(const double *values, double base, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m128d base_vec = _mm_set1_pd(base);
+				const __m128d scale = _mm_set1_pd(0x1p53);
+				alignas(16) double scaled[2];
+
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					_mm_store_pd(scaled, _mm_mul_pd(fraction_sse42(_mm_loadu_pd(values + i), base_vec), scale));
+					bams[i].value = static_cast<unsigned long long>(scaled[0]) << 11;
+					bams[i + 1].value = static_cast<unsigned long long>(scaled[1]) << 11;
+				}
+
+				from_base_alt_scalar(values + i, base, bams + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("sse4.2") static void to_base_sse42(const bam64 *bams, double base, double *values, std::size_t count) noexcept
+			{
+				const __m128d base_vec = _mm_set1_pd(base);
+				const __m128d scale = _mm_set1_pd(bam64::bam_to_unit_period);
+
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					const __m128i bits = clamp_u64_sse42(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bams + i)), 0xfffffffffffff800);
+					_mm_storeu_pd(values + i, _mm_mul_pd(_mm_mul_pd(base_vec, u64_to_double_sse42(bits)), scale));
+				}
+
+				to_base_scalar(bams + i, base, values + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("sse4.2") static void to_base_alt_sse42(const bam64 *bams, double base, double *values, std::size_t count) noexcept
+			{
+				const __m128d base_vec = _mm_set1_pd(base);
+				const __m128d scale = _mm_set1_pd(0x1p53);
+
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					const __m128i bits = _mm_srli_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bams + i)), 11);
+					_mm_storeu_pd(values + i, _mm_mul_pd(base_vec, _mm_div_pd(u64_to_double_sse42(bits), scale)));
+				}
+
+				to_base_alt_scalar(bams + i, base, values + i, count - i);
+			}
+
+			// detail::atan_bam_units()
+			PCS_SIMD_TARGET("sse4.2") static __m128d atan_bam_units_sse42(__m128d t) noexcept
+			{
+				constexpr std::size_t last = std::size(detail::atan_bam_coefficients) - 1;
+				const __m128d t2 = _mm_mul_pd(t, t);
+				__m128d sum = _mm_set1_pd(detail::atan_bam_coefficients[last]);
+				for (std::size_t i = last; i-- > 0;)
+				{
+					sum = _mm_add_pd(_mm_mul_pd(sum, t2), _mm_set1_pd(detail::atan_bam_coefficients[i]));
+				}
+				return _mm_mul_pd(t, sum);
+			}
+
+			// angle + constant where mask is all ones, using (angle ^ mask) - mask to negate
+			PCS_SIMD_TARGET("sse4.2") static __m128i negate_add_sse42(__m128i angle, __m128i mask, unsigned long long constant) noexcept
+			{
+				const __m128i negated = _mm_sub_epi64(_mm_xor_si128(angle, mask), mask);
+				return _mm_add_epi64(negated, _mm_and_si128(mask, _mm_set1_epi64x(static_cast<long long>(constant))));
+			}
+
+			PCS_SIMD_TARGET("sse4.2") static void atan2_sse42(const double *ys, const double *xs, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m128d sign = _mm_set1_pd(-0.0);
+				const __m128d zero = _mm_setzero_pd();
+				const __m128d tan_eighth_pi = _mm_set1_pd(detail::tan_eighth_pi);
+				alignas(16) double offsets[2];
+
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					const __m128d y = _mm_loadu_pd(ys + i);
+					const __m128d x = _mm_loadu_pd(xs + i);
+					const __m128d x_magnitude = _mm_andnot_pd(sign, x);
+					const __m128d y_magnitude = _mm_andnot_pd(sign, y);
+
+					const __m128d swap = _mm_cmpgt_pd(y_magnitude, x_magnitude);
+					const __m128d low = _mm_blendv_pd(y_magnitude, x_magnitude, swap);
+					const __m128d high = _mm_blendv_pd(x_magnitude, y_magnitude, swap);
+					const __m128d upper = _mm_cmpgt_pd(low, _mm_mul_pd(high, tan_eighth_pi));
+					const __m128d numerator = _mm_blendv_pd(low, _mm_sub_pd(low, high), upper);
+					const __m128d denominator = _mm_blendv_pd(high, _mm_add_pd(low, high), upper);
+					const __m128d t = _mm_div_pd(numerator, denominator);
+					const __m128d invalid = _mm_cmpunord_pd(t, t);
+
+					// no 64-bit conversion, so it is done a lane at a time, avoiding the undefined behavior of converting NaN
+					_mm_store_pd(offsets, atan_bam_units_sse42(t));
+					__m128i angle = _mm_set_epi64x(
+						(offsets[1] == offsets[1]) ? static_cast<long long>(offsets[1]) : 0,
+						(offsets[0] == offsets[0]) ? static_cast<long long>(offsets[0]) : 0);
+
+					angle = _mm_add_epi64(angle, _mm_and_si128(_mm_castpd_si128(upper), _mm_set1_epi64x(static_cast<long long>(pcs::eighth))));
+					angle = negate_add_sse42(angle, _mm_castpd_si128(swap), pcs::fourth);
+					angle = negate_add_sse42(angle, _mm_castpd_si128(_mm_cmplt_pd(x, zero)), pcs::half);
+					angle = negate_add_sse42(angle, _mm_castpd_si128(_mm_cmplt_pd(y, zero)), 0);
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(bams + i), _mm_andnot_si128(_mm_castpd_si128(invalid), angle));
+				}
+
+				atan2_scalar(ys + i, xs + i, bams + i, count - i);
+			}
+
+			// detail::table_sincos() polynomials for sin(d) and cos(d) - 1, in the same order
+			template <trig_accuracy Accuracy>
+			PCS_SIMD_TARGET("sse4.2") static void sincos_offset_sse42(__m128d offset, __m128d &sin_offset, __m128d &cos_offset_minus_1) noexcept
+			{
+				const __m128d offset2 = _mm_mul_pd(offset, offset);
+				if constexpr (Accuracy == trig_accuracy::fast)
+				{
+					sin_offset = offset;
+					cos_offset_minus_1 = _mm_mul_pd(_mm_set1_pd(-0.5), offset2);
+				}
+				else if constexpr (Accuracy == trig_accuracy::balanced)
+				{
+					sin_offset = _mm_mul_pd(offset, _mm_sub_pd(_mm_set1_pd(1.0), _mm_mul_pd(offset2, _mm_set1_pd(1.0 / 6.0))));
+					cos_offset_minus_1 = _mm_mul_pd(offset2, _mm_add_pd(_mm_set1_pd(-0.5), _mm_mul_pd(offset2, _mm_set1_pd(1.0 / 24.0))));
+				}
+				else
+				{
+					sin_offset = _mm_mul_pd(offset, _mm_sub_pd(_mm_set1_pd(1.0), _mm_mul_pd(offset2, _mm_sub_pd(_mm_set1_pd(1.0 / 6.0), _mm_mul_pd(offset2, _mm_set1_pd(1.0 / 120.0))))));
+					cos_offset_minus_1 = _mm_mul_pd(offset2, _mm_add_pd(_mm_set1_pd(-0.5), _mm_mul_pd(offset2, _mm_sub_pd(_mm_set1_pd(1.0 / 24.0), _mm_mul_pd(offset2, _mm_set1_pd(1.0 / 720.0))))));
+				}
+			}
+
+			// no gathers, so the table entries are loaded a lane at a time
+			template <trig_accuracy Accuracy>
+			PCS_SIMD_TARGET("sse4.2") static void sincos_sse42(const bam64 *bams, double *sines, double *cosines, std::size_t count) noexcept
+			{
+				const __m128i half_entry = _mm_set1_epi64x(1LL << (sincos_entry_shift - 1));
+				const __m128i entry_mask = _mm_set1_epi64x(static_cast<long long>(~((1ULL << sincos_entry_shift) - 1)));
+				const __m128i sign_bit = _mm_set1_epi64x(static_cast<long long>(0x8000000000000000));
+				const __m128d radians = _mm_set1_pd(detail::radians_per_bam);
+				const auto &table = detail::quarter_wave_table;
+				constexpr std::size_t index_mask = detail::quarter_wave_intervals - 1;
+
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bams + i));
+					const __m128i entry = _mm_and_si128(_mm_add_epi64(value, half_entry), entry_mask);
+
+					// the offset has at most 53 significant bits, so its magnitude converts exactly, and the sign goes back on after
+					const __m128i difference = _mm_sub_epi64(value, entry);
+					const __m128i negative = _mm_cmpgt_epi64(_mm_setzero_si128(), difference);
+					const __m128i magnitude = _mm_sub_epi64(_mm_xor_si128(difference, negative), negative);
+					const __m128d signed_offset = _mm_or_pd(u64_to_double_sse42(magnitude), _mm_castsi128_pd(_mm_and_si128(negative, sign_bit)));
+					const __m128d offset = _mm_mul_pd(signed_offset, radians);
+
+					__m128d sin_offset;
+					__m128d cos_offset_minus_1;
+					sincos_offset_sse42<Accuracy>(offset, sin_offset, cos_offset_minus_1);
+
+					const auto index0 = static_cast<std::size_t>(_mm_cvtsi128_si64(entry) >> sincos_entry_shift) & index_mask;
+					const auto index1 = static_cast<std::size_t>(_mm_extract_epi64(entry, 1) >> sincos_entry_shift) & index_mask;
+					const __m128d entry_sin = _mm_set_pd(table[index1], table[index0]);
+					const __m128d entry_cos = _mm_set_pd(table[detail::quarter_wave_intervals - index1], table[detail::quarter_wave_intervals - index0]);
+
+					// the quadrant is the top two bits. bit 62 swaps sine and cosine, bit 63 negates the sine, and bit 63 ^ bit 62
+					// negates the cosine.
+					const __m128d swap = _mm_castsi128_pd(_mm_slli_epi64(entry, 1));
+					const __m128d sin_sign = _mm_castsi128_pd(_mm_and_si128(entry, sign_bit));
+					const __m128d cos_sign = _mm_castsi128_pd(_mm_and_si128(_mm_xor_si128(entry, _mm_slli_epi64(entry, 1)), sign_bit));
+					const __m128d sin_value = _mm_xor_pd(_mm_blendv_pd(entry_sin, entry_cos, swap), sin_sign);
+					const __m128d cos_value = _mm_xor_pd(_mm_blendv_pd(entry_cos, entry_sin, swap), cos_sign);
+
+					_mm_storeu_pd(sines + i, _mm_add_pd(sin_value, _mm_add_pd(_mm_mul_pd(sin_value, cos_offset_minus_1), _mm_mul_pd(cos_value, sin_offset))));
+					_mm_storeu_pd(cosines + i, _mm_add_pd(cos_value, _mm_sub_pd(_mm_mul_pd(cos_value, cos_offset_minus_1), _mm_mul_pd(sin_value, sin_offset))));
+				}
+
+				sincos_scalar<Accuracy>(bams + i, sines + i, cosines + i, count - i);
+			}
+
+			// every lane adds the step times the lane count, so there is one add per vector
+			PCS_SIMD_TARGET("sse4.2") static void ramp_sse42(bam64 start, bam64 step, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m128i stride = _mm_set1_epi64x(static_cast<long long>((step * 2).value));
+				__m128i phases = _mm_set_epi64x(static_cast<long long>((start + step).value), static_cast<long long>(start.value));
+
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(bams + i), phases);
+					phases = _mm_add_epi64(phases, stride);
+				}
+
+				ramp_scalar(start + step * i, step, bams + i, count - i);
+			}
+
+			//
+			// avx2 - 4 lanes
+			//
+
+			// fractional part of value / base, in [0, 1]
+			PCS_SIMD_TARGET("avx2") static __m256d fraction_avx2(__m256d values, __m256d base) noexcept
+			{
+				const __m256d turns = _mm256_div_pd(values, base);
+				const __m256d fraction = _mm256_sub_pd(turns, _mm256_round_pd(turns, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+				const __m256d negative = _mm256_cmp_pd(fraction, _mm256_setzero_pd(), _CMP_LT_OQ);
+				return _mm256_add_pd(fraction, _mm256_and_pd(negative, _mm256_set1_pd(1.0)));
+			}
+
+			// truncating conversion from a non-negative double to unsigned 64-bit, which avx2 doesn't have.
+			// the mantissa with its implicit bit is shifted by the unbiased exponent. shift counts of 64 or more give zero,
+			// so only one of the two shifts contributes, and values below 1.0 (including zero and subnormals) become zero.
+			PCS_SIMD_TARGET("avx2") static __m256i double_to_u64_avx2(__m256d values) noexcept
+			{
+				const __m256i bits = _mm256_castpd_si256(values);
+				const __m256i mantissa = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000fffffffffffff)),
+														 _mm256_set1_epi64x(0x0010000000000000));
+				const __m256i exponent = _mm256_srli_epi64(bits, 52);
+				const __m256i bias = _mm256_set1_epi64x(1075);			// exponent bias + mantissa bits
+				const __m256i left = _mm256_sllv_epi64(mantissa, _mm256_sub_epi64(exponent, bias));
+				const __m256i right = _mm256_srlv_epi64(mantissa, _mm256_sub_epi64(bias, exponent));
+				return _mm256_or_si256(left, right);
+			}
+
+			// see u64_to_double_sse42()
+			PCS_SIMD_TARGET("avx2") static __m256d u64_to_double_avx2(__m256i bits) noexcept
+			{
+				const __m256i high = _mm256_or_si256(_mm256_srli_epi64(bits, 32), _mm256_castpd_si256(_mm256_set1_pd(0x1p84)));
+				const __m256i low = _mm256_blend_epi32(bits, _mm256_castpd_si256(_mm256_set1_pd(0x1p52)), 0xaa);
+				const __m256d high_value = _mm256_sub_pd(_mm256_castsi256_pd(high), _mm256_set1_pd(0x1p84 + 0x1p52));
+				return _mm256_add_pd(high_value, _mm256_castsi256_pd(low));
+			}
+
+			// see clamp_u64_sse42()
+			PCS_SIMD_TARGET("avx2") static __m256i clamp_u64_avx2(__m256i bits, unsigned long long limit) noexcept
+			{
+				const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000));
+				const __m256i max_bits = _mm256_set1_epi64x(static_cast<long long>(limit));
+				const __m256i too_big = _mm256_cmpgt_epi64(_mm256_xor_si256(bits, sign), _mm256_xor_si256(max_bits, sign));
+				return _mm256_blendv_epi8(bits, max_bits, too_big);
+			}
+
+			PCS_SIMD_TARGET("avx2") static void from_base_avx2(const double *values, double base, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m256d base_vec = _mm256_set1_pd(base);
+				const __m256d scale = _mm256_set1_pd(bam64::unit_period_to_bam);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256d scaled = _mm256_mul_pd(fraction_avx2(_mm256_loadu_pd(values + i), base_vec), scale);
+					_mm256_storeu_si256(reinterpret_cast<__m256i *>(bams + i), double_to_u64_avx2(scaled));
+				}
+
+				from_base_scalar(values + i, base, bams + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("avx2") static __m256i float_turns_avx2(__m256 turns) noexcept
+			{
+				const __m256 one = _mm256_set1_ps(1.0f);
+				const __m256 fraction = _mm256_sub_ps(turns, _mm256_round_ps(turns, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+				__m256 centered = _mm256_sub_ps(fraction, _mm256_and_ps(_mm256_cmp_ps(fraction, _mm256_set1_ps(0.5f), _CMP_GE_OQ), one));
+				centered = _mm256_add_ps(centered, _mm256_and_ps(_mm256_cmp_ps(centered, _mm256_set1_ps(-0.5f), _CMP_LT_OQ), one));
+
+				const __m256i bits = _mm256_cvtps_epi32(_mm256_round_ps(_mm256_mul_ps(centered, _mm256_set1_ps(0x1p32f)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+				return _mm256_and_si256(bits, _mm256_castps_si256(_mm256_cmp_ps(centered, centered, _CMP_ORD_Q)));
+			}
+
+			PCS_SIMD_TARGET("avx2") static void from_base_float_avx2(const float *values, float reciprocal, bam32 *bams, std::size_t count) noexcept
+			{
+				const __m256 scale = _mm256_set1_ps(reciprocal);
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+					_mm256_storeu_si256(reinterpret_cast<__m256i *>(bams + i), float_turns_avx2(_mm256_mul_ps(_mm256_loadu_ps(values + i), scale)));
+
+				from_base_float_sse42(values + i, reciprocal, bams + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("avx2") static void from_base_alt_avx2(const double *values, double base, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m256d base_vec = _mm256_set1_pd(base);
+				const __m256d scale = _mm256_set1_pd(0x1p53);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256d scaled = _mm256_mul_pd(fraction_avx2(_mm256_loadu_pd(values + i), base_vec), scale);
+					_mm256_storeu_si256(reinterpret_cast<__m256i *>(bams + i), _mm256_slli_epi64(double_to_u64_avx2(scaled), 11));
+				}
+
+				from_base_alt_scalar(values + i, base, bams + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("avx2") static void to_base_avx2(const bam64 *bams, double base, double *values, std::size_t count) noexcept
+			{
+				const __m256d base_vec = _mm256_set1_pd(base);
+				const __m256d scale = _mm256_set1_pd(bam64::bam_to_unit_period);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256i bits = clamp_u64_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(bams + i)), 0xfffffffffffff800);
+					_mm256_storeu_pd(values + i, _mm256_mul_pd(_mm256_mul_pd(base_vec, u64_to_double_avx2(bits)), scale));
+				}
+
+				to_base_scalar(bams + i, base, values + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("avx2") static void to_base_alt_avx2(const bam64 *bams, double base, double *values, std::size_t count) noexcept
+			{
+				const __m256d base_vec = _mm256_set1_pd(base);
+				const __m256d scale = _mm256_set1_pd(0x1p53);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256i bits = _mm256_srli_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(bams + i)), 11);
+					_mm256_storeu_pd(values + i, _mm256_mul_pd(base_vec, _mm256_div_pd(u64_to_double_avx2(bits), scale)));
+				}
+
+				to_base_alt_scalar(bams + i, base, values + i, count - i);
+			}
+
+			// detail::atan_bam_units()
+			PCS_SIMD_TARGET("avx2") static __m256d atan_bam_units_avx2(__m256d t) noexcept
+			{
+				constexpr std::size_t last = std::size(detail::atan_bam_coefficients) - 1;
+				const __m256d t2 = _mm256_mul_pd(t, t);
+				__m256d sum = _mm256_set1_pd(detail::atan_bam_coefficients[last]);
+				for (std::size_t i = last; i-- > 0;)
+				{
+					sum = _mm256_add_pd(_mm256_mul_pd(sum, t2), _mm256_set1_pd(detail::atan_bam_coefficients[i]));
+				}
+				return _mm256_mul_pd(t, sum);
+			}
+
+			// see negate_add_sse42()
+			PCS_SIMD_TARGET("avx2") static __m256i negate_add_avx2(__m256i angle, __m256i mask, unsigned long long constant) noexcept
+			{
+				const __m256i negated = _mm256_sub_epi64(_mm256_xor_si256(angle, mask), mask);
+				return _mm256_add_epi64(negated, _mm256_and_si256(mask, _mm256_set1_epi64x(static_cast<long long>(constant))));
+			}
+
+			PCS_SIMD_TARGET("avx2") static void atan2_avx2(const double *ys, const double *xs, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m256d sign = _mm256_set1_pd(-0.0);
+				const __m256d zero = _mm256_setzero_pd();
+				const __m256d tan_eighth_pi = _mm256_set1_pd(detail::tan_eighth_pi);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256d y = _mm256_loadu_pd(ys + i);
+					const __m256d x = _mm256_loadu_pd(xs + i);
+					const __m256d x_magnitude = _mm256_andnot_pd(sign, x);
+					const __m256d y_magnitude = _mm256_andnot_pd(sign, y);
+
+					const __m256d swap = _mm256_cmp_pd(y_magnitude, x_magnitude, _CMP_GT_OQ);
+					const __m256d low = _mm256_blendv_pd(y_magnitude, x_magnitude, swap);
+					const __m256d high = _mm256_blendv_pd(x_magnitude, y_magnitude, swap);
+					const __m256d upper = _mm256_cmp_pd(low, _mm256_mul_pd(high, tan_eighth_pi), _CMP_GT_OQ);
+					const __m256d numerator = _mm256_blendv_pd(low, _mm256_sub_pd(low, high), upper);
+					const __m256d denominator = _mm256_blendv_pd(high, _mm256_add_pd(low, high), upper);
+					const __m256d t = _mm256_div_pd(numerator, denominator);
+					const __m256d invalid = _mm256_cmp_pd(t, t, _CMP_UNORD_Q);
+
+					// truncate the magnitude, then negate, which is the same as the scalar cast to long long
+					const __m256d offset = atan_bam_units_avx2(t);
+					const __m256i negative = _mm256_castpd_si256(_mm256_cmp_pd(offset, zero, _CMP_LT_OQ));
+					__m256i angle = negate_add_avx2(double_to_u64_avx2(_mm256_andnot_pd(sign, offset)), negative, 0);
+
+					angle = _mm256_add_epi64(angle, _mm256_and_si256(_mm256_castpd_si256(upper), _mm256_set1_epi64x(static_cast<long long>(pcs::eighth))));
+					angle = negate_add_avx2(angle, _mm256_castpd_si256(swap), pcs::fourth);
+					angle = negate_add_avx2(angle, _mm256_castpd_si256(_mm256_cmp_pd(x, zero, _CMP_LT_OQ)), pcs::half);
+					angle = negate_add_avx2(angle, _mm256_castpd_si256(_mm256_cmp_pd(y, zero, _CMP_LT_OQ)), 0);
+					_mm256_storeu_si256(reinterpret_cast<__m256i *>(bams + i), _mm256_andnot_si256(_mm256_castpd_si256(invalid), angle));
+				}
+
+				atan2_scalar(ys + i, xs + i, bams + i, count - i);
+			}
+
+			// see sincos_offset_sse42()
+			template <trig_accuracy Accuracy>
+			PCS_SIMD_TARGET("avx2") static void sincos_offset_avx2(__m256d offset, __m256d &sin_offset, __m256d &cos_offset_minus_1) noexcept
+			{
+				const __m256d offset2 = _mm256_mul_pd(offset, offset);
+				if constexpr (Accuracy == trig_accuracy::fast)
+				{
+					sin_offset = offset;
+					cos_offset_minus_1 = _mm256_mul_pd(_mm256_set1_pd(-0.5), offset2);
+				}
+				else if constexpr (Accuracy == trig_accuracy::balanced)
+				{
+					sin_offset = _mm256_mul_pd(offset, _mm256_sub_pd(_mm256_set1_pd(1.0), _mm256_mul_pd(offset2, _mm256_set1_pd(1.0 / 6.0))));
+					cos_offset_minus_1 = _mm256_mul_pd(offset2, _mm256_add_pd(_mm256_set1_pd(-0.5), _mm256_mul_pd(offset2, _mm256_set1_pd(1.0 / 24.0))));
+				}
+				else
+				{
+					sin_offset = _mm256_mul_pd(offset, _mm256_sub_pd(_mm256_set1_pd(1.0), _mm256_mul_pd(offset2, _mm256_sub_pd(_mm256_set1_pd(1.0 / 6.0), _mm256_mul_pd(offset2, _mm256_set1_pd(1.0 / 120.0))))));
+					cos_offset_minus_1 = _mm256_mul_pd(offset2, _mm256_add_pd(_mm256_set1_pd(-0.5), _mm256_mul_pd(offset2, _mm256_sub_pd(_mm256_set1_pd(1.0 / 24.0), _mm256_mul_pd(offset2, _mm256_set1_pd(1.0 / 720.0))))));
+				}
+			}
+
+			// see sincos_sse42()
+			template <trig_accuracy Accuracy>
+			PCS_SIMD_TARGET("avx2") static void sincos_avx2(const bam64 *bams, double *sines, double *cosines, std::size_t count) noexcept
+			{
+				const __m256i half_entry = _mm256_set1_epi64x(1LL << (sincos_entry_shift - 1));
+				const __m256i entry_mask = _mm256_set1_epi64x(static_cast<long long>(~((1ULL << sincos_entry_shift) - 1)));
+				const __m256i index_mask = _mm256_set1_epi64x(static_cast<long long>(detail::quarter_wave_intervals - 1));
+				const __m256i intervals = _mm256_set1_epi64x(static_cast<long long>(detail::quarter_wave_intervals));
+				const __m256i sign_bit = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000));
+				const __m256d radians = _mm256_set1_pd(detail::radians_per_bam);
+				const double *table = detail::quarter_wave_table.data();
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bams + i));
+					const __m256i entry = _mm256_and_si256(_mm256_add_epi64(value, half_entry), entry_mask);
+
+					const __m256i difference = _mm256_sub_epi64(value, entry);
+					const __m256i negative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), difference);
+					const __m256i magnitude = _mm256_sub_epi64(_mm256_xor_si256(difference, negative), negative);
+					const __m256d signed_offset = _mm256_or_pd(u64_to_double_avx2(magnitude), _mm256_castsi256_pd(_mm256_and_si256(negative, sign_bit)));
+					const __m256d offset = _mm256_mul_pd(signed_offset, radians);
+
+					__m256d sin_offset;
+					__m256d cos_offset_minus_1;
+					sincos_offset_avx2<Accuracy>(offset, sin_offset, cos_offset_minus_1);
+
+					const __m256i index = _mm256_and_si256(_mm256_srli_epi64(entry, sincos_entry_shift), index_mask);
+					const __m256d entry_sin = _mm256_i64gather_pd(table, index, 8);
+					const __m256d entry_cos = _mm256_i64gather_pd(table, _mm256_sub_epi64(intervals, index), 8);
+
+					const __m256d swap = _mm256_castsi256_pd(_mm256_slli_epi64(entry, 1));
+					const __m256d sin_sign = _mm256_castsi256_pd(_mm256_and_si256(entry, sign_bit));
+					const __m256d cos_sign = _mm256_castsi256_pd(_mm256_and_si256(_mm256_xor_si256(entry, _mm256_slli_epi64(entry, 1)), sign_bit));
+					const __m256d sin_value = _mm256_xor_pd(_mm256_blendv_pd(entry_sin, entry_cos, swap), sin_sign);
+					const __m256d cos_value = _mm256_xor_pd(_mm256_blendv_pd(entry_cos, entry_sin, swap), cos_sign);
+
+					_mm256_storeu_pd(sines + i, _mm256_add_pd(sin_value, _mm256_add_pd(_mm256_mul_pd(sin_value, cos_offset_minus_1), _mm256_mul_pd(cos_value, sin_offset))));
+					_mm256_storeu_pd(cosines + i, _mm256_add_pd(cos_value, _mm256_sub_pd(_mm256_mul_pd(cos_value, cos_offset_minus_1), _mm256_mul_pd(sin_value, sin_offset))));
+				}
+
+				sincos_scalar<Accuracy>(bams + i, sines + i, cosines + i, count - i);
+			}
+
+			// see ramp_sse42()
+			PCS_SIMD_TARGET("avx2") static void ramp_avx2(bam64 start, bam64 step, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m256i stride = _mm256_set1_epi64x(static_cast<long long>((step * 4).value));
+				__m256i phases = _mm256_set_epi64x(static_cast<long long>((start + step * 3).value), static_cast<long long>((start + step * 2).value),
+												   static_cast<long long>((start + step).value), static_cast<long long>(start.value));
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					_mm256_storeu_si256(reinterpret_cast<__m256i *>(bams + i), phases);
+					phases = _mm256_add_epi64(phases, stride);
+				}
+
+				ramp_scalar(start + step * i, step, bams + i, count - i);
+			}
+
+			//
+			// avx-512 - 8 lanes
+			//
+
+			// fractional part of value / base, in [0, 1]
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512d fraction_avx512(__m512d values, __m512d base) noexcept
+			{
+				const __m512d turns = _mm512_div_pd(values, base);
+				const __m512d fraction = _mm512_sub_pd(turns, _mm512_roundscale_pd(turns, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+				const __mmask8 negative = _mm512_cmp_pd_mask(fraction, _mm512_setzero_pd(), _CMP_LT_OQ);
+				return _mm512_mask_add_pd(fraction, negative, fraction, _mm512_set1_pd(1.0));
+			}
+
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void from_base_avx512(const double *values, double base, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m512d base_vec = _mm512_set1_pd(base);
+				const __m512d scale = _mm512_set1_pd(bam64::unit_period_to_bam);
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m512d scaled = _mm512_mul_pd(fraction_avx512(_mm512_loadu_pd(values + i), base_vec), scale);
+					_mm512_storeu_si512(bams + i, _mm512_cvttpd_epu64(scaled));
+				}
+
+				from_base_scalar(values + i, base, bams + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512i float_turns_avx512(__m512 turns) noexcept
+			{
+				const __m512 one = _mm512_set1_ps(1.0f);
+				const __m512 fraction = _mm512_sub_ps(turns, _mm512_roundscale_ps(turns, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+				__m512 centered = _mm512_mask_sub_ps(fraction, _mm512_cmp_ps_mask(fraction, _mm512_set1_ps(0.5f), _CMP_GE_OQ), fraction, one);
+				centered = _mm512_mask_add_ps(centered, _mm512_cmp_ps_mask(centered, _mm512_set1_ps(-0.5f), _CMP_LT_OQ), centered, one);
+
+				const __m512i bits = _mm512_cvtps_epi32(_mm512_roundscale_ps(_mm512_mul_ps(centered, _mm512_set1_ps(0x1p32f)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+				return _mm512_maskz_mov_epi32(_mm512_cmp_ps_mask(centered, centered, _CMP_ORD_Q), bits);
+			}
+
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void from_base_float_avx512(const float *values, float reciprocal, bam32 *bams, std::size_t count) noexcept
+			{
+				const __m512 scale = _mm512_set1_ps(reciprocal);
+
+				std::size_t i = 0;
+				for (; i + 16 <= count; i += 16)
+					_mm512_storeu_si512(bams + i, float_turns_avx512(_mm512_mul_ps(_mm512_loadu_ps(values + i), scale)));
+
+				from_base_float_avx2(values + i, reciprocal, bams + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void from_base_alt_avx512(const double *values, double base, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m512d base_vec = _mm512_set1_pd(base);
+				const __m512d scale = _mm512_set1_pd(0x1p53);
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m512d scaled = _mm512_mul_pd(fraction_avx512(_mm512_loadu_pd(values + i), base_vec), scale);
+					_mm512_storeu_si512(bams + i, _mm512_slli_epi64(_mm512_cvttpd_epu64(scaled), 11));
+				}
+
+				from_base_alt_scalar(values + i, base, bams + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void to_base_avx512(const bam64 *bams, double base, double *values, std::size_t count) noexcept
+			{
+				const __m512d base_vec = _mm512_set1_pd(base);
+				const __m512d scale = _mm512_set1_pd(bam64::bam_to_unit_period);
+				const __m512i max_bits = _mm512_set1_epi64(static_cast<long long>(0xfffffffffffff800));
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m512i bits = _mm512_min_epu64(_mm512_loadu_si512(bams + i), max_bits);
+					_mm512_storeu_pd(values + i, _mm512_mul_pd(_mm512_mul_pd(base_vec, _mm512_cvtepu64_pd(bits)), scale));
+				}
+
+				to_base_scalar(bams + i, base, values + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void to_base_alt_avx512(const bam64 *bams, double base, double *values, std::size_t count) noexcept
+			{
+				const __m512d base_vec = _mm512_set1_pd(base);
+				const __m512d scale = _mm512_set1_pd(0x1p53);
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m512i bits = _mm512_srli_epi64(_mm512_loadu_si512(bams + i), 11);
+					_mm512_storeu_pd(values + i, _mm512_mul_pd(base_vec, _mm512_div_pd(_mm512_cvtepu64_pd(bits), scale)));
+				}
+
+				to_base_alt_scalar(bams + i, base, values + i, count - i);
+			}
+
+			// detail::atan_bam_units()
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512d atan_bam_units_avx512(__m512d t) noexcept
+			{
+				// avx512f implies fma, so the explicit rounding versions keep the compiler from fusing these like the scalar code
+				constexpr int rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+				constexpr std::size_t last = std::size(detail::atan_bam_coefficients) - 1;
+				const __m512d t2 = _mm512_mul_round_pd(t, t, rounding);
+				__m512d sum = _mm512_set1_pd(detail::atan_bam_coefficients[last]);
+				for (std::size_t i = last; i-- > 0;)
+				{
+					sum = _mm512_add_round_pd(_mm512_mul_round_pd(sum, t2, rounding), _mm512_set1_pd(detail::atan_bam_coefficients[i]), rounding);
+				}
+				return _mm512_mul_round_pd(t, sum, rounding);
+			}
+
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void atan2_avx512(const double *ys, const double *xs, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m512d zero = _mm512_setzero_pd();
+				const __m512d tan_eighth_pi = _mm512_set1_pd(detail::tan_eighth_pi);
+				const __m512i eighth = _mm512_set1_epi64(static_cast<long long>(pcs::eighth));
+				const __m512i fourth = _mm512_set1_epi64(static_cast<long long>(pcs::fourth));
+				const __m512i half = _mm512_set1_epi64(static_cast<long long>(pcs::half));
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m512d y = _mm512_loadu_pd(ys + i);
+					const __m512d x = _mm512_loadu_pd(xs + i);
+					const __m512d x_magnitude = _mm512_abs_pd(x);
+					const __m512d y_magnitude = _mm512_abs_pd(y);
+
+					const __mmask8 swap = _mm512_cmp_pd_mask(y_magnitude, x_magnitude, _CMP_GT_OQ);
+					const __m512d low = _mm512_mask_blend_pd(swap, y_magnitude, x_magnitude);
+					const __m512d high = _mm512_mask_blend_pd(swap, x_magnitude, y_magnitude);
+					const __mmask8 upper = _mm512_cmp_pd_mask(low, _mm512_mul_pd(high, tan_eighth_pi), _CMP_GT_OQ);
+					const __m512d numerator = _mm512_mask_sub_pd(low, upper, low, high);
+					const __m512d denominator = _mm512_mask_add_pd(high, upper, low, high);
+					const __m512d t = _mm512_div_pd(numerator, denominator);
+					const __mmask8 valid = _mm512_cmp_pd_mask(t, t, _CMP_ORD_Q);
+
+					__m512i angle = _mm512_cvttpd_epi64(atan_bam_units_avx512(t));
+					angle = _mm512_mask_add_epi64(angle, upper, angle, eighth);
+					angle = _mm512_mask_sub_epi64(angle, swap, fourth, angle);
+					angle = _mm512_mask_sub_epi64(angle, _mm512_cmp_pd_mask(x, zero, _CMP_LT_OQ), half, angle);
+					angle = _mm512_mask_sub_epi64(angle, _mm512_cmp_pd_mask(y, zero, _CMP_LT_OQ), _mm512_setzero_si512(), angle);
+					_mm512_storeu_si512(bams + i, _mm512_maskz_mov_epi64(valid, angle));
+				}
+
+				atan2_scalar(ys + i, xs + i, bams + i, count - i);
+			}
+
+			// see sincos_offset_sse42(), with explicit rounding so nothing is fused
+			template <trig_accuracy Accuracy>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void sincos_offset_avx512(__m512d offset, __m512d &sin_offset, __m512d &cos_offset_minus_1) noexcept
+			{
+				constexpr int rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+				const __m512d offset2 = _mm512_mul_round_pd(offset, offset, rounding);
+				if constexpr (Accuracy == trig_accuracy::fast)
+				{
+					sin_offset = offset;
+					cos_offset_minus_1 = _mm512_mul_round_pd(_mm512_set1_pd(-0.5), offset2, rounding);
+				}
+				else if constexpr (Accuracy == trig_accuracy::balanced)
+				{
+					sin_offset = _mm512_mul_round_pd(offset, _mm512_sub_round_pd(_mm512_set1_pd(1.0), _mm512_mul_round_pd(offset2, _mm512_set1_pd(1.0 / 6.0), rounding), rounding), rounding);
+					cos_offset_minus_1 = _mm512_mul_round_pd(offset2, _mm512_add_round_pd(_mm512_set1_pd(-0.5), _mm512_mul_round_pd(offset2, _mm512_set1_pd(1.0 / 24.0), rounding), rounding), rounding);
+				}
+				else
+				{
+					const __m512d sin_inner = _mm512_sub_round_pd(_mm512_set1_pd(1.0 / 6.0), _mm512_mul_round_pd(offset2, _mm512_set1_pd(1.0 / 120.0), rounding), rounding);
+					const __m512d cos_inner = _mm512_sub_round_pd(_mm512_set1_pd(1.0 / 24.0), _mm512_mul_round_pd(offset2, _mm512_set1_pd(1.0 / 720.0), rounding), rounding);
+					sin_offset = _mm512_mul_round_pd(offset, _mm512_sub_round_pd(_mm512_set1_pd(1.0), _mm512_mul_round_pd(offset2, sin_inner, rounding), rounding), rounding);
+					cos_offset_minus_1 = _mm512_mul_round_pd(offset2, _mm512_add_round_pd(_mm512_set1_pd(-0.5), _mm512_mul_round_pd(offset2, cos_inner, rounding), rounding), rounding);
+				}
+			}
+
+			// see sincos_sse42()
+			template <trig_accuracy Accuracy>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void sincos_avx512(const bam64 *bams, double *sines, double *cosines, std::size_t count) noexcept
+			{
+				constexpr int rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+				const __m512i half_entry = _mm512_set1_epi64(1LL << (sincos_entry_shift - 1));
+				const __m512i entry_mask = _mm512_set1_epi64(static_cast<long long>(~((1ULL << sincos_entry_shift) - 1)));
+				const __m512i index_mask = _mm512_set1_epi64(static_cast<long long>(detail::quarter_wave_intervals - 1));
+				const __m512i intervals = _mm512_set1_epi64(static_cast<long long>(detail::quarter_wave_intervals));
+				const __m512i sign_bit = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000));
+				const __m512i swap_bit = _mm512_set1_epi64(1LL << 62);
+				const __m512d radians = _mm512_set1_pd(detail::radians_per_bam);
+				const double *table = detail::quarter_wave_table.data();
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m512i value = _mm512_loadu_si512(bams + i);
+					const __m512i entry = _mm512_and_si512(_mm512_add_epi64(value, half_entry), entry_mask);
+
+					// native signed conversion, exact for 53 bits
+					const __m512d offset = _mm512_mul_round_pd(_mm512_cvtepi64_pd(_mm512_sub_epi64(value, entry)), radians, rounding);
+
+					__m512d sin_offset;
+					__m512d cos_offset_minus_1;
+					sincos_offset_avx512<Accuracy>(offset, sin_offset, cos_offset_minus_1);
+
+					const __m512i index = _mm512_and_si512(_mm512_srli_epi64(entry, sincos_entry_shift), index_mask);
+					const __m512d entry_sin = _mm512_i64gather_pd(index, table, 8);
+					const __m512d entry_cos = _mm512_i64gather_pd(_mm512_sub_epi64(intervals, index), table, 8);
+
+					const __mmask8 swap = _mm512_test_epi64_mask(entry, swap_bit);
+					const __m512i sin_sign = _mm512_and_si512(entry, sign_bit);
+					const __m512i cos_sign = _mm512_and_si512(_mm512_xor_si512(entry, _mm512_slli_epi64(entry, 1)), sign_bit);
+					const __m512d sin_value = _mm512_xor_pd(_mm512_mask_blend_pd(swap, entry_sin, entry_cos), _mm512_castsi512_pd(sin_sign));
+					const __m512d cos_value = _mm512_xor_pd(_mm512_mask_blend_pd(swap, entry_cos, entry_sin), _mm512_castsi512_pd(cos_sign));
+
+					const __m512d sin_correction = _mm512_add_round_pd(_mm512_mul_round_pd(sin_value, cos_offset_minus_1, rounding), _mm512_mul_round_pd(cos_value, sin_offset, rounding), rounding);
+					const __m512d cos_correction = _mm512_sub_round_pd(_mm512_mul_round_pd(cos_value, cos_offset_minus_1, rounding), _mm512_mul_round_pd(sin_value, sin_offset, rounding), rounding);
+					_mm512_storeu_pd(sines + i, _mm512_add_round_pd(sin_value, sin_correction, rounding));
+					_mm512_storeu_pd(cosines + i, _mm512_add_round_pd(cos_value, cos_correction, rounding));
+				}
+
+				sincos_scalar<Accuracy>(bams + i, sines + i, cosines + i, count - i);
+			}
+
+			// see ramp_sse42()
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void ramp_avx512(bam64 start, bam64 step, bam64 *bams, std::size_t count) noexcept
+			{
+				const __m512i stride = _mm512_set1_epi64(static_cast<long long>((step * 8).value));
+				const __m512i lanes = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+				__m512i phases = _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(start.value)),
+												  _mm512_mullo_epi64(lanes, _mm512_set1_epi64(static_cast<long long>(step.value))));
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					_mm512_storeu_si512(bams + i, phases);
+					phases = _mm512_add_epi64(phases, stride);
+				}
+
+				ramp_scalar(start + step * i, step, bams + i, count - i);
+			}
+
+#endif
+
+			using from_kernel = void (*)(const double *, double, bam64 *, std::size_t) noexcept;
+			using to_kernel = void (*)(const bam64 *, double, double *, std::size_t) noexcept;
+			using atan2_kernel = void (*)(const double *, const double *, bam64 *, std::size_t) noexcept;
+			using sincos_kernel = void (*)(const bam64 *, double *, double *, std::size_t) noexcept;
+			using ramp_kernel = void (*)(bam64, bam64, bam64 *, std::size_t) noexcept;
+			using from_float_kernel = void (*)(const float *, float, bam32 *, std::size_t) noexcept;
+
+			// pick the kernel for the requested instruction set, never going beyond what is supported
+			template <typename Kernel>
+			static Kernel select(instruction_set isa, Kernel scalar_kernel, [[maybe_unused]] Kernel sse42_kernel,
+								 [[maybe_unused]] Kernel avx2_kernel, [[maybe_unused]] Kernel avx512_kernel) noexcept
+			{
+				if (isa > supported_instruction_set())		{ isa = supported_instruction_set(); }
+
+#if defined(PCS_SIMD_X86)
+				switch (isa)
+				{
+					case instruction_set::avx512:	return avx512_kernel;
+					case instruction_set::avx2:		return avx2_kernel;
+					case instruction_set::sse42:	return sse42_kernel;
+					default:						break;
+				}
+#endif
+
+				return scalar_kernel;
+			}
+
+			static from_kernel select_from_base(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return select<from_kernel>(isa, from_base_scalar, from_base_sse42, from_base_avx2, from_base_avx512);
+#else
+				return select<from_kernel>(isa, from_base_scalar, from_base_scalar, from_base_scalar, from_base_scalar);
+#endif
+			}
+
+			static from_kernel select_from_base_alt(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return select<from_kernel>(isa, from_base_alt_scalar, from_base_alt_sse42, from_base_alt_avx2, from_base_alt_avx512);
+#else
+				return select<from_kernel>(isa, from_base_alt_scalar, from_base_alt_scalar, from_base_alt_scalar, from_base_alt_scalar);
+#endif
+			}
+
+			static to_kernel select_to_base(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return select<to_kernel>(isa, to_base_scalar, to_base_sse42, to_base_avx2, to_base_avx512);
+#else
+				return select<to_kernel>(isa, to_base_scalar, to_base_scalar, to_base_scalar, to_base_scalar);
+#endif
+			}
+
+			static to_kernel select_to_base_alt(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return select<to_kernel>(isa, to_base_alt_scalar, to_base_alt_sse42, to_base_alt_avx2, to_base_alt_avx512);
+#else
+				return select<to_kernel>(isa, to_base_alt_scalar, to_base_alt_scalar, to_base_alt_scalar, to_base_alt_scalar);
+#endif
+			}
+
+			static atan2_kernel select_atan2(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return select<atan2_kernel>(isa, atan2_scalar, atan2_sse42, atan2_avx2, atan2_avx512);
+#else
+				return select<atan2_kernel>(isa, atan2_scalar, atan2_scalar, atan2_scalar, atan2_scalar);
+#endif
+			}
+
+			template <trig_accuracy Accuracy>
+			static sincos_kernel select_sincos(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return select<sincos_kernel>(isa, sincos_scalar<Accuracy>, sincos_sse42<Accuracy>, sincos_avx2<Accuracy>, sincos_avx512<Accuracy>);
+#else
+				return select<sincos_kernel>(isa, sincos_scalar<Accuracy>, sincos_scalar<Accuracy>, sincos_scalar<Accuracy>, sincos_scalar<Accuracy>);
+#endif
+			}
+
+			static sincos_kernel select_sincos(instruction_set isa, trig_accuracy accuracy) noexcept
+			{
+				switch (accuracy)
+				{
+					case trig_accuracy::fast:		return select_sincos<trig_accuracy::fast>(isa);
+					case trig_accuracy::balanced:	return select_sincos<trig_accuracy::balanced>(isa);
+					default:						return select_sincos<trig_accuracy::precise>(isa);
+				}
+			}
+
+			static from_float_kernel select_from_base_float(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return select<from_float_kernel>(isa, from_base_float_scalar, from_base_float_sse42, from_base_float_avx2, from_base_float_avx512);
+#else
+				return select<from_float_kernel>(isa, from_base_float_scalar, from_base_float_scalar, from_base_float_scalar, from_base_float_scalar);
+#endif
+			}
+
+			static ramp_kernel select_ramp(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return select<ramp_kernel>(isa, ramp_scalar, ramp_sse42, ramp_avx2, ramp_avx512);
+#else
+				return select<ramp_kernel>(isa, ramp_scalar, ramp_scalar, ramp_scalar, ramp_scalar);
+#endif
+			}
+
+			// a base of zero makes a zero bam, just like bam64::from_base()
+			static void from_base(from_kernel kernel, std::span<const double> values, double base, std::span<bam64> bams) noexcept
+			{
+				const std::size_t count = (values.size() < bams.size()) ? values.size() : bams.size();
+
+				if (base == 0.0)
+				{
+					for (std::size_t i = 0; i < count; ++i)		{ bams[i].value = 0; }
+					return;
+				}
+
+				kernel(values.data(), base, bams.data(), count);
+			}
+
+			// the reciprocal is taken once, just like bam32::from_base() for floats
+			static void from_base(from_float_kernel kernel, std::span<const float> values, float base, std::span<bam32> bams) noexcept
+			{
+				const std::size_t count = (values.size() < bams.size()) ? values.size() : bams.size();
+
+				if (base == 0.0f)
+				{
+					for (std::size_t i = 0; i < count; ++i)		{ bams[i].value = 0; }
+					return;
+				}
+
+				kernel(values.data(), 1.0f / base, bams.data(), count);
+			}
+
+			static void to_base(to_kernel kernel, std::span<const bam64> bams, double base, std::span<double> values) noexcept
+			{
+				const std::size_t count = (bams.size() < values.size()) ? bams.size() : values.size();
+				kernel(bams.data(), base, values.data(), count);
+			}
+
+			static void atan2(atan2_kernel kernel, std::span<const double> ys, std::span<const double> xs, std::span<bam64> bams) noexcept
+			{
+				std::size_t count = (ys.size() < xs.size()) ? ys.size() : xs.size();
+				count = (count < bams.size()) ? count : bams.size();
+				kernel(ys.data(), xs.data(), bams.data(), count);
+			}
+
+			static void sincos(sincos_kernel kernel, std::span<const bam64> bams, std::span<double> sines, std::span<double> cosines) noexcept
+			{
+				std::size_t count = (bams.size() < sines.size()) ? bams.size() : sines.size();
+				count = (count < cosines.size()) ? count : cosines.size();
+				kernel(bams.data(), sines.data(), cosines.data(), count);
+			}
+
+			static void ramp(ramp_kernel kernel, bam64 start, bam64 step, std::span<bam64> bams) noexcept
+			{
+				kernel(start, step, bams.data(), bams.size());
+			}
+		};
+
+		//
+		// span interface. each converts the first min(input.size(), output.size()) values. the instruction set
+		// defaults to the best one supported, and asking for more than is supported gets what is supported.
+		//
+
+		// same as bam64::from_base() for each value
+		inline void from_base(std::span<const double> values, double base, std::span<bam64> bams,
+							  instruction_set isa = supported_instruction_set()) noexcept
+		{
+			kernels::from_base(kernels::select_from_base(isa), values, base, bams);
+		}
+
+		// same as bam32::from_base() for float spans, with 4, 8, or 16 lanes
+		inline void from_base(std::span<const float> values, float base, std::span<bam32> bams,
+							  instruction_set isa = supported_instruction_set()) noexcept
+		{
+			kernels::from_base(kernels::select_from_base_float(isa), values, base, bams);
+		}
+
+		// alternate version that only captures the top 53 bits of precision
+		inline void from_base_alt(std::span<const double> values, double base, std::span<bam64> bams,
+								  instruction_set isa = supported_instruction_set()) noexcept
+		{
+			kernels::from_base(kernels::select_from_base_alt(isa), values, base, bams);
+		}
+
+		// same as bam64::fraction(base) for each bam
+		inline void to_base(std::span<const bam64> bams, double base, std::span<double> values,
+							instruction_set isa = supported_instruction_set()) noexcept
+		{
+			kernels::to_base(kernels::select_to_base(isa), bams, base, values);
+		}
+
+		// alternate version that only uses the top 53 bits of precision
+		inline void to_base_alt(std::span<const bam64> bams, double base, std::span<double> values,
+								instruction_set isa = supported_instruction_set()) noexcept
+		{
+			kernels::to_base(kernels::select_to_base_alt(isa), bams, base, values);
+		}
+
+		// same as bam64_atan2(ys[i], xs[i]) for each pair, for the first min(ys.size(), xs.size(), bams.size())
+		inline void atan2(std::span<const double> ys, std::span<const double> xs, std::span<bam64> bams,
+						  instruction_set isa = supported_instruction_set()) noexcept
+		{
+			kernels::atan2(kernels::select_atan2(isa), ys, xs, bams);
+		}
+
+		// same as pcs::sincos() for each bam, for the first min(bams.size(), sines.size(), cosines.size())
+		inline void sincos(std::span<const bam64> bams, std::span<double> sines, std::span<double> cosines,
+						   trig_accuracy accuracy = trig_accuracy::precise, instruction_set isa = supported_instruction_set()) noexcept
+		{
+			kernels::sincos(kernels::select_sincos(isa, accuracy), bams, sines, cosines);
+		}
+
+		// bams[i] = start + step * i, wrapping around, which is a phase accumulator that adds step once per sample. every bam
+		// is exact, so there is no drift however long the ramp is.
+		inline void ramp(bam64 start, bam64 step, std::span<bam64> bams, instruction_set isa = supported_instruction_set()) noexcept
+		{
+			kernels::ramp(kernels::select_ramp(isa), start, step, bams);
+		}
+
+	}	// namespace simd
+
+}	// namespace pcs
+
+// closing include guard
+#endif
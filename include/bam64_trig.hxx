@@ -0,0 +1,264 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_BAM64_TRIG_HXX)
+#define PCS_BAM64_TRIG_HXX
+
+#include "bam64.hxx"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// trigonometric functions that work directly on bam64, without going through radians.
+	//
+	// the top bits of a bam select a quadrant and an entry in a quarter-wave table of sines. the remaining low bits are a
+	// small signed offset from that entry, whose sine and cosine come from short taylor polynomials, and the angle sum
+	// identities combine the two. the table has 2^8 intervals per quadrant, so the offset is at most 2pi / 2^11 radians.
+	//
+
+	// how many taylor terms are used for the offset from the nearest table entry. the max absolute errors are measured against
+	// std::sin() and std::cos() of to_radians().
+	enum class trig_accuracy
+	{
+		fast,				// sin(d) ~ d, cos(d) ~ 1 - d^2/2								max error ~5e-9
+		balanced,			// one more term for each									max error ~3e-15
+		precise				// two more terms for each, limited by the table itself		max error ~3e-16
+	};
+
+	// sine and cosine of the same angle
+	struct sin_cos
+	{
+		double sin;
+		double cos;
+	};
+
+	namespace detail
+	{
+		// number of bits of a bam used to index the table within a quadrant
+		inline constexpr int quarter_wave_bits = 8;
+		inline constexpr std::size_t quarter_wave_intervals = std::size_t{1} << quarter_wave_bits;
+
+		// taylor series for small arguments, used to build the table at compile time.
+		// the terms fall off fast enough for |x| <= pi/4 that 12 terms is more than double precision.
+		inline constexpr double taylor_sin(double x) noexcept
+		{
+			const double x2 = x * x;
+			double sum = 0.0;
+			for (int n = 12; n > 0; --n)
+			{
+				sum = 1.0 - x2 / ((2.0 * n) * (2.0 * n + 1.0)) * sum;
+			}
+			return x * sum;
+		}
+
+		inline constexpr double taylor_cos(double x) noexcept
+		{
+			const double x2 = x * x;
+			double sum = 0.0;
+			for (int n = 12; n > 0; --n)
+			{
+				sum = 1.0 - x2 / ((2.0 * n - 1.0) * (2.0 * n)) * sum;
+			}
+			return sum;
+		}
+
+		// sin(half_pi * i / intervals) for i in [0, intervals]. the cosine of entry i is entry (intervals - i).
+		// the upper half of the quadrant comes from the cosine of the complementary angle so the series argument stays small.
+		inline constexpr auto quarter_wave_table = []() noexcept
+		{
+			std::array<double, quarter_wave_intervals + 1> table{};
+			for (std::size_t i = 0; i <= quarter_wave_intervals; ++i)
+			{
+				if (2 * i <= quarter_wave_intervals)
+					table[i] = taylor_sin(pcs::half_pi * static_cast<double>(i) / static_cast<double>(quarter_wave_intervals));
+				else
+					table[i] = taylor_cos(pcs::half_pi * static_cast<double>(quarter_wave_intervals - i) / static_cast<double>(quarter_wave_intervals));
+			}
+			return table;
+		}();
+
+		// radians in one bam unit
+		inline constexpr double radians_per_bam = pcs::two_pi * 0x1p-64;
+
+		// the table lookup and polynomial correction shared by sin(), cos(), and sincos()
+		inline constexpr sin_cos table_sincos(bam64 bam, trig_accuracy accuracy) noexcept
+		{
+			constexpr int entry_shift = 64 - 2 - quarter_wave_bits;					// bits below a table entry
+			constexpr unsigned long long entry_mask = ~((1ULL << entry_shift) - 1);
+
+			// round to the nearest table entry, so the offset is signed and as small as possible
+			const unsigned long long entry = (bam.value + (1ULL << (entry_shift - 1))) & entry_mask;
+			const auto quadrant = static_cast<unsigned int>(entry >> 62);
+			const auto index = static_cast<std::size_t>((entry >> entry_shift) & (quarter_wave_intervals - 1));
+
+			// the offset has at most 53 significant bits, so it converts to double exactly
+			const double offset = static_cast<double>(static_cast<long long>(bam.value - entry)) * radians_per_bam;
+			const double offset2 = offset * offset;
+
+			// sin(d) and cos(d) - 1
+			double sin_offset = offset;
+			double cos_offset_minus_1 = -0.5 * offset2;
+			if (accuracy == trig_accuracy::balanced)
+			{
+				sin_offset = offset * (1.0 - offset2 * (1.0 / 6.0));
+				cos_offset_minus_1 = offset2 * (-0.5 + offset2 * (1.0 / 24.0));
+			}
+			else if (accuracy == trig_accuracy::precise)
+			{
+				sin_offset = offset * (1.0 - offset2 * ((1.0 / 6.0) - offset2 * (1.0 / 120.0)));
+				cos_offset_minus_1 = offset2 * (-0.5 + offset2 * ((1.0 / 24.0) - offset2 * (1.0 / 720.0)));
+			}
+
+			// sine and cosine of the table entry, rotated into the right quadrant
+			const double entry_sin = quarter_wave_table[index];
+			const double entry_cos = quarter_wave_table[quarter_wave_intervals - index];
+
+			double sin_value = entry_sin;
+			double cos_value = entry_cos;
+			switch (quadrant)
+			{
+				case 1:		sin_value = entry_cos;		cos_value = -entry_sin;		break;
+				case 2:		sin_value = -entry_sin;		cos_value = -entry_cos;		break;
+				case 3:		sin_value = -entry_cos;		cos_value = entry_sin;		break;
+				default:	break;
+			}
+
+			// angle sum identities, arranged so the small corrections are added last
+			return sin_cos
+			{
+				.sin = sin_value + (sin_value * cos_offset_minus_1 + cos_value * sin_offset),
+				.cos = cos_value + (cos_value * cos_offset_minus_1 - sin_value * sin_offset)
+			};
+		}
+
+		// tan(pi / 8). when the smaller of |x| and |y| is above this fraction of the larger, atan2 is measured from 45 degrees.
+		inline constexpr double tan_eighth_pi = 0.41421356237309503;
+
+		// polynomial in t^2 for 2^64 / (2pi) * atan(t) / t, for |t| <= tan(pi / 8). multiplying by t gives atan(t) directly in
+		// bam units. it is a degree 10 chebyshev fit, so it is close to minimax, with an error of about 40 bam units.
+		inline constexpr double atan_bam_coefficients[] =
+		{
+			 2.935890503282001e+18,
+			-9.786301677605234e+17,
+			 5.871781006227876e+17,
+			-4.1941292596529824e+17,
+			 3.262099111615856e+17,
+			-2.668951433782174e+17,
+			 2.2576861440487526e+17,
+			-1.9494999735918618e+17,
+			 1.670037047434009e+17,
+			-1.2765405207896226e+17,
+			 6.205114133699292e+16
+		};
+
+		// 2^64 / (2pi) * atan(t), for |t| <= tan(pi / 8). the magnitude is less than 2^60.
+		inline constexpr double atan_bam_units(double t) noexcept
+		{
+			const double t2 = t * t;
+			double sum = atan_bam_coefficients[std::size(atan_bam_coefficients) - 1];
+			for (std::size_t i = std::size(atan_bam_coefficients) - 1; i-- > 0;)
+			{
+				sum = sum * t2 + atan_bam_coefficients[i];
+			}
+			return t * sum;
+		}
+
+	}	// namespace detail
+
+	// sine of a bam angle
+	[[nodiscard]] inline constexpr double sin(bam64 bam, trig_accuracy accuracy = trig_accuracy::precise) noexcept
+	{
+		return detail::table_sincos(bam, accuracy).sin;
+	}
+
+	// cosine of a bam angle
+	[[nodiscard]] inline constexpr double cos(bam64 bam, trig_accuracy accuracy = trig_accuracy::precise) noexcept
+	{
+		return detail::table_sincos(bam, accuracy).cos;
+	}
+
+	// sine and cosine of a bam angle, for about the cost of one of them
+	[[nodiscard]] inline constexpr sin_cos sincos(bam64 bam, trig_accuracy accuracy = trig_accuracy::precise) noexcept
+	{
+		return detail::table_sincos(bam, accuracy);
+	}
+
+	// batch version, for the first min(bams.size(), sines.size(), cosines.size()) values
+	inline constexpr void sincos(std::span<const bam64> bams, std::span<double> sines, std::span<double> cosines,
+								 trig_accuracy accuracy = trig_accuracy::precise) noexcept
+	{
+		std::size_t count = (bams.size() < sines.size()) ? bams.size() : sines.size();
+		count = (count < cosines.size()) ? count : cosines.size();
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const auto [sin_value, cos_value] = detail::table_sincos(bams[i], accuracy);
+			sines[i] = sin_value;
+			cosines[i] = cos_value;
+		}
+	}
+
+	// angle of the vector (x, y) from the positive x axis, like std::atan2(y, x), but as a bam64 without going through radians.
+	//
+	// the vector is reduced to the first octant, and then to within 22.5 degrees of 0 or 45 degrees. a polynomial gives the
+	// angle from there directly in bam units, so it is added to the octant's angle as an integer, and the result is more precise
+	// than a double could hold. the worst case error is under 0.25 pcs::epsilon, i.e. 512 bam units, which is about 1.7e-16
+	// radians. std::atan2() followed by bam64_from_radians() can be off by more than 1 pcs::epsilon.
+	//
+	// (0, 0) gives 0, and signed zeros are treated as positive. NaN, or both values infinite, also give 0. |x| + |y| must not
+	// overflow.
+	[[nodiscard]] inline constexpr bam64 bam64_atan2(double y, double x) noexcept
+	{
+		const double x_magnitude = detail::abs(x);
+		const double y_magnitude = detail::abs(y);
+
+		// first octant, and then measured from 45 degrees when closer to it
+		const bool swap = y_magnitude > x_magnitude;
+		const double low = swap ? x_magnitude : y_magnitude;
+		const double high = swap ? y_magnitude : x_magnitude;
+		const bool upper = low > high * detail::tan_eighth_pi;
+		const double t = upper ? (low - high) / (low + high) : low / high;
+
+		// 0 / 0 and infinity / infinity
+		if (t != t)
+			return bam64::from_bam_value(0);
+
+		// unfold back to the original octant with wrapping integer math
+		auto angle = static_cast<unsigned long long>(static_cast<long long>(detail::atan_bam_units(t)));
+		if (upper)		{ angle += pcs::eighth; }
+		if (swap)		{ angle = pcs::fourth - angle; }
+		if (x < 0)		{ angle = pcs::half - angle; }
+		if (y < 0)		{ angle = 0 - angle; }
+
+		return bam64::from_bam_value(angle);
+	}
+
+	// batch version, for the first min(ys.size(), xs.size(), bams.size()) values. see simd::atan2() for explicit simd kernels.
+	inline constexpr void bam64_atan2(std::span<const double> ys, std::span<const double> xs, std::span<bam64> bams) noexcept
+	{
+		std::size_t count = (ys.size() < xs.size()) ? ys.size() : xs.size();
+		count = (count < bams.size()) ? count : bams.size();
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			bams[i] = bam64_atan2(ys[i], xs[i]);
+		}
+	}
+
+}	// namespace pcs
+
+// closing include guard
+#endif
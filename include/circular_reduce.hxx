@@ -0,0 +1,156 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_CIRCULAR_REDUCE_HXX)
+#define PCS_CIRCULAR_REDUCE_HXX
+
+#include "bam64.hxx"
+#include "bam64_simd.hxx"
+#include "bam64_trig.hxx"
+#include "circular_stats.hxx"
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// circular statistics of large arrays of bam64, spread across threads.
+	//
+	// the samples are split into chunks of a fixed size, which doesn't depend on the number of threads. each chunk gets its
+	// sines and cosines from simd::sincos(), and sums them in a fixed order into its own slot. threads take chunks as they
+	// finish others, and once every chunk is done, the chunk sums are added in chunk order with dd_real. so the result only
+	// depends on the samples, and is the same bits for 1 thread or 64, and for any scheduling of the chunks.
+	//
+
+	namespace detail
+	{
+		// samples per chunk of work
+		inline constexpr std::size_t circular_chunk_size = std::size_t{1} << 14;
+
+		// sines and cosines are made this many at a time, into buffers on the stack
+		inline constexpr std::size_t circular_batch_size = 512;
+
+		// four interleaved sums, so the adds don't all wait on each other
+		inline circular_stats<> circular_chunk(std::span<const bam64> chunk, trig_accuracy accuracy, simd::instruction_set isa) noexcept
+		{
+			double sines[circular_batch_size];
+			double cosines[circular_batch_size];
+			double sin_sums[4] = {};
+			double cos_sums[4] = {};
+
+			for (std::size_t start = 0; start < chunk.size(); start += circular_batch_size)
+			{
+				const std::size_t count = (chunk.size() - start < circular_batch_size) ? (chunk.size() - start) : circular_batch_size;
+				simd::sincos(chunk.subspan(start, count), sines, cosines, accuracy, isa);
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					sin_sums[i & 3] += sines[i];
+					cos_sums[i & 3] += cosines[i];
+				}
+			}
+
+			return circular_stats<>
+			{
+				.count = chunk.size(),
+				.sin_sum = (sin_sums[0] + sin_sums[1]) + (sin_sums[2] + sin_sums[3]),
+				.cos_sum = (cos_sums[0] + cos_sums[1]) + (cos_sums[2] + cos_sums[3])
+			};
+		}
+
+	}	// namespace detail
+
+	// the statistics of all the samples. thread_count of zero uses std::thread::hardware_concurrency(), and no more threads are
+	// started than there are chunks. the calling thread does its share of the chunks.
+	[[nodiscard]] inline compensated_circular_stats circular_reduce(std::span<const bam64> samples, unsigned int thread_count = 0,
+																   trig_accuracy accuracy = trig_accuracy::precise,
+																   simd::instruction_set isa = simd::supported_instruction_set())
+	{
+		const std::size_t chunk_count = (samples.size() + detail::circular_chunk_size - 1) / detail::circular_chunk_size;
+		std::vector<circular_stats<>> partials(chunk_count);
+
+		std::atomic<std::size_t> next_chunk = 0;
+		auto work = [&]() noexcept
+		{
+			for (std::size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed); chunk < chunk_count;
+				 chunk = next_chunk.fetch_add(1, std::memory_order_relaxed))
+			{
+				const std::size_t start = chunk * detail::circular_chunk_size;
+				const std::size_t count = (samples.size() - start < detail::circular_chunk_size) ? (samples.size() - start) : detail::circular_chunk_size;
+				partials[chunk] = detail::circular_chunk(samples.subspan(start, count), accuracy, isa);
+			}
+		};
+
+		if (thread_count == 0)
+			thread_count = std::thread::hardware_concurrency();
+
+		const std::size_t worker_count = (thread_count < chunk_count) ? thread_count : chunk_count;
+		if (worker_count > 1)
+		{
+			// jthreads join when they go out of scope, even if something throws. a thread that can't be started isn't
+			// needed, since the threads that are running take whatever chunks are left.
+			std::vector<std::jthread> workers;
+			workers.reserve(worker_count - 1);
+			try
+			{
+				for (std::size_t i = 1; i < worker_count; ++i)
+					workers.emplace_back(work);
+			}
+			catch (const std::system_error &)
+			{
+			}
+
+			work();
+		}
+		else
+		{
+			work();
+		}
+
+		// chunk order, whichever thread did each one
+		compensated_circular_stats total;
+		for (const auto &partial : partials)
+		{
+			total.sin_sum = total.sin_sum + partial.sin_sum;
+			total.cos_sum = total.cos_sum + partial.cos_sum;
+			total.count += partial.count;
+		}
+
+		return total;
+	}
+
+	// mean direction of all the samples, or zero if there are none
+	[[nodiscard]] inline bam64 circular_mean(std::span<const bam64> samples, unsigned int thread_count = 0)
+	{
+		return circular_reduce(samples, thread_count).mean();
+	}
+
+	// mean resultant length R of all the samples
+	[[nodiscard]] inline double circular_resultant_length(std::span<const bam64> samples, unsigned int thread_count = 0)
+	{
+		return circular_reduce(samples, thread_count).resultant_length();
+	}
+
+	// 1 - R of all the samples
+	[[nodiscard]] inline double circular_variance(std::span<const bam64> samples, unsigned int thread_count = 0)
+	{
+		return circular_reduce(samples, thread_count).circular_variance();
+	}
+
+}	// namespace pcs
+
+// closing include guard
+#endif
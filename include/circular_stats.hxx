@@ -0,0 +1,188 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_CIRCULAR_STATS_HXX)
+#define PCS_CIRCULAR_STATS_HXX
+
+#include "bam64.hxx"
+#include "bam64_trig.hxx"
+#include "periodic.hxx"
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// statistics of directions, from the running sums of the sines and cosines of bam64 samples. the mean direction is the
+	// angle of the summed unit vectors, the mean resultant length R is the length of that sum divided by the count, and
+	// the circular variance is 1 - R. R is 1 when every sample is the same, and near 0 when they are spread evenly.
+	//
+	// with plain doubles, every add and remove can leave a rounding error in the sums, and over a very long stream, or a sliding
+	// window that has seen many more samples than it holds, those errors add up. with Compensated, the sums are dd_reals, which
+	// costs a few more adds per sample, but keeps the sums good to about 2^-104 of their size.
+	//
+
+	template <bool Compensated = false>
+	struct circular_stats
+	{
+		using sum_type = std::conditional_t<Compensated, cxcm::dd_real::dd_real, double>;
+
+		std::size_t count = 0;
+		sum_type sin_sum = sum_type(0.0);
+		sum_type cos_sum = sum_type(0.0);
+
+
+		// adding and removing samples
+
+		constexpr void add(sin_cos sample) noexcept
+		{
+			this->sin_sum = this->sin_sum + sample.sin;
+			this->cos_sum = this->cos_sum + sample.cos;
+			++this->count;
+		}
+
+		constexpr void add(bam64 sample, trig_accuracy accuracy = trig_accuracy::precise) noexcept
+		{
+			this->add(sincos(sample, accuracy));
+		}
+
+		constexpr void add(std::span<const bam64> samples, trig_accuracy accuracy = trig_accuracy::precise) noexcept
+		{
+			for (auto sample : samples)
+				this->add(sincos(sample, accuracy));
+		}
+
+		// removes a sample that was added before, with the same sine and cosine
+		constexpr void remove(sin_cos sample) noexcept
+		{
+			this->sin_sum = this->sin_sum + -sample.sin;
+			this->cos_sum = this->cos_sum + -sample.cos;
+			--this->count;
+		}
+
+		constexpr void remove(bam64 sample, trig_accuracy accuracy = trig_accuracy::precise) noexcept
+		{
+			this->remove(sincos(sample, accuracy));
+		}
+
+		// combine with statistics of other samples, e.g., from another thread
+		constexpr void merge(const circular_stats &other) noexcept
+		{
+			this->sin_sum = this->sin_sum + other.sin_sum;
+			this->cos_sum = this->cos_sum + other.cos_sum;
+			this->count += other.count;
+		}
+
+		constexpr void clear() noexcept
+		{
+			*this = circular_stats{};
+		}
+
+
+		// statistics
+
+		[[nodiscard]] constexpr bool empty() const noexcept							{ return this->count == 0; }
+
+		// the mean direction. it is zero when there are no samples, or when they cancel out exactly.
+		[[nodiscard]] constexpr bam64 mean() const noexcept
+		{
+			return bam64_atan2(static_cast<double>(this->sin_sum), static_cast<double>(this->cos_sum));
+		}
+
+		// mean resultant length R, in [0, 1]. it is zero when there are no samples.
+		[[nodiscard]] constexpr double resultant_length() const noexcept
+		{
+			if (this->count == 0)
+				return 0.0;
+
+			const double s = static_cast<double>(this->sin_sum);
+			const double c = static_cast<double>(this->cos_sum);
+			return cxcm::sqrt(s * s + c * c) / static_cast<double>(this->count);
+		}
+
+		// 1 - R, in [0, 1]
+		[[nodiscard]] constexpr double circular_variance() const noexcept				{ return 1.0 - this->resultant_length(); }
+	};
+
+	using compensated_circular_stats = circular_stats<true>;
+
+	// circular_stats over the most recent window_size samples. the sine and cosine of each sample in the window are kept in a
+	// ring, so the oldest one is removed with two subtractions, and no trig.
+	template <bool Compensated = false>
+	struct sliding_circular_stats
+	{
+		private:
+
+			std::vector<sin_cos> ring;
+			std::size_t size;
+			std::size_t next = 0;
+			circular_stats<Compensated> current;
+
+		public:
+
+			explicit sliding_circular_stats(std::size_t window_size) : size(window_size)
+			{
+				if (window_size == 0)
+					throw std::invalid_argument("sliding_circular_stats: window_size must be positive");
+
+				ring.reserve(window_size);
+			}
+
+			[[nodiscard]] std::size_t window_size() const noexcept						{ return size; }
+
+			// add a sample, and once the window is full, remove the oldest one
+			void add(bam64 sample, trig_accuracy accuracy = trig_accuracy::precise) noexcept
+			{
+				const sin_cos values = sincos(sample, accuracy);
+				if (ring.size() < size)
+				{
+					ring.push_back(values);
+				}
+				else
+				{
+					current.remove(ring[next]);
+					ring[next] = values;
+					next = (next + 1 == ring.size()) ? 0 : (next + 1);
+				}
+
+				current.add(values);
+			}
+
+			void add(std::span<const bam64> samples, trig_accuracy accuracy = trig_accuracy::precise) noexcept
+			{
+				for (auto sample : samples)
+					add(sample, accuracy);
+			}
+
+			void clear() noexcept
+			{
+				ring.clear();
+				next = 0;
+				current.clear();
+			}
+
+			// the statistics of the samples in the window
+			[[nodiscard]] const circular_stats<Compensated> &stats() const noexcept		{ return current; }
+
+			[[nodiscard]] std::size_t count() const noexcept							{ return current.count; }
+			[[nodiscard]] bam64 mean() const noexcept									{ return current.mean(); }
+			[[nodiscard]] double resultant_length() const noexcept						{ return current.resultant_length(); }
+			[[nodiscard]] double circular_variance() const noexcept						{ return current.circular_variance(); }
+	};
+
+}	// namespace pcs
+
+// closing include guard
+#endif
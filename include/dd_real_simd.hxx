@@ -0,0 +1,618 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_DD_REAL_SIMD_HXX)
+#define PCS_DD_REAL_SIMD_HXX
+
+#include "bam64_simd.hxx"			// instruction sets, detection, and kernel selection
+#include "periodic.hxx"
+
+#include <span>
+#include <cstddef>
+#include <type_traits>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// explicit simd kernels for arrays of double-doubles, with the same runtime dispatch as bam64_simd.hxx. the arrays are
+	// stored as a structure of arrays, i.e., a span of the high parts and a span of the low parts, so a vector register
+	// holds the same part of 4 or 8 values.
+	//
+	// the kernels do the same operations in the same order as the cxcm::dd_real operators, so every result is
+	// bit-identical to the scalar code. when the compiler may use fma instructions (PCS_DD_REAL_FMA), two_prod() and
+	// multiply_add() use them in both the scalar code and the kernels. otherwise both split the inputs like Dekker, and the
+	// avx-512 kernels use the explicit rounding intrinsics so that nothing is fused behind our backs.
+	//
+	// sse4.2 would only have the same 2 lanes the compiler can already use for the scalar loops, so it uses the scalar kernels.
+	//
+
+	namespace cxcm::dd_real
+	{
+		// double-doubles as a structure of arrays. the functions use the first min(hi.size(), lo.size()) values.
+		template <typename T>
+		struct basic_dd_real_array
+		{
+			std::span<T> hi;
+			std::span<T> lo;
+
+			[[nodiscard]] constexpr std::size_t size() const noexcept
+			{
+				return (hi.size() < lo.size()) ? hi.size() : lo.size();
+			}
+
+			[[nodiscard]] constexpr dd_real operator [](std::size_t index) const noexcept
+			{
+				return dd_real(hi[index], lo[index]);
+			}
+
+			// writable arrays can be used as read-only arrays
+			constexpr operator basic_dd_real_array<const T>() const noexcept requires (!std::is_const_v<T>)
+			{
+				return basic_dd_real_array<const T>{ .hi = hi, .lo = lo };
+			}
+		};
+
+		using dd_real_array = basic_dd_real_array<double>;
+		using const_dd_real_array = basic_dd_real_array<const double>;
+
+	}	// namespace cxcm::dd_real
+
+	namespace simd
+	{
+		// the kernels work on raw pointers and a count. they are reached through the span functions at the end of this file.
+		struct dd_real_kernels
+		{
+			using dd_real = cxcm::dd_real::dd_real;
+
+			// sum() adds value i to accumulator i % sum_stripes, and then adds the accumulators together pairwise, so every kernel
+			// does the same additions in the same order. the independent accumulators also hide the latency of ieee_add().
+			static constexpr std::size_t sum_stripes = 32;
+
+			static void add_to_stripes(dd_real (&stripes)[sum_stripes], const double *his, const double *los, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ stripes[i % sum_stripes] = stripes[i % sum_stripes] + dd_real(his[i], los[i]); }
+			}
+
+			static dd_real combine_stripes(dd_real (&stripes)[sum_stripes]) noexcept
+			{
+				for (std::size_t width = sum_stripes / 2; width > 0; width /= 2)
+				{
+					for (std::size_t i = 0; i < width; ++i)		{ stripes[i] = stripes[i] + stripes[i + width]; }
+				}
+
+				return stripes[0];
+			}
+
+			//
+			// scalar - the cxcm::dd_real operators
+			//
+
+			static void add_scalar(const double *a_his, const double *a_los, const double *b_his, const double *b_los,
+								   double *his, double *los, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const dd_real result = dd_real(a_his[i], a_los[i]) + dd_real(b_his[i], b_los[i]);
+					his[i] = result.x[0];
+					los[i] = result.x[1];
+				}
+			}
+
+			static void subtract_scalar(const double *a_his, const double *a_los, const double *b_his, const double *b_los,
+										double *his, double *los, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const dd_real result = dd_real(a_his[i], a_los[i]) - dd_real(b_his[i], b_los[i]);
+					his[i] = result.x[0];
+					los[i] = result.x[1];
+				}
+			}
+
+			static void multiply_scalar(const double *a_his, const double *a_los, const double *b_his, const double *b_los,
+										double *his, double *los, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const dd_real result = dd_real(a_his[i], a_los[i]) * dd_real(b_his[i], b_los[i]);
+					his[i] = result.x[0];
+					los[i] = result.x[1];
+				}
+			}
+
+			static void divide_scalar(const double *a_his, const double *a_los, const double *b_his, const double *b_los,
+									  double *his, double *los, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const dd_real result = dd_real(a_his[i], a_los[i]) / dd_real(b_his[i], b_los[i]);
+					his[i] = result.x[0];
+					los[i] = result.x[1];
+				}
+			}
+
+			static dd_real sum_scalar(const double *his, const double *los, std::size_t count) noexcept
+			{
+				dd_real stripes[sum_stripes] = {};
+				add_to_stripes(stripes, his, los, count);
+				return combine_stripes(stripes);
+			}
+
+#if defined(PCS_SIMD_X86)
+
+			//
+			// avx2 - 4 lanes. without fma, these are plain multiplies and adds, since avx2 alone doesn't let the compiler fuse them.
+			//
+
+			// 4 double-doubles
+			struct dd_vector_avx2
+			{
+				__m256d hi;
+				__m256d lo;
+			};
+
+			PCS_SIMD_TARGET("avx2") static __m256d negate_avx2(__m256d a) noexcept
+			{
+				return _mm256_xor_pd(a, _mm256_set1_pd(-0.0));
+			}
+
+			// cxcm::dd_real::quick_two_sum()
+			PCS_SIMD_TARGET("avx2") static __m256d quick_two_sum_avx2(__m256d a, __m256d b, __m256d &error) noexcept
+			{
+				const __m256d s = _mm256_add_pd(a, b);
+				error = _mm256_sub_pd(b, _mm256_sub_pd(s, a));
+				return s;
+			}
+
+			// cxcm::dd_real::two_sum()
+			PCS_SIMD_TARGET("avx2") static __m256d two_sum_avx2(__m256d a, __m256d b, __m256d &error) noexcept
+			{
+				const __m256d s = _mm256_add_pd(a, b);
+				const __m256d v = _mm256_sub_pd(s, a);
+				error = _mm256_add_pd(_mm256_sub_pd(a, _mm256_sub_pd(s, v)), _mm256_sub_pd(b, v));
+				return s;
+			}
+
+			// cxcm::dd_real::two_prod()
+			PCS_SIMD_TARGET("avx2") static __m256d two_prod_avx2(__m256d a, __m256d b, __m256d &error) noexcept
+			{
+				const __m256d p = _mm256_mul_pd(a, b);
+
+#if defined(PCS_DD_REAL_FMA)
+				error = _mm256_fmsub_pd(a, b, p);
+#else
+				const __m256d splitter = _mm256_set1_pd(134217729.0);
+				const __m256d a_temp = _mm256_mul_pd(splitter, a);
+				const __m256d a_high = _mm256_sub_pd(a_temp, _mm256_sub_pd(a_temp, a));
+				const __m256d a_low = _mm256_sub_pd(a, a_high);
+				const __m256d b_temp = _mm256_mul_pd(splitter, b);
+				const __m256d b_high = _mm256_sub_pd(b_temp, _mm256_sub_pd(b_temp, b));
+				const __m256d b_low = _mm256_sub_pd(b, b_high);
+
+				error = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(a_high, b_high), p), _mm256_mul_pd(a_high, b_low));
+				error = _mm256_add_pd(error, _mm256_mul_pd(a_low, b_high));
+				error = _mm256_add_pd(error, _mm256_mul_pd(a_low, b_low));
+#endif
+
+				return p;
+			}
+
+			// cxcm::dd_real::multiply_add()
+			PCS_SIMD_TARGET("avx2") static __m256d multiply_add_avx2(__m256d a, __m256d b, __m256d c) noexcept
+			{
+#if defined(PCS_DD_REAL_FMA)
+				return _mm256_fmadd_pd(a, b, c);
+#else
+				return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+			}
+
+			// cxcm::dd_real::ieee_add()
+			PCS_SIMD_TARGET("avx2") static dd_vector_avx2 add_avx2(dd_vector_avx2 a, dd_vector_avx2 b) noexcept
+			{
+				__m256d s2;
+				__m256d t2;
+				__m256d s1 = two_sum_avx2(a.hi, b.hi, s2);
+				const __m256d t1 = two_sum_avx2(a.lo, b.lo, t2);
+				s2 = _mm256_add_pd(s2, t1);
+				s1 = quick_two_sum_avx2(s1, s2, s2);
+				s2 = _mm256_add_pd(s2, t2);
+				s1 = quick_two_sum_avx2(s1, s2, s2);
+				return { s1, s2 };
+			}
+
+			// cxcm::dd_real::ieee_subtract()
+			PCS_SIMD_TARGET("avx2") static dd_vector_avx2 subtract_avx2(dd_vector_avx2 a, dd_vector_avx2 b) noexcept
+			{
+				return add_avx2(a, { negate_avx2(b.hi), negate_avx2(b.lo) });
+			}
+
+			// double-double * double-double
+			PCS_SIMD_TARGET("avx2") static dd_vector_avx2 multiply_avx2(dd_vector_avx2 a, dd_vector_avx2 b) noexcept
+			{
+				__m256d p2;
+				__m256d p1 = two_prod_avx2(a.hi, b.hi, p2);
+				p2 = _mm256_add_pd(p2, multiply_add_avx2(a.hi, b.lo, _mm256_mul_pd(a.lo, b.hi)));
+				p1 = quick_two_sum_avx2(p1, p2, p2);
+				return { p1, p2 };
+			}
+
+			// double-double * double
+			PCS_SIMD_TARGET("avx2") static dd_vector_avx2 multiply_avx2(dd_vector_avx2 a, __m256d b) noexcept
+			{
+				__m256d p2;
+				__m256d p1 = two_prod_avx2(a.hi, b, p2);
+				p1 = quick_two_sum_avx2(p1, multiply_add_avx2(a.lo, b, p2), p2);
+				return { p1, p2 };
+			}
+
+			// cxcm::dd_real::accurate_div()
+			PCS_SIMD_TARGET("avx2") static dd_vector_avx2 divide_avx2(dd_vector_avx2 a, dd_vector_avx2 b) noexcept
+			{
+				__m256d q1 = _mm256_div_pd(a.hi, b.hi);
+				dd_vector_avx2 r = subtract_avx2(a, multiply_avx2(b, q1));
+
+				__m256d q2 = _mm256_div_pd(r.hi, b.hi);
+				r = subtract_avx2(r, multiply_avx2(b, q2));
+
+				const __m256d q3 = _mm256_div_pd(r.hi, b.hi);
+
+				q1 = quick_two_sum_avx2(q1, q2, q2);
+
+				__m256d s2;
+				__m256d s1 = two_sum_avx2(q1, q3, s2);
+				s1 = quick_two_sum_avx2(s1, _mm256_add_pd(s2, q2), s2);
+				return { s1, s2 };
+			}
+
+			// each element of a and b, e.g., binary_avx2<add_avx2, add_scalar>, with the scalar kernel for the tail
+			template <dd_vector_avx2 (*Operation)(dd_vector_avx2, dd_vector_avx2) noexcept, auto Scalar>
+			PCS_SIMD_TARGET("avx2") static void binary_avx2(const double *a_his, const double *a_los, const double *b_his, const double *b_los,
+															double *his, double *los, std::size_t count) noexcept
+			{
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const dd_vector_avx2 a{ _mm256_loadu_pd(a_his + i), _mm256_loadu_pd(a_los + i) };
+					const dd_vector_avx2 b{ _mm256_loadu_pd(b_his + i), _mm256_loadu_pd(b_los + i) };
+					const dd_vector_avx2 result = Operation(a, b);
+					_mm256_storeu_pd(his + i, result.hi);
+					_mm256_storeu_pd(los + i, result.lo);
+				}
+
+				Scalar(a_his + i, a_los + i, b_his + i, b_los + i, his + i, los + i, count - i);
+			}
+
+			PCS_SIMD_TARGET("avx2") static dd_real sum_avx2(const double *his, const double *los, std::size_t count) noexcept
+			{
+				// lane j of accumulator k is stripe 4 * k + j
+				constexpr std::size_t accumulator_count = sum_stripes / 4;
+				dd_vector_avx2 accumulators[accumulator_count];
+				for (auto &accumulator : accumulators)		{ accumulator = { _mm256_setzero_pd(), _mm256_setzero_pd() }; }
+
+				std::size_t i = 0;
+				for (; i + sum_stripes <= count; i += sum_stripes)
+				{
+					for (std::size_t k = 0; k < accumulator_count; ++k)
+						accumulators[k] = add_avx2(accumulators[k], { _mm256_loadu_pd(his + i + 4 * k), _mm256_loadu_pd(los + i + 4 * k) });
+				}
+
+				dd_real stripes[sum_stripes];
+				for (std::size_t k = 0; k < accumulator_count; ++k)
+				{
+					alignas(32) double hi[4];
+					alignas(32) double lo[4];
+					_mm256_store_pd(hi, accumulators[k].hi);
+					_mm256_store_pd(lo, accumulators[k].lo);
+					for (std::size_t j = 0; j < 4; ++j)		{ stripes[4 * k + j] = dd_real(hi[j], lo[j]); }
+				}
+
+				add_to_stripes(stripes, his + i, los + i, count - i);
+				return combine_stripes(stripes);
+			}
+
+			//
+			// avx-512 - 8 lanes. avx512f implies fma, so the explicit rounding versions keep the compiler from fusing anything
+			// that the scalar code doesn't fuse. the tails are masked instead of going through the scalar kernels, since the
+			// scalar code would be inlined here, where it could be fused.
+			//
+
+			static constexpr int rounding_avx512 = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+
+			// 8 double-doubles
+			struct dd_vector_avx512
+			{
+				__m512d hi;
+				__m512d lo;
+			};
+
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512d negate_avx512(__m512d a) noexcept
+			{
+				return _mm512_xor_pd(a, _mm512_set1_pd(-0.0));
+			}
+
+			// cxcm::dd_real::quick_two_sum()
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512d quick_two_sum_avx512(__m512d a, __m512d b, __m512d &error) noexcept
+			{
+				const __m512d s = _mm512_add_round_pd(a, b, rounding_avx512);
+				error = _mm512_sub_round_pd(b, _mm512_sub_round_pd(s, a, rounding_avx512), rounding_avx512);
+				return s;
+			}
+
+			// cxcm::dd_real::two_sum()
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512d two_sum_avx512(__m512d a, __m512d b, __m512d &error) noexcept
+			{
+				const __m512d s = _mm512_add_round_pd(a, b, rounding_avx512);
+				const __m512d v = _mm512_sub_round_pd(s, a, rounding_avx512);
+				error = _mm512_add_round_pd(_mm512_sub_round_pd(a, _mm512_sub_round_pd(s, v, rounding_avx512), rounding_avx512),
+											_mm512_sub_round_pd(b, v, rounding_avx512), rounding_avx512);
+				return s;
+			}
+
+			// cxcm::dd_real::two_prod()
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512d two_prod_avx512(__m512d a, __m512d b, __m512d &error) noexcept
+			{
+				const __m512d p = _mm512_mul_round_pd(a, b, rounding_avx512);
+
+#if defined(PCS_DD_REAL_FMA)
+				error = _mm512_fmsub_round_pd(a, b, p, rounding_avx512);
+#else
+				const __m512d splitter = _mm512_set1_pd(134217729.0);
+				const __m512d a_temp = _mm512_mul_round_pd(splitter, a, rounding_avx512);
+				const __m512d a_high = _mm512_sub_round_pd(a_temp, _mm512_sub_round_pd(a_temp, a, rounding_avx512), rounding_avx512);
+				const __m512d a_low = _mm512_sub_round_pd(a, a_high, rounding_avx512);
+				const __m512d b_temp = _mm512_mul_round_pd(splitter, b, rounding_avx512);
+				const __m512d b_high = _mm512_sub_round_pd(b_temp, _mm512_sub_round_pd(b_temp, b, rounding_avx512), rounding_avx512);
+				const __m512d b_low = _mm512_sub_round_pd(b, b_high, rounding_avx512);
+
+				error = _mm512_add_round_pd(_mm512_sub_round_pd(_mm512_mul_round_pd(a_high, b_high, rounding_avx512), p, rounding_avx512),
+											_mm512_mul_round_pd(a_high, b_low, rounding_avx512), rounding_avx512);
+				error = _mm512_add_round_pd(error, _mm512_mul_round_pd(a_low, b_high, rounding_avx512), rounding_avx512);
+				error = _mm512_add_round_pd(error, _mm512_mul_round_pd(a_low, b_low, rounding_avx512), rounding_avx512);
+#endif
+
+				return p;
+			}
+
+			// cxcm::dd_real::multiply_add()
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512d multiply_add_avx512(__m512d a, __m512d b, __m512d c) noexcept
+			{
+#if defined(PCS_DD_REAL_FMA)
+				return _mm512_fmadd_round_pd(a, b, c, rounding_avx512);
+#else
+				return _mm512_add_round_pd(_mm512_mul_round_pd(a, b, rounding_avx512), c, rounding_avx512);
+#endif
+			}
+
+			// cxcm::dd_real::ieee_add()
+			PCS_SIMD_TARGET("avx512f,avx512dq") static dd_vector_avx512 add_avx512(dd_vector_avx512 a, dd_vector_avx512 b) noexcept
+			{
+				__m512d s2;
+				__m512d t2;
+				__m512d s1 = two_sum_avx512(a.hi, b.hi, s2);
+				const __m512d t1 = two_sum_avx512(a.lo, b.lo, t2);
+				s2 = _mm512_add_round_pd(s2, t1, rounding_avx512);
+				s1 = quick_two_sum_avx512(s1, s2, s2);
+				s2 = _mm512_add_round_pd(s2, t2, rounding_avx512);
+				s1 = quick_two_sum_avx512(s1, s2, s2);
+				return { s1, s2 };
+			}
+
+			// cxcm::dd_real::ieee_subtract()
+			PCS_SIMD_TARGET("avx512f,avx512dq") static dd_vector_avx512 subtract_avx512(dd_vector_avx512 a, dd_vector_avx512 b) noexcept
+			{
+				return add_avx512(a, { negate_avx512(b.hi), negate_avx512(b.lo) });
+			}
+
+			// double-double * double-double
+			PCS_SIMD_TARGET("avx512f,avx512dq") static dd_vector_avx512 multiply_avx512(dd_vector_avx512 a, dd_vector_avx512 b) noexcept
+			{
+				__m512d p2;
+				__m512d p1 = two_prod_avx512(a.hi, b.hi, p2);
+				p2 = _mm512_add_round_pd(p2, multiply_add_avx512(a.hi, b.lo, _mm512_mul_round_pd(a.lo, b.hi, rounding_avx512)), rounding_avx512);
+				p1 = quick_two_sum_avx512(p1, p2, p2);
+				return { p1, p2 };
+			}
+
+			// double-double * double
+			PCS_SIMD_TARGET("avx512f,avx512dq") static dd_vector_avx512 multiply_avx512(dd_vector_avx512 a, __m512d b) noexcept
+			{
+				__m512d p2;
+				__m512d p1 = two_prod_avx512(a.hi, b, p2);
+				p1 = quick_two_sum_avx512(p1, multiply_add_avx512(a.lo, b, p2), p2);
+				return { p1, p2 };
+			}
+
+			// cxcm::dd_real::accurate_div()
+			PCS_SIMD_TARGET("avx512f,avx512dq") static dd_vector_avx512 divide_avx512(dd_vector_avx512 a, dd_vector_avx512 b) noexcept
+			{
+				__m512d q1 = _mm512_div_round_pd(a.hi, b.hi, rounding_avx512);
+				dd_vector_avx512 r = subtract_avx512(a, multiply_avx512(b, q1));
+
+				__m512d q2 = _mm512_div_round_pd(r.hi, b.hi, rounding_avx512);
+				r = subtract_avx512(r, multiply_avx512(b, q2));
+
+				const __m512d q3 = _mm512_div_round_pd(r.hi, b.hi, rounding_avx512);
+
+				q1 = quick_two_sum_avx512(q1, q2, q2);
+
+				__m512d s2;
+				__m512d s1 = two_sum_avx512(q1, q3, s2);
+				s1 = quick_two_sum_avx512(s1, _mm512_add_round_pd(s2, q2, rounding_avx512), s2);
+				return { s1, s2 };
+			}
+
+			// each element of a and b, e.g., binary_avx512<add_avx512>
+			template <dd_vector_avx512 (*Operation)(dd_vector_avx512, dd_vector_avx512) noexcept>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void binary_avx512(const double *a_his, const double *a_los, const double *b_his, const double *b_los,
+																		  double *his, double *los, std::size_t count) noexcept
+			{
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const dd_vector_avx512 a{ _mm512_loadu_pd(a_his + i), _mm512_loadu_pd(a_los + i) };
+					const dd_vector_avx512 b{ _mm512_loadu_pd(b_his + i), _mm512_loadu_pd(b_los + i) };
+					const dd_vector_avx512 result = Operation(a, b);
+					_mm512_storeu_pd(his + i, result.hi);
+					_mm512_storeu_pd(los + i, result.lo);
+				}
+
+				if (i < count)
+				{
+					const __mmask8 tail = static_cast<__mmask8>((1u << (count - i)) - 1);
+					const dd_vector_avx512 a{ _mm512_maskz_loadu_pd(tail, a_his + i), _mm512_maskz_loadu_pd(tail, a_los + i) };
+					const dd_vector_avx512 b{ _mm512_maskz_loadu_pd(tail, b_his + i), _mm512_maskz_loadu_pd(tail, b_los + i) };
+					const dd_vector_avx512 result = Operation(a, b);
+					_mm512_mask_storeu_pd(his + i, tail, result.hi);
+					_mm512_mask_storeu_pd(los + i, tail, result.lo);
+				}
+			}
+
+			PCS_SIMD_TARGET("avx512f,avx512dq") static dd_real sum_avx512(const double *his, const double *los, std::size_t count) noexcept
+			{
+				// lane j of accumulator k is stripe 8 * k + j
+				constexpr std::size_t accumulator_count = sum_stripes / 8;
+				dd_vector_avx512 accumulators[accumulator_count];
+				for (auto &accumulator : accumulators)		{ accumulator = { _mm512_setzero_pd(), _mm512_setzero_pd() }; }
+
+				std::size_t i = 0;
+				for (; i + sum_stripes <= count; i += sum_stripes)
+				{
+					for (std::size_t k = 0; k < accumulator_count; ++k)
+						accumulators[k] = add_avx512(accumulators[k], { _mm512_loadu_pd(his + i + 8 * k), _mm512_loadu_pd(los + i + 8 * k) });
+				}
+
+				// the tail only adds, which can't be fused
+				dd_real stripes[sum_stripes];
+				for (std::size_t k = 0; k < accumulator_count; ++k)
+				{
+					alignas(64) double hi[8];
+					alignas(64) double lo[8];
+					_mm512_store_pd(hi, accumulators[k].hi);
+					_mm512_store_pd(lo, accumulators[k].lo);
+					for (std::size_t j = 0; j < 8; ++j)		{ stripes[8 * k + j] = dd_real(hi[j], lo[j]); }
+				}
+
+				add_to_stripes(stripes, his + i, los + i, count - i);
+				return combine_stripes(stripes);
+			}
+
+#endif
+
+			//
+			// dispatch
+			//
+
+			using binary_kernel = void (*)(const double *, const double *, const double *, const double *, double *, double *, std::size_t) noexcept;
+			using sum_kernel = dd_real (*)(const double *, const double *, std::size_t) noexcept;
+
+			static binary_kernel select_add(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return kernels::select<binary_kernel>(isa, add_scalar, add_scalar, binary_avx2<add_avx2, add_scalar>, binary_avx512<add_avx512>);
+#else
+				return kernels::select<binary_kernel>(isa, add_scalar, add_scalar, add_scalar, add_scalar);
+#endif
+			}
+
+			static binary_kernel select_subtract(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return kernels::select<binary_kernel>(isa, subtract_scalar, subtract_scalar, binary_avx2<subtract_avx2, subtract_scalar>, binary_avx512<subtract_avx512>);
+#else
+				return kernels::select<binary_kernel>(isa, subtract_scalar, subtract_scalar, subtract_scalar, subtract_scalar);
+#endif
+			}
+
+			static binary_kernel select_multiply(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return kernels::select<binary_kernel>(isa, multiply_scalar, multiply_scalar, binary_avx2<multiply_avx2, multiply_scalar>, binary_avx512<multiply_avx512>);
+#else
+				return kernels::select<binary_kernel>(isa, multiply_scalar, multiply_scalar, multiply_scalar, multiply_scalar);
+#endif
+			}
+
+			static binary_kernel select_divide(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return kernels::select<binary_kernel>(isa, divide_scalar, divide_scalar, binary_avx2<divide_avx2, divide_scalar>, binary_avx512<divide_avx512>);
+#else
+				return kernels::select<binary_kernel>(isa, divide_scalar, divide_scalar, divide_scalar, divide_scalar);
+#endif
+			}
+
+			static sum_kernel select_sum(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return kernels::select<sum_kernel>(isa, sum_scalar, sum_scalar, sum_avx2, sum_avx512);
+#else
+				return kernels::select<sum_kernel>(isa, sum_scalar, sum_scalar, sum_scalar, sum_scalar);
+#endif
+			}
+
+			// the first min(a.size(), b.size(), results.size()). results can be a or b.
+			static void apply(binary_kernel kernel, cxcm::dd_real::const_dd_real_array a, cxcm::dd_real::const_dd_real_array b,
+							  cxcm::dd_real::dd_real_array results) noexcept
+			{
+				std::size_t count = (a.size() < b.size()) ? a.size() : b.size();
+				count = (count < results.size()) ? count : results.size();
+				kernel(a.hi.data(), a.lo.data(), b.hi.data(), b.lo.data(), results.hi.data(), results.lo.data(), count);
+			}
+		};
+
+	}	// namespace simd
+
+	namespace cxcm::dd_real
+	{
+		//
+		// element-wise arithmetic on double-double arrays, with the same results as the operators. each works on the first
+		// min(a.size(), b.size(), results.size()) values, and results can be a or b. the instruction set defaults to the best
+		// one supported.
+		//
+
+		// results[i] = a[i] + b[i], with ieee_add()
+		inline void add(const_dd_real_array a, const_dd_real_array b, dd_real_array results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::dd_real_kernels::apply(simd::dd_real_kernels::select_add(isa), a, b, results);
+		}
+
+		// results[i] = a[i] - b[i], with ieee_subtract()
+		inline void subtract(const_dd_real_array a, const_dd_real_array b, dd_real_array results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::dd_real_kernels::apply(simd::dd_real_kernels::select_subtract(isa), a, b, results);
+		}
+
+		// results[i] = a[i] * b[i]
+		inline void multiply(const_dd_real_array a, const_dd_real_array b, dd_real_array results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::dd_real_kernels::apply(simd::dd_real_kernels::select_multiply(isa), a, b, results);
+		}
+
+		// results[i] = a[i] / b[i], with accurate_div()
+		inline void divide(const_dd_real_array a, const_dd_real_array b, dd_real_array results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::dd_real_kernels::apply(simd::dd_real_kernels::select_divide(isa), a, b, results);
+		}
+
+		// the sum of all the values, added in 32 interleaved stripes that are then added pairwise. the order doesn't depend on
+		// the instruction set, so neither does the result, but it isn't the same as adding the values one after the other.
+		[[nodiscard]] inline dd_real sum(const_dd_real_array values, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			return simd::dd_real_kernels::select_sum(isa)(values.hi.data(), values.lo.data(), values.size());
+		}
+
+	}	// namespace cxcm::dd_real
+
+}	// namespace pcs
+
+// closing include guard
+#endif
@@ -0,0 +1,299 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_NCO_HXX)
+#define PCS_NCO_HXX
+
+#include "bam64.hxx"
+#include "bam64_simd.hxx"
+#include "bam64_trig.hxx"
+
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// a numerically controlled oscillator. the phase is a bam64, and every sample adds the phase increment, which is
+	// frequency / sample_rate of a turn, to it. the add wraps around at a full turn, so the phase never loses precision, and
+	// the only error is the rounding of the increment to the nearest bam, which is at most half a unit.
+	//
+	// the blocks are made with simd::ramp(), which gives each lane its own phase and adds the step times the lane count,
+	// e.g., 8 phases per add with avx-512, and the sines and cosines with simd::sincos(). blocks only use buffers on the stack,
+	// so nothing is allocated. changing the frequency between blocks keeps the phase continuous.
+	//
+
+	namespace detail
+	{
+		// phases are made this many at a time, into buffers on the stack
+		inline constexpr std::size_t nco_batch_size = 256;
+
+		// the nearest bam to numerator / denominator of a turn, ties to even. 2^64 * numerator / denominator is a 128-bit
+		// division, so it is exact. a zero denominator gives zero.
+		inline constexpr bam64 nco_ratio(unsigned long long numerator, unsigned long long denominator) noexcept
+		{
+			if (denominator == 0)	{ return { .value = 0 }; }
+
+			unsigned long long remainder = 0;
+			const unsigned long long quotient = udiv128(numerator % denominator, 0, denominator, remainder);
+
+			const unsigned long long rest = denominator - remainder;
+			const bool round_up = (remainder > rest) || ((remainder == rest) && ((quotient & 1) != 0));
+			return { .value = quotient + (round_up ? 1 : 0) };
+		}
+
+		// value = mantissa * 2^exponent, with an integral mantissa below 2^53. false for nan and infinity.
+		inline constexpr bool nco_split(double value, unsigned long long &mantissa, int &exponent) noexcept
+		{
+			const unsigned long long bits = std::bit_cast<unsigned long long>(value);
+			const int biased_exponent = static_cast<int>((bits >> 52) & 0x7ff);
+			if (biased_exponent == 0x7ff)
+				return false;
+
+			const bool is_normal = (biased_exponent != 0);
+			mantissa = (bits & 0x000fffffffffffff) | (is_normal ? 0x0010000000000000 : 0);
+			exponent = (is_normal ? biased_exponent : 1) - 1075;
+			return true;
+		}
+
+		// the nearest bam to numerator / denominator of a turn, ties to even, for any finite doubles. with the mantissas and
+		// exponents, the bam value is n * 2^shift / d, where shift = (numerator exponent) - (denominator exponent) + 64, and
+		// that is worked out with integers, so it is exact. a zero, nan, or infinite input gives zero.
+		inline constexpr bam64 nco_ratio(double numerator, double denominator) noexcept
+		{
+			unsigned long long n = 0;
+			unsigned long long d = 0;
+			int n_exponent = 0;
+			int d_exponent = 0;
+			if (!nco_split(numerator, n, n_exponent) || !nco_split(denominator, d, d_exponent) || (n == 0) || (d == 0))
+				return { .value = 0 };
+
+			const bool negative = ((numerator < 0.0) != (denominator < 0.0));
+			const int shift = n_exponent - d_exponent + 64;
+			unsigned long long quotient = 0;
+			bool round_up = false;
+
+			if (shift >= 0)
+			{
+				// the whole part of n / d is worth 2^shift units, which is nothing once shift reaches 64
+				const unsigned long long whole = (shift < 64) ? ((n / d) << shift) : 0;
+
+				// then the rest of n is multiplied by 2^shift, but only modulo d * 2^64 matters, which keeps it to 128 bits
+				unsigned long long rest = n % d;
+				int left = shift;
+				while (left > 64)
+				{
+					const int step = (left - 64 < 11) ? (left - 64) : 11;
+					rest = (rest << step) % d;
+					left -= step;
+				}
+
+				const unsigned long long high = (left == 0) ? 0 : (left == 64) ? rest : (rest >> (64 - left));
+				const unsigned long long low = (left == 64) ? 0 : (rest << left);
+				unsigned long long remainder = 0;
+				quotient = whole + udiv128(high, low, d, remainder);
+
+				const unsigned long long remaining = d - remainder;
+				round_up = (remainder > remaining) || ((remainder == remaining) && ((quotient & 1) != 0));
+			}
+			else if (shift > -54)
+			{
+				// n / (d * 2^-shift), where d * 2^-shift might not fit in 64 bits
+				const int right = -shift;
+				const unsigned long long whole = n / d;
+				const unsigned long long rest = n % d;
+				quotient = whole >> right;
+
+				// the fraction is (low bits of whole + rest / d) / 2^right, and rest / d < 1, so it is a half or more when the low
+				// bits are, and exactly a half only when rest is zero as well
+				const unsigned long long low_bits = whole & ((1ULL << right) - 1);
+				const unsigned long long half = 1ULL << (right - 1);
+				round_up = (low_bits > half) || ((low_bits == half) && ((rest != 0) || ((quotient & 1) != 0)));
+			}
+
+			// otherwise the bam value is below a half, so it rounds to zero
+
+			const unsigned long long magnitude = quotient + (round_up ? 1 : 0);
+			return { .value = negative ? (0 - magnitude) : magnitude };
+		}
+
+	}	// namespace detail
+
+	struct nco
+	{
+		private:
+
+			bam64 current = { .value = 0 };
+			bam64 step = { .value = 0 };
+			double rate = 1.0;
+
+			static void check_rates(double frequency, double sample_rate)
+			{
+				if (!(sample_rate > 0.0) || !std::isfinite(sample_rate))
+					throw std::invalid_argument("nco: the sample rate needs to be positive and finite");
+
+				if (!std::isfinite(frequency))
+					throw std::invalid_argument("nco: the frequency needs to be finite");
+			}
+
+		public:
+
+			//
+			// phase increments
+			//
+
+			// the nearest bam to frequency / sample_rate of a turn, ties to even. negative frequencies turn the other way. zero,
+			// nan, or infinite inputs give zero.
+			[[nodiscard]] static constexpr bam64 phase_increment(double frequency, double sample_rate) noexcept
+			{
+				return detail::nco_ratio(frequency, sample_rate);
+			}
+
+			// the same for integer rates, e.g. hertz. a sample rate that isn't positive gives zero.
+			template <std::integral Frequency, std::integral SampleRate>
+				requires (!std::same_as<Frequency, bool> && !std::same_as<SampleRate, bool>)
+			[[nodiscard]] static constexpr bam64 phase_increment(Frequency frequency, SampleRate sample_rate) noexcept
+			{
+				if (sample_rate <= 0)	{ return { .value = 0 }; }
+
+				const bool negative = (frequency < 0);
+				const unsigned long long magnitude = negative ? (0ULL - static_cast<unsigned long long>(frequency)) : static_cast<unsigned long long>(frequency);
+				const bam64 increment = detail::nco_ratio(magnitude, static_cast<unsigned long long>(sample_rate));
+				return negative ? -increment : increment;
+			}
+
+
+			//
+			// construction
+			//
+
+			// zero frequency and phase, with a sample rate of 1
+			constexpr nco() noexcept = default;
+
+			// an oscillator with an increment in turns per sample, where the sample rate is 1
+			explicit constexpr nco(bam64 increment, bam64 initial_phase = { .value = 0 }) noexcept
+				: current(initial_phase), step(increment)
+			{
+			}
+
+			// throws std::invalid_argument when the sample rate isn't positive and finite, or the frequency isn't finite
+			nco(double frequency, double sample_rate, bam64 initial_phase = { .value = 0 })
+				: current(initial_phase), step(phase_increment(frequency, sample_rate)), rate(sample_rate)
+			{
+				check_rates(frequency, sample_rate);
+			}
+
+			template <std::integral Frequency, std::integral SampleRate>
+				requires (!std::same_as<Frequency, bool> && !std::same_as<SampleRate, bool>)
+			nco(Frequency frequency, SampleRate sample_rate, bam64 initial_phase = { .value = 0 })
+				: current(initial_phase), step(phase_increment(frequency, sample_rate)), rate(static_cast<double>(sample_rate))
+			{
+				check_rates(0.0, rate);
+			}
+
+
+			//
+			// state
+			//
+
+			// the phase of the next sample
+			[[nodiscard]] constexpr bam64 phase() const noexcept									{ return current; }
+			[[nodiscard]] constexpr bam64 increment() const noexcept								{ return step; }
+			[[nodiscard]] constexpr double sample_rate() const noexcept							{ return rate; }
+
+			// the frequency the increment actually gives, in (-sample_rate / 2, sample_rate / 2]
+			[[nodiscard]] constexpr double frequency() const noexcept
+			{
+				const double turns = (step.value == pcs::half) ? 0.5 : static_cast<double>(static_cast<long long>(step.value)) * 0x1p-64;
+				return turns * rate;
+			}
+
+			constexpr void set_phase(bam64 phase) noexcept											{ current = phase; }
+			constexpr void set_increment(bam64 increment) noexcept									{ step = increment; }
+
+			// takes effect from the next sample, so the phase stays continuous
+			constexpr void set_frequency(double frequency) noexcept								{ step = phase_increment(frequency, rate); }
+
+			template <std::integral Frequency>
+				requires (!std::same_as<Frequency, bool>)
+			constexpr void set_frequency(Frequency frequency) noexcept
+			{
+				// only integral sample rates can use the integer version
+				if ((rate < 0x1p64) && (static_cast<double>(static_cast<unsigned long long>(rate)) == rate))
+					step = phase_increment(frequency, static_cast<unsigned long long>(rate));
+				else
+					step = phase_increment(static_cast<double>(frequency), rate);
+			}
+
+
+			//
+			// samples
+			//
+
+			// the phase of the next sample, then move on
+			constexpr bam64 next() noexcept
+			{
+				const bam64 phase = current;
+				current = current + step;
+				return phase;
+			}
+
+			// skip ahead, exactly
+			constexpr void advance(unsigned long long samples) noexcept							{ current = current + step * samples; }
+
+			// the phases of the next output.size() samples
+			void phases(std::span<bam64> output, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+			{
+				simd::ramp(current, step, output, isa);
+				advance(output.size());
+			}
+
+			// the sines and cosines of the next min(sines.size(), cosines.size()) samples
+			void sincos(std::span<double> sines, std::span<double> cosines, trig_accuracy accuracy = trig_accuracy::precise,
+						simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+			{
+				const std::size_t count = (sines.size() < cosines.size()) ? sines.size() : cosines.size();
+				bam64 batch[detail::nco_batch_size];
+
+				for (std::size_t start = 0; start < count; start += detail::nco_batch_size)
+				{
+					const std::size_t size = (count - start < detail::nco_batch_size) ? (count - start) : detail::nco_batch_size;
+					phases(std::span<bam64>(batch, size), isa);
+					simd::sincos(std::span<const bam64>(batch, size), sines.subspan(start, size), cosines.subspan(start, size), accuracy, isa);
+				}
+			}
+
+			// cos + i sin of the next output.size() samples
+			void phasors(std::span<std::complex<double>> output, trig_accuracy accuracy = trig_accuracy::precise,
+						 simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+			{
+				double sines[detail::nco_batch_size];
+				double cosines[detail::nco_batch_size];
+
+				for (std::size_t start = 0; start < output.size(); start += detail::nco_batch_size)
+				{
+					const std::size_t size = (output.size() - start < detail::nco_batch_size) ? (output.size() - start) : detail::nco_batch_size;
+					sincos(std::span<double>(sines, size), std::span<double>(cosines, size), accuracy, isa);
+					for (std::size_t i = 0; i < size; ++i)
+						output[start + i] = { cosines[i], sines[i] };
+				}
+			}
+	};
+
+}	// namespace pcs
+
+// closing include guard
+#endif
@@ -17,8 +17,22 @@
 #include <limits>					// for cxcm
 #include <cmath>					// for cxcm
 #include <bit>						// bit_cast
+#include <span>						// batch conversions
+#include <cstddef>					// size_t
 #include <stdexcept>
 
+// dd_real uses fma instructions for exact products when the compiler is allowed to generate them, e.g., -mfma, -march=haswell,
+// or /arch:AVX2. everything built with the same flags gets the same dd_real results, scalar or simd, constexpr or runtime.
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+	#define PCS_DD_REAL_FMA
+#endif
+
+// the static converters take their parameters as double template parameters, which needs P1907, e.g., gcc 11, clang 18,
+// or msvc 19.28. without it they are left out, and the rest of the header still works.
+#if defined(__cpp_nontype_template_args) && (__cpp_nontype_template_args >= 201911L)
+	#define PCS_STATIC_CONVERTERS
+#endif
+
 //
 // periodic coordinate system
 //
@@ -119,7 +133,8 @@ namespace pcs
 				low = a - high;
 			}
 
-			// The following code computes fl(a x b) and error(a x b).
+			// The following code computes fl(a x b) and error(a x b). when the compiler is allowed to use fma instructions, the
+			// runtime version uses one for the error, which is exact, instead of splitting the inputs.
 			constexpr double two_prod(double a, double b, double &error) noexcept
 			{
 				double a_high = 0.0;
@@ -128,12 +143,57 @@ namespace pcs
 				double b_low = 0.0;
 
 				double p = a * b;
+
+#if defined(PCS_DD_REAL_FMA)
+				if (!std::is_constant_evaluated())
+				{
+					error = std::fma(a, b, -p);
+					return p;
+				}
+#endif
+
 				split(a, a_high, a_low);
 				split(b, b_high, b_low);
 				error = ((a_high * b_high - p) + a_high * b_low + a_low * b_high) + a_low * b_low;
 				return p;
 			}
 
+			// a + b rounded to odd, i.e., when the sum isn't exact, the neighbor of the exact sum with an odd last significand bit.
+			constexpr double odd_sum(double a, double b) noexcept
+			{
+				double error = 0.0;
+				double s = two_sum(a, b, error);
+
+				auto bits = std::bit_cast<unsigned long long>(s);
+				if ((error != 0.0) && ((bits & 1ull) == 0ull))
+					bits = ((error > 0.0) == (s > 0.0)) ? bits + 1ull : bits - 1ull;
+
+				return std::bit_cast<double>(bits);
+			}
+
+			// a * b + c, fused the same way as two_prod(). writing the fma out means the results don't depend on which of the
+			// multiplies and adds the compiler would have fused on its own, so the simd kernels can match them exactly. std::fma()
+			// isn't constexpr, so constant evaluation gets the same correctly rounded result from the exact product and sum, with
+			// the low parts rounded to odd (Boldo and Melquiond). that holds away from overflow and underflow, like two_prod().
+			constexpr double multiply_add(double a, double b, double c) noexcept
+			{
+#if defined(PCS_DD_REAL_FMA)
+				if (!std::is_constant_evaluated())
+					return std::fma(a, b, c);
+
+				double product_low = 0.0;
+				double product_high = two_prod(a, b, product_low);
+				if ((product_high == 0.0) || (product_high - product_high != 0.0) || (c - c != 0.0))
+					return product_high + c;
+
+				double sum_low = 0.0;
+				double sum_high = two_sum(c, product_high, sum_low);
+				return sum_high + odd_sum(sum_low, product_low);
+#else
+				return a * b + c;
+#endif
+			}
+
 			// higher precision double-double
 			struct dd_real
 			{
@@ -273,7 +333,7 @@ namespace pcs
 				double p2 = 0.0;
 
 				p1 = two_prod(a.x[0], b.x[0], p2);
-				p2 += (a.x[0] * b.x[1] + a.x[1] * b.x[0]);
+				p2 += multiply_add(a.x[0], b.x[1], a.x[1] * b.x[0]);
 				p1 = quick_two_sum(p1, p2, p2);
 				return dd_real(p1, p2);
 			}
@@ -285,7 +345,7 @@ namespace pcs
 				double p2 = 0.0;
 
 				p1 = two_prod(a.x[0], b, p2);
-				p1 = quick_two_sum(p1, p2 + (a.x[1] * b), p2);
+				p1 = quick_two_sum(p1, multiply_add(a.x[1], b, p2), p2);
 				return dd_real(p1, p2);
 			}
 
@@ -301,7 +361,7 @@ namespace pcs
 				double p2 = 0.0;
 
 				p1 = two_prod(a.x[0], b.x[0], p2);
-				p2 += (a.x[0] * b.x[1] + a.x[1] * b.x[0]);
+				p2 += multiply_add(a.x[0], b.x[1], a.x[1] * b.x[0]);
 				a.x[0] = quick_two_sum(p1, p2, a.x[1]);
 				return a;
 			}
@@ -1002,6 +1062,19 @@ namespace pcs
 					return !isnormal_or_subnormal(value) || (relaxed::abs(value) > limits::largest_fractional_value<T>);
 				}
 
+				//
+				// with_input_sign()
+				//
+
+				// the relaxed functions lose the sign of a zero result, but the standard ones keep the sign of the input,
+				// e.g., ceil(-0.5) is -0. non-zero results already have the right sign.
+
+				template <cxcm::concepts::basic_floating_point T>
+				constexpr T with_input_sign(T value, T result) noexcept
+				{
+					return ((result == T(0)) && (value < T(0))) ? negative_zero<T> : result;
+				}
+
 				//
 				// constexpr_trunc()
 				//
@@ -1020,7 +1093,7 @@ namespace pcs
 					if (fails_fractional_input_constraints(value))
 						return value;
 
-					return relaxed::trunc(value);
+					return with_input_sign(value, relaxed::trunc(value));
 				}
 
 				//
@@ -1062,7 +1135,7 @@ namespace pcs
 					if (fails_fractional_input_constraints(value))
 						return value;
 
-					return relaxed::ceil(value);
+					return with_input_sign(value, relaxed::ceil(value));
 				}
 
 				//
@@ -1091,7 +1164,11 @@ namespace pcs
 					else if (value == -limits::largest_fractional_value<T>)			// we technically don't have to do this for negative case (one more number in negative range)
 						return value - T(0.5f);
 
-					return relaxed::round(value);
+					// the largest value below 0.5 plus 0.5 rounds up to 1, so it can't go through relaxed::round()
+					if (relaxed::abs(value) < T(0.5f))
+						return with_input_sign(value, T(0));
+
+					return with_input_sign(value, relaxed::round(value));
 				}
 
 				//
@@ -1163,7 +1240,11 @@ namespace pcs
 					else if (value == -limits::largest_fractional_value<T>)			// we technically don't have to do this for negative case (one more number in negative range)
 						return value - T(0.5f);
 
-					return relaxed::round_even(value);
+					// the largest value below 0.5 plus 0.5 rounds up to 1, so it can't go through relaxed::round_even()
+					if (relaxed::abs(value) < T(0.5f))
+						return with_input_sign(value, T(0));
+
+					return with_input_sign(value, relaxed::round_even(value));
 				}
 
 				//
@@ -1592,34 +1673,172 @@ namespace pcs
 	//template <std::floating_point T>
 	//constexpr inline T tau = T(2 * std::numbers::pi_v<T>);
 
-	// input_value is value to convert
-	// input period is period of input-related values
-	// input_origin is the origin of the input pcs in output pcs coords, so therefore in output_period
-	// output_min is the min value of output range, where range => [output_min, output_min + output_period)
-	// output_period is the period of output-related values, and is a scale factor on the output
-	constexpr double forward_convert(double input_value, double input_period, double input_origin, double output_min, double output_period) noexcept
+	namespace detail
 	{
-		// normalize parameters to period == 1
-		const double norm_input = (input_value / input_period) + (input_origin / output_period);
-		const double norm_minimum_output = output_min / output_period;
+		// input_value is value to convert
+		// input period is period of input-related values
+		// input_origin is the origin of the input pcs in output pcs coords, so therefore in output_period
+		// output_min is the min value of output range, where range => [output_min, output_min + output_period)
+		// output_period is the period of output-related values, and is a scale factor on the output
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr T basic_forward_convert(T input_value, T input_period, T input_origin, T output_min, T output_period) noexcept
+		{
+			// normalize parameters to period == 1
+			const T norm_input = (input_value / input_period) + (input_origin / output_period);
+			const T norm_minimum_output = output_min / output_period;
+
+			// scale output by output_period
+			return output_period * (norm_input - cxcm::floor(norm_input - norm_minimum_output));
+		}
+
+		// input_value is value to convert
+		// input period is period of input-related values
+		// input_origin is the origin of the input pcs in output pcs coords, so therefore in output_period
+		// output_min is the min value of output range, where range => [output_min, output_min + output_period)
+		// output_period is the period of output-related values, and is a scale factor on the output
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr T basic_reverse_convert(T input_value, T input_period, T input_origin, T output_min, T output_period) noexcept
+		{
+			// normalize parameters to period == 1
+			const T norm_input = (input_value / input_period) - (input_origin / output_period);
+			const T norm_minimum_output = output_min / output_period;
+
+			// scale output by output_period
+			return output_period * (cxcm::ceil(norm_input + norm_minimum_output) - norm_input);
+		}
+
+	}	// namespace detail
 
-		// scale output by output_period
-		return output_period * (norm_input - cxcm::floor(norm_input - norm_minimum_output));
+	// the conversions are done in double, and any other arithmetic arguments are converted to double. they are only done in
+	// float when every argument is a float, so forward_convert(1.5f, 360.0, ...) is still done in double.
+	constexpr double forward_convert(double input_value, double input_period, double input_origin, double output_min, double output_period) noexcept
+	{
+		return detail::basic_forward_convert(input_value, input_period, input_origin, output_min, output_period);
 	}
 
-	// input_value is value to convert
-	// input period is period of input-related values
-	// input_origin is the origin of the input pcs in output pcs coords, so therefore in output_period
-	// output_min is the min value of output range, where range => [output_min, output_min + output_period)
-	// output_period is the period of output-related values, and is a scale factor on the output
 	constexpr double reverse_convert(double input_value, double input_period, double input_origin, double output_min, double output_period) noexcept
 	{
-		// normalize parameters to period == 1
-		const double norm_input = (input_value / input_period) - (input_origin / output_period);
-		const double norm_minimum_output = output_min / output_period;
+		return detail::basic_reverse_convert(input_value, input_period, input_origin, output_min, output_period);
+	}
+
+	// all float. these are templates so they only match exact floats, and mixed arguments go to the double versions.
+	constexpr float forward_convert(std::same_as<float> auto input_value, std::same_as<float> auto input_period, std::same_as<float> auto input_origin,
+									std::same_as<float> auto output_min, std::same_as<float> auto output_period) noexcept
+	{
+		return detail::basic_forward_convert(input_value, input_period, input_origin, output_min, output_period);
+	}
 
-		// scale output by output_period
-		return output_period * (cxcm::ceil(norm_input + norm_minimum_output) - norm_input);
+	constexpr float reverse_convert(std::same_as<float> auto input_value, std::same_as<float> auto input_period, std::same_as<float> auto input_origin,
+									std::same_as<float> auto output_min, std::same_as<float> auto output_period) noexcept
+	{
+		return detail::basic_reverse_convert(input_value, input_period, input_origin, output_min, output_period);
+	}
+
+	namespace detail
+	{
+		// 1 / period when it is exact, i.e., when period is a power of two, and zero otherwise. multiplying by an exact
+		// reciprocal rounds the same as dividing, so it gives identical results.
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr T exact_reciprocal(T period) noexcept
+		{
+			if constexpr (sizeof(T) == 4)
+			{
+				const unsigned int bits = std::bit_cast<unsigned int>(period);
+				const int biased_exponent = static_cast<int>((bits >> 23) & 0xff);
+				const bool power_of_two = ((bits & 0x007fffff) == 0) && (biased_exponent != 0) && (biased_exponent != 0xff);
+				return power_of_two ? (T(1) / period) : T(0);
+			}
+			else
+			{
+				const unsigned long long bits = std::bit_cast<unsigned long long>(period);
+				const int biased_exponent = static_cast<int>((bits >> 52) & 0x7ff);
+				const bool power_of_two = ((bits & 0x000fffffffffffff) == 0) && (biased_exponent != 0) && (biased_exponent != 0x7ff);
+				return power_of_two ? (T(1) / period) : T(0);
+			}
+		}
+
+		// the parts of forward_convert() and reverse_convert() that don't depend on the input value
+		template <cxcm::concepts::basic_floating_point T = double>
+		struct convert_constants
+		{
+			T input_period;
+			T input_reciprocal;			// zero when it isn't exact, and input_period is used for dividing instead
+			T origin;					// input_origin / output_period
+			T minimum;					// output_min / output_period
+			T output_period;
+		};
+
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr convert_constants<T> make_convert_constants(T input_period, std::type_identity_t<T> input_origin,
+															  std::type_identity_t<T> output_min, std::type_identity_t<T> output_period) noexcept
+		{
+			return convert_constants<T>
+			{
+				.input_period = input_period,
+				.input_reciprocal = exact_reciprocal(input_period),
+				.origin = input_origin / output_period,
+				.minimum = output_min / output_period,
+				.output_period = output_period
+			};
+		}
+
+		// input_value / input_period
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr T scale_input(T input_value, const convert_constants<T> &constants) noexcept
+		{
+			return (constants.input_reciprocal != T(0)) ? (input_value * constants.input_reciprocal) : (input_value / constants.input_period);
+		}
+
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr void batch_forward_convert(std::span<const T> input_values, std::span<T> output_values, const convert_constants<T> &constants) noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const T norm_input = scale_input(input_values[i], constants) + constants.origin;
+				output_values[i] = constants.output_period * (norm_input - cxcm::floor(norm_input - constants.minimum));
+			}
+		}
+
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr void batch_reverse_convert(std::span<const T> input_values, std::span<T> output_values, const convert_constants<T> &constants) noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const T norm_input = scale_input(input_values[i], constants) - constants.origin;
+				output_values[i] = constants.output_period * (cxcm::ceil(norm_input + constants.minimum) - norm_input);
+			}
+		}
+
+	}	// namespace detail
+
+	// batch versions of forward_convert() and reverse_convert(), for the first min(input_values.size(), output_values.size())
+	// values. the divisions that don't depend on the input are done once, and so is the reciprocal of input_period when it is
+	// exact, so the results are identical to the scalar functions. see simd::forward_convert() and simd::reverse_convert()
+	// for explicit simd kernels.
+	constexpr void forward_convert(std::span<const double> input_values, std::span<double> output_values,
+								   double input_period, double input_origin, double output_min, double output_period) noexcept
+	{
+		detail::batch_forward_convert(input_values, output_values, detail::make_convert_constants(input_period, input_origin, output_min, output_period));
+	}
+
+	constexpr void forward_convert(std::span<const float> input_values, std::span<float> output_values,
+								   float input_period, float input_origin, float output_min, float output_period) noexcept
+	{
+		detail::batch_forward_convert(input_values, output_values, detail::make_convert_constants(input_period, input_origin, output_min, output_period));
+	}
+
+	constexpr void reverse_convert(std::span<const double> input_values, std::span<double> output_values,
+								   double input_period, double input_origin, double output_min, double output_period) noexcept
+	{
+		detail::batch_reverse_convert(input_values, output_values, detail::make_convert_constants(input_period, input_origin, output_min, output_period));
+	}
+
+	constexpr void reverse_convert(std::span<const float> input_values, std::span<float> output_values,
+								   float input_period, float input_origin, float output_min, float output_period) noexcept
+	{
+		detail::batch_reverse_convert(input_values, output_values, detail::make_convert_constants(input_period, input_origin, output_min, output_period));
 	}
 
 	// there are so many parameters depending on the input and output situations.
@@ -1628,59 +1847,397 @@ namespace pcs
 	// the forward or reverse period conversion on the input value.
 
 	// normal forward conversion
-	struct forward_period_converter
+	template <cxcm::concepts::basic_floating_point T = double>
+	struct basic_forward_period_converter
 	{
-		double input_period = 1.0;	// the period of the input values
-		double output_period = 1.0;	// the period of the output values
-		double input_origin = 0.0;	// the input origin in output_period units (i.e., in output pcs coords)
-		double output_min = 0.0;	// the minimum of the output range, in output_period units
+		T input_period = T(1);		// the period of the input values
+		T output_period = T(1);		// the period of the output values
+		T input_origin = T(0);		// the input origin in output_period units (i.e., in output pcs coords)
+		T output_min = T(0);		// the minimum of the output range, in output_period units
 
-		// 
-		constexpr double operator()(double input_value) const noexcept
+		//
+		constexpr T operator()(T input_value) const noexcept
 		{
 			return forward(input_value);
 		}
 
-		// 
-		[[nodiscard]] constexpr double forward(double input_value) const noexcept
+		//
+		[[nodiscard]] constexpr T forward(T input_value) const noexcept
+		{
+			return detail::basic_forward_convert(input_value, input_period, input_origin, output_min, output_period);
+		}
+
+		//
+		[[nodiscard]] constexpr T reverse(T input_value) const noexcept
+		{
+			return detail::basic_reverse_convert(input_value, input_period, input_origin, output_min, output_period);
+		}
+		// batch versions
+		constexpr void forward(std::span<const T> input_values, std::span<T> output_values) const noexcept
 		{
-			return forward_convert(input_value, input_period, input_origin, output_min, output_period);
+			forward_convert(input_values, output_values, input_period, input_origin, output_min, output_period);
 		}
 
-		// 
-		[[nodiscard]] constexpr double reverse(double input_value) const noexcept
+		constexpr void reverse(std::span<const T> input_values, std::span<T> output_values) const noexcept
 		{
-			return reverse_convert(input_value, input_period, input_origin, output_min, output_period);
+			reverse_convert(input_values, output_values, input_period, input_origin, output_min, output_period);
 		}
 	};
 
 	// normal reverse conversion
-	struct reverse_period_converter
+	template <cxcm::concepts::basic_floating_point T = double>
+	struct basic_reverse_period_converter
+	{
+		T input_period = T(1);		// the period of the input values
+		T output_period = T(1);		// the period of the output values
+		T input_origin = T(0);		// the input origin in output_period units (i.e., in output pcs coords)
+		T output_min = T(0);		// the minimum of the output range, in output_period units
+
+		//
+		constexpr T operator()(T input_value) const noexcept
+		{
+			return forward(input_value);
+		}
+
+		//
+		[[nodiscard]] constexpr T forward(T input_value) const noexcept
+		{
+			return detail::basic_reverse_convert(input_value, input_period, input_origin, output_min, output_period);
+		}
+
+		//
+		[[nodiscard]] constexpr T reverse(T input_value) const noexcept
+		{
+			return detail::basic_forward_convert(input_value, input_period, input_origin, output_min, output_period);
+		}
+		// batch versions
+		constexpr void forward(std::span<const T> input_values, std::span<T> output_values) const noexcept
+		{
+			reverse_convert(input_values, output_values, input_period, input_origin, output_min, output_period);
+		}
+
+		constexpr void reverse(std::span<const T> input_values, std::span<T> output_values) const noexcept
+		{
+			forward_convert(input_values, output_values, input_period, input_origin, output_min, output_period);
+		}
+	};
+
+	using forward_period_converter = basic_forward_period_converter<double>;
+	using reverse_period_converter = basic_reverse_period_converter<double>;
+
+	// compiled conversions fold the four parameters into two constants when they are constructed, so each conversion is a
+	// multiply-add, a floor (or ceil), and another multiply-add, with no divisions. forward_convert() computes
+	//
+	//		n = input_value / input_period + input_origin / output_period
+	//		output_period * (n - floor(n - output_min / output_period))
+	//
+	// and with t = n - output_min / output_period, that is output_period * (t - floor(t)) + output_min, where
+	// t = input_value * (1 / input_period) + (input_origin - output_min) / output_period. reverse_convert() is the same with
+	// ceil(t) - t, and with the offset subtracted.
+	//
+	// the reciprocal and the folded offset each round once, where the current path rounds its two quotients, so t is within
+	// about 1 ulp of the current path's n - output_min / output_period. the outputs then agree to within output_period times
+	// that, i.e., a couple of ulps of the largest of |input_value / input_period|, |input_origin / output_period|, and
+	// |output_min / output_period| + 1. right at the boundary of the output range, one path can wrap where the other doesn't,
+	// and then they differ by output_period.
+	namespace detail
+	{
+		template <cxcm::concepts::basic_floating_point T = double>
+		struct compiled_convert_constants
+		{
+			T scale = T(1);				// 1 / input_period
+			T offset = T(0);			// (input_origin - output_min) / output_period
+			T output_period = T(1);
+			T output_min = T(0);
+		};
+
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr compiled_convert_constants<T> compile_convert(T input_period, T input_origin, T output_min, T output_period) noexcept
+		{
+			return compiled_convert_constants<T>
+			{
+				.scale = T(1) / input_period,
+				.offset = (input_origin - output_min) / output_period,
+				.output_period = output_period,
+				.output_min = output_min
+			};
+		}
+
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr T compiled_forward(std::type_identity_t<T> input_value, const compiled_convert_constants<T> &constants) noexcept
+		{
+			const T t = input_value * constants.scale + constants.offset;
+			return constants.output_period * (t - cxcm::floor(t)) + constants.output_min;
+		}
+
+		template <cxcm::concepts::basic_floating_point T>
+		constexpr T compiled_reverse(std::type_identity_t<T> input_value, const compiled_convert_constants<T> &constants) noexcept
+		{
+			const T t = input_value * constants.scale - constants.offset;
+			return constants.output_period * (cxcm::ceil(t) - t) + constants.output_min;
+		}
+
+	}	// namespace detail
+
+	// basic_forward_period_converter, compiled
+	template <cxcm::concepts::basic_floating_point T = double>
+	struct basic_compiled_forward_converter
+	{
+		detail::compiled_convert_constants<T> constants;
+
+		constexpr basic_compiled_forward_converter() noexcept = default;
+
+		explicit constexpr basic_compiled_forward_converter(const basic_forward_period_converter<T> &converter) noexcept
+			: constants(detail::compile_convert(converter.input_period, converter.input_origin, converter.output_min, converter.output_period))
+		{
+		}
+
+		//
+		constexpr T operator()(T input_value) const noexcept
+		{
+			return forward(input_value);
+		}
+
+		//
+		[[nodiscard]] constexpr T forward(T input_value) const noexcept
+		{
+			return detail::compiled_forward(input_value, constants);
+		}
+
+		//
+		[[nodiscard]] constexpr T reverse(T input_value) const noexcept
+		{
+			return detail::compiled_reverse(input_value, constants);
+		}
+
+		// batch versions, for the first min(input_values.size(), output_values.size()) values
+		constexpr void forward(std::span<const T> input_values, std::span<T> output_values) const noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+				output_values[i] = detail::compiled_forward(input_values[i], constants);
+		}
+
+		constexpr void reverse(std::span<const T> input_values, std::span<T> output_values) const noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+				output_values[i] = detail::compiled_reverse(input_values[i], constants);
+		}
+	};
+
+	// basic_reverse_period_converter, compiled
+	template <cxcm::concepts::basic_floating_point T = double>
+	struct basic_compiled_reverse_converter
 	{
-		double input_period = 1.0;	// the period of the input values
-		double output_period = 1.0;	// the period of the output values
-		double input_origin = 0.0;	// the input origin in output_period units (i.e., in output pcs coords)
-		double output_min = 0.0;	// the minimum of the output range, in output_period units
+		detail::compiled_convert_constants<T> constants;
+
+		constexpr basic_compiled_reverse_converter() noexcept = default;
+
+		explicit constexpr basic_compiled_reverse_converter(const basic_reverse_period_converter<T> &converter) noexcept
+			: constants(detail::compile_convert(converter.input_period, converter.input_origin, converter.output_min, converter.output_period))
+		{
+		}
 
-		// 
-		constexpr double operator()(double input_value) const noexcept
+		//
+		constexpr T operator()(T input_value) const noexcept
 		{
 			return forward(input_value);
 		}
 
-		// 
-		[[nodiscard]] constexpr double forward(double input_value) const noexcept
+		//
+		[[nodiscard]] constexpr T forward(T input_value) const noexcept
+		{
+			return detail::compiled_reverse(input_value, constants);
+		}
+
+		//
+		[[nodiscard]] constexpr T reverse(T input_value) const noexcept
+		{
+			return detail::compiled_forward(input_value, constants);
+		}
+
+		// batch versions, for the first min(input_values.size(), output_values.size()) values
+		constexpr void forward(std::span<const T> input_values, std::span<T> output_values) const noexcept
 		{
-			return reverse_convert(input_value, input_period, input_origin, output_min, output_period);
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+				output_values[i] = detail::compiled_reverse(input_values[i], constants);
 		}
 
-		// 
-		[[nodiscard]] constexpr double reverse(double input_value) const noexcept
+		constexpr void reverse(std::span<const T> input_values, std::span<T> output_values) const noexcept
 		{
-			return forward_convert(input_value, input_period, input_origin, output_min, output_period);
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+				output_values[i] = detail::compiled_forward(input_values[i], constants);
 		}
 	};
 
+	using compiled_forward_converter = basic_compiled_forward_converter<double>;
+	using compiled_reverse_converter = basic_compiled_reverse_converter<double>;
+
+#if defined(PCS_STATIC_CONVERTERS)
+
+	// converters with the periods, origin, and minimum fixed at compile time. the divisions that don't depend on the input
+	// are constant folded, dividing by a power of two input period is a multiply by its exact reciprocal, and periods of 1.0
+	// skip the divide or multiply entirely. each of these gives the same answer as the general operation, so the results are
+	// identical to forward_convert() and reverse_convert(). the parameters are always doubles, and they are converted to T
+	// before anything is done with them.
+	namespace detail
+	{
+		template <double InputPeriod, cxcm::concepts::basic_floating_point T>
+		constexpr T static_scale_input(T input_value) noexcept
+		{
+			constexpr T period = static_cast<T>(InputPeriod);
+			constexpr T reciprocal = exact_reciprocal(period);
+
+			if constexpr (period == T(1))				{ return input_value; }
+			else if constexpr (reciprocal != T(0))		{ return input_value * reciprocal; }
+			else										{ return input_value / period; }
+		}
+
+		template <double OutputPeriod, cxcm::concepts::basic_floating_point T>
+		constexpr T static_scale_output(T normalized_value) noexcept
+		{
+			constexpr T period = static_cast<T>(OutputPeriod);
+
+			if constexpr (period == T(1))				{ return normalized_value; }
+			else										{ return period * normalized_value; }
+		}
+
+		template <double InputPeriod, double OutputPeriod, double InputOrigin, double OutputMin, cxcm::concepts::basic_floating_point T>
+		constexpr T static_forward_convert(T input_value) noexcept
+		{
+			constexpr T origin = static_cast<T>(InputOrigin) / static_cast<T>(OutputPeriod);
+			constexpr T minimum = static_cast<T>(OutputMin) / static_cast<T>(OutputPeriod);
+
+			const T norm_input = static_scale_input<InputPeriod>(input_value) + origin;
+			return static_scale_output<OutputPeriod>(norm_input - cxcm::floor(norm_input - minimum));
+		}
+
+		template <double InputPeriod, double OutputPeriod, double InputOrigin, double OutputMin, cxcm::concepts::basic_floating_point T>
+		constexpr T static_reverse_convert(T input_value) noexcept
+		{
+			constexpr T origin = static_cast<T>(InputOrigin) / static_cast<T>(OutputPeriod);
+			constexpr T minimum = static_cast<T>(OutputMin) / static_cast<T>(OutputPeriod);
+
+			const T norm_input = static_scale_input<InputPeriod>(input_value) - origin;
+			return static_scale_output<OutputPeriod>(cxcm::ceil(norm_input + minimum) - norm_input);
+		}
+
+	}	// namespace detail
+
+	// forward_period_converter, with its members as template parameters
+	template <double InputPeriod = 1.0, double OutputPeriod = 1.0, double InputOrigin = 0.0, double OutputMin = 0.0, cxcm::concepts::basic_floating_point T = double>
+		requires (InputPeriod != 0.0) && (OutputPeriod != 0.0)
+	struct static_forward_converter
+	{
+		static constexpr T input_period = static_cast<T>(InputPeriod);		// the period of the input values
+		static constexpr T output_period = static_cast<T>(OutputPeriod);	// the period of the output values
+		static constexpr T input_origin = static_cast<T>(InputOrigin);		// the input origin in output_period units (i.e., in output pcs coords)
+		static constexpr T output_min = static_cast<T>(OutputMin);			// the minimum of the output range, in output_period units
+
+		//
+		constexpr T operator()(T input_value) const noexcept
+		{
+			return forward(input_value);
+		}
+
+		//
+		[[nodiscard]] constexpr T forward(T input_value) const noexcept
+		{
+			return detail::static_forward_convert<InputPeriod, OutputPeriod, InputOrigin, OutputMin>(input_value);
+		}
+
+		//
+		[[nodiscard]] constexpr T reverse(T input_value) const noexcept
+		{
+			return detail::static_reverse_convert<InputPeriod, OutputPeriod, InputOrigin, OutputMin>(input_value);
+		}
+
+		// batch versions, for the first min(input_values.size(), output_values.size()) values
+		constexpr void forward(std::span<const T> input_values, std::span<T> output_values) const noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+				output_values[i] = forward(input_values[i]);
+		}
+
+		constexpr void reverse(std::span<const T> input_values, std::span<T> output_values) const noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+				output_values[i] = reverse(input_values[i]);
+		}
+	};
+
+	// reverse_period_converter, with its members as template parameters
+	template <double InputPeriod = 1.0, double OutputPeriod = 1.0, double InputOrigin = 0.0, double OutputMin = 0.0, cxcm::concepts::basic_floating_point T = double>
+		requires (InputPeriod != 0.0) && (OutputPeriod != 0.0)
+	struct static_reverse_converter
+	{
+		static constexpr T input_period = static_cast<T>(InputPeriod);		// the period of the input values
+		static constexpr T output_period = static_cast<T>(OutputPeriod);	// the period of the output values
+		static constexpr T input_origin = static_cast<T>(InputOrigin);		// the input origin in output_period units (i.e., in output pcs coords)
+		static constexpr T output_min = static_cast<T>(OutputMin);			// the minimum of the output range, in output_period units
+
+		//
+		constexpr T operator()(T input_value) const noexcept
+		{
+			return forward(input_value);
+		}
+
+		//
+		[[nodiscard]] constexpr T forward(T input_value) const noexcept
+		{
+			return detail::static_reverse_convert<InputPeriod, OutputPeriod, InputOrigin, OutputMin>(input_value);
+		}
+
+		//
+		[[nodiscard]] constexpr T reverse(T input_value) const noexcept
+		{
+			return detail::static_forward_convert<InputPeriod, OutputPeriod, InputOrigin, OutputMin>(input_value);
+		}
+
+		// batch versions, for the first min(input_values.size(), output_values.size()) values
+		constexpr void forward(std::span<const T> input_values, std::span<T> output_values) const noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+				output_values[i] = forward(input_values[i]);
+		}
+
+		constexpr void reverse(std::span<const T> input_values, std::span<T> output_values) const noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			for (std::size_t i = 0; i < count; ++i)
+				output_values[i] = reverse(input_values[i]);
+		}
+	};
+
+#endif
+
+	// anything that converts like forward_period_converter, so the runtime, compiled, and static converters can be used
+	// interchangeably. T is the floating point type it converts.
+	template <typename C, typename T = double>
+	concept period_converter = requires (const C &converter, T input_value, std::span<const T> input_values, std::span<T> output_values)
+	{
+		{ converter(input_value) } -> std::convertible_to<T>;
+		{ converter.forward(input_value) } -> std::convertible_to<T>;
+		{ converter.reverse(input_value) } -> std::convertible_to<T>;
+		converter.forward(input_values, output_values);
+		converter.reverse(input_values, output_values);
+	};
+
+	static_assert(period_converter<forward_period_converter> && period_converter<reverse_period_converter>);
+	static_assert(period_converter<compiled_forward_converter> && period_converter<compiled_reverse_converter>);
+	static_assert(period_converter<basic_forward_period_converter<float>, float> && period_converter<basic_compiled_reverse_converter<float>, float>);
+
+#if defined(PCS_STATIC_CONVERTERS)
+	static_assert(period_converter<static_forward_converter<>> && period_converter<static_reverse_converter<>>);
+	static_assert(period_converter<static_forward_converter<360.0, 1.0, 90.0, 0.0, float>, float>);
+#endif
+
 }	// namespace pcs
 
 
@@ -0,0 +1,324 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_PERIODIC_FRAME_GRAPH_HXX)
+#define PCS_PERIODIC_FRAME_GRAPH_HXX
+
+#include "bam64.hxx"
+#include "periodic.hxx"
+#include "periodic_transform.hxx"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// a tree of periodic coordinate systems (frames), e.g., math angles at the root, with bearing, vehicle-relative, and
+	// sensor frames below it. each frame is defined against its parent with an orientation theta, +1 or -1, and an origin,
+	// which is where the frame's zero is in the parent's coordinates. as in the README, a value x in the frame is
+	//
+	//		theta * x + origin
+	//
+	// in the parent, in turns. applying that up the tree collapses to a single theta and offset from each frame to the root,
+	// and going from one frame to another is the first one's transform followed by the inverse of the second one's, which is
+	// also a single theta and offset. the transforms are periodic_transforms, with bam64 offsets, so composing them wraps exactly.
+	//
+	// a query for (from, to) returns a frame_converter that does the whole conversion, including the periods of both frames and
+	// the output range of the destination, in one step, with the same accuracy as the compiled converters, including their
+	// behavior right at the boundary of the output range. composed converters are cached in a flat hash map, so once a pair has
+	// been asked for, asking again is a hash and a probe, without any allocation. the cache is not thread-safe for writing, so
+	// concurrent readers should warm() the pairs they need first, and then use find().
+	//
+
+	// identifies a frame in a periodic_frame_graph
+	using frame_id = std::uint32_t;
+
+	// the conversion between two frames, as one orientation and the folded constants of a compiled converter
+	struct frame_converter
+	{
+		int orientation = 1;							// +1 or -1
+		detail::compiled_convert_constants<double> constants;
+
+		//
+		constexpr double operator()(double input_value) const noexcept
+		{
+			return forward(input_value);
+		}
+
+		// from the source frame to the destination frame
+		[[nodiscard]] constexpr double forward(double input_value) const noexcept
+		{
+			return (orientation > 0) ? detail::compiled_forward(input_value, constants) : detail::compiled_reverse(input_value, constants);
+		}
+
+		// the same, but with the opposite orientation, like reverse() of the other converters
+		[[nodiscard]] constexpr double reverse(double input_value) const noexcept
+		{
+			return (orientation > 0) ? detail::compiled_reverse(input_value, constants) : detail::compiled_forward(input_value, constants);
+		}
+
+		// batch versions, for the first min(input_values.size(), output_values.size()) values
+		constexpr void forward(std::span<const double> input_values, std::span<double> output_values) const noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			if (orientation > 0)
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ output_values[i] = detail::compiled_forward(input_values[i], constants); }
+			}
+			else
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ output_values[i] = detail::compiled_reverse(input_values[i], constants); }
+			}
+		}
+
+		constexpr void reverse(std::span<const double> input_values, std::span<double> output_values) const noexcept
+		{
+			const frame_converter opposite{ .orientation = -orientation, .constants = constants };
+			opposite.forward(input_values, output_values);
+		}
+	};
+
+	static_assert(period_converter<frame_converter>);
+
+	struct periodic_frame_graph
+	{
+		private:
+
+			struct frame
+			{
+				frame_id parent;
+				double period;
+				double output_min;			// the start of the output range, when converting to this frame
+				periodic_transform local;		// to the parent
+				periodic_transform to_root;		// all the way to the root
+			};
+
+			// open addressing with linear probing. the key packs (from, to) into 64 bits, and a key with both ids set to the
+			// maximum marks an empty slot, which no real pair can be.
+			struct cache_slot
+			{
+				unsigned long long key;
+				frame_converter converter;
+			};
+
+			static constexpr unsigned long long empty_key = ~0ULL;
+
+			std::vector<frame> frames;
+			std::vector<cache_slot> cache;
+			std::size_t cache_count = 0;
+			int cache_shift = 64;			// 64 - log2(cache.size())
+
+			static constexpr unsigned long long cache_key(frame_id from, frame_id to) noexcept
+			{
+				return (static_cast<unsigned long long>(from) << 32) | to;
+			}
+
+			// fibonacci hashing, using the top bits of the product
+			std::size_t cache_index(unsigned long long key) const noexcept
+			{
+				return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15) >> cache_shift);
+			}
+
+			// from -> root -> to
+			periodic_transform compose(frame_id from, frame_id to) const noexcept
+			{
+				return frames[to].to_root.inverse() * frames[from].to_root;
+			}
+
+			void check(frame_id id) const
+			{
+				if (id >= frames.size())
+					throw std::out_of_range("periodic_frame_graph: unknown frame");
+			}
+
+			frame_converter make_converter(frame_id from, frame_id to) const noexcept
+			{
+				const frame &destination = frames[to];
+				const periodic_transform composed = compose(from, to);
+
+				return frame_converter
+				{
+					.orientation = composed.orientation,
+					.constants = detail::compiled_convert_constants<double>
+					{
+						.scale = 1.0 / composed.input_period,
+						.offset = composed.offset.fraction() - destination.output_min / destination.period,
+						.output_period = destination.period,
+						.output_min = destination.output_min
+					}
+				};
+			}
+
+			void grow_cache()
+			{
+				std::vector<cache_slot> old_cache(cache.size() ? (2 * cache.size()) : 64, cache_slot{ .key = empty_key, .converter = {} });
+				old_cache.swap(cache);
+				cache_shift = 64 - std::countr_zero(cache.size());
+				cache_count = 0;
+
+				for (const auto &slot : old_cache)
+				{
+					if (slot.key != empty_key)
+						insert(slot.key, slot.converter);
+				}
+			}
+
+			void insert(unsigned long long key, const frame_converter &converter) noexcept
+			{
+				std::size_t index = cache_index(key);
+				while (cache[index].key != empty_key)
+					index = (index + 1) & (cache.size() - 1);
+
+				cache[index] = cache_slot{ .key = key, .converter = converter };
+				++cache_count;
+			}
+
+		public:
+
+			// the root frame has id 0. its period and output range are for converting to it.
+			explicit periodic_frame_graph(double root_period = 1.0, double root_output_min = 0.0)
+			{
+				if (root_period == 0.0)
+					throw std::invalid_argument("periodic_frame_graph: period must be non-zero");
+
+				frames.push_back(frame
+				{
+					.parent = 0,
+					.period = root_period,
+					.output_min = root_output_min,
+					.local = identity_transform(root_period),
+					.to_root = identity_transform(root_period)
+				});
+			}
+
+			// the root frame
+			[[nodiscard]] static constexpr frame_id root() noexcept		{ return 0; }
+
+			// number of frames, including the root
+			[[nodiscard]] std::size_t size() const noexcept				{ return frames.size(); }
+
+			// add a frame below parent. orientation is +1 when it is the same as the parent's, and -1 when it is opposite.
+			// origin is where the new frame's zero is, in the parent's coordinates and period. period and output_min describe
+			// values in the new frame, where output_min is the start of the range [output_min, output_min + period) that
+			// conversions to it produce.
+			frame_id add_frame(frame_id parent, int orientation, double origin, double period, double output_min = 0.0)
+			{
+				check(parent);
+				if ((orientation != 1) && (orientation != -1))
+					throw std::invalid_argument("periodic_frame_graph: orientation must be +1 or -1");
+				if (period == 0.0)
+					throw std::invalid_argument("periodic_frame_graph: period must be non-zero");
+
+				const periodic_transform local = periodic_transform::from_origin(orientation, origin, period, frames[parent].period);
+				frames.push_back(frame
+				{
+					.parent = parent,
+					.period = period,
+					.output_min = output_min,
+					.local = local,
+					.to_root = frames[parent].to_root * local
+				});
+
+				return static_cast<frame_id>(frames.size() - 1);
+			}
+
+			// move a frame's origin, e.g., for a vehicle-relative frame as the vehicle turns. the frame and everything below it are
+			// updated, and the cache is cleared without releasing its memory.
+			void set_origin(frame_id id, double origin)
+			{
+				check(id);
+				if (id == root())
+					throw std::invalid_argument("periodic_frame_graph: the root has no origin");
+
+				frames[id].local = periodic_transform::from_origin(frames[id].local.orientation, origin, frames[id].period, frames[frames[id].parent].period);
+
+				// a parent always comes before its children, so one pass in order updates every descendant. frames that aren't
+				// below this one just get the same transform again.
+				for (std::size_t i = id; i < frames.size(); ++i)
+					frames[i].to_root = frames[frames[i].parent].to_root * frames[i].local;
+
+				clear_cache();
+			}
+
+			// the cached converter from one frame to another, or nullptr if it hasn't been asked for yet. this never allocates or
+			// writes, so it is safe to call from many threads once the pairs have been warmed.
+			[[nodiscard]] const frame_converter *find(frame_id from, frame_id to) const noexcept
+			{
+				if (cache.empty())
+					return nullptr;
+
+				const unsigned long long key = cache_key(from, to);
+				for (std::size_t index = cache_index(key); cache[index].key != empty_key; index = (index + 1) & (cache.size() - 1))
+				{
+					if (cache[index].key == key)
+						return &cache[index].converter;
+				}
+
+				return nullptr;
+			}
+
+			// the converter from one frame to another. the first time a pair is asked for, it is composed and cached.
+			[[nodiscard]] frame_converter converter(frame_id from, frame_id to)
+			{
+				if (const frame_converter *cached = find(from, to))
+					return *cached;
+
+				check(from);
+				check(to);
+
+				// keep the load factor at or below a half, so probes stay short
+				if (2 * (cache_count + 1) > cache.size())
+					grow_cache();
+
+				const frame_converter composed = make_converter(from, to);
+				insert(cache_key(from, to), composed);
+				return composed;
+			}
+
+			// compose and cache a pair ahead of time
+			void warm(frame_id from, frame_id to)
+			{
+				[[maybe_unused]] const auto composed = converter(from, to);
+			}
+
+			// the composed transform from one frame to another, e.g., for applying to stored bam64 values. this isn't cached.
+			[[nodiscard]] periodic_transform transform(frame_id from, frame_id to) const
+			{
+				check(from);
+				check(to);
+				return compose(from, to);
+			}
+
+			// convert a single value
+			[[nodiscard]] double convert(frame_id from, frame_id to, double value)
+			{
+				return converter(from, to)(value);
+			}
+
+			// forget every composed converter, but keep the memory
+			void clear_cache() noexcept
+			{
+				for (auto &slot : cache)
+					slot.key = empty_key;
+
+				cache_count = 0;
+			}
+	};
+
+}	// namespace pcs
+
+// closing include guard
+#endif
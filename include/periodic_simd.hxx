@@ -0,0 +1,803 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_PERIODIC_SIMD_HXX)
+#define PCS_PERIODIC_SIMD_HXX
+
+#include "bam64_simd.hxx"			// instruction sets, detection, and kernel selection
+#include "periodic.hxx"
+
+#include <span>
+#include <cstddef>
+#include <cmath>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// explicit simd kernels for forward_convert() and reverse_convert() over spans of double or float, with the same runtime
+	// dispatch as bam64_simd.hxx. the float kernels have twice as many lanes.
+	//
+	// the kernels do the same operations in the same order as the scalar functions, and floor() and ceil() are single
+	// rounding instructions, so every result is bit-identical. the reciprocal of input_period is only used when it is exact,
+	// and then the product is exact too, so it doesn't matter if the compiler fuses it with the add that follows.
+	//
+	// there are also span versions of cxcm::floor(), ceil(), trunc(), round(), round_even(), and fract() for float and
+	// double, done with the sse4.1/avx rounding instructions. they give the same bits as the scalar functions do at runtime,
+	// so NaN stays NaN, +/-0 and values too large to have a fractional part come back as they are, and -0.5 rounds up to -0.
+	// round_even() is the ieee round to nearest, ties to even, i.e., std::nearbyint() in the default rounding mode.
+	//
+
+	namespace simd
+	{
+		// the kernels work on raw pointers and a count. they are reached through the span functions at the end of this file.
+		struct convert_kernels
+		{
+			using constants = detail::convert_constants<double>;
+			using float_constants = detail::convert_constants<float>;
+
+			//
+			// scalar - the same loops as pcs::forward_convert() and pcs::reverse_convert()
+			//
+
+			static void forward_scalar(const double *input_values, double *output_values, std::size_t count, const constants &c) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const double norm_input = detail::scale_input(input_values[i], c) + c.origin;
+					output_values[i] = c.output_period * (norm_input - cxcm::floor(norm_input - c.minimum));
+				}
+			}
+
+			static void reverse_scalar(const double *input_values, double *output_values, std::size_t count, const constants &c) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const double norm_input = detail::scale_input(input_values[i], c) - c.origin;
+					output_values[i] = c.output_period * (cxcm::ceil(norm_input + c.minimum) - norm_input);
+				}
+			}
+
+			static void forward_scalar(const float *input_values, float *output_values, std::size_t count, const float_constants &c) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const float norm_input = detail::scale_input(input_values[i], c) + c.origin;
+					output_values[i] = c.output_period * (norm_input - cxcm::floor(norm_input - c.minimum));
+				}
+			}
+
+			static void reverse_scalar(const float *input_values, float *output_values, std::size_t count, const float_constants &c) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const float norm_input = detail::scale_input(input_values[i], c) - c.origin;
+					output_values[i] = c.output_period * (cxcm::ceil(norm_input + c.minimum) - norm_input);
+				}
+			}
+
+#if defined(PCS_SIMD_X86)
+
+			//
+			// sse4.2 - 2 lanes, with the sse4.1 roundpd
+			//
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("sse4.2") static void forward_sse42(const double *input_values, double *output_values, std::size_t count, const constants &c) noexcept
+			{
+				const __m128d scale = _mm_set1_pd(Multiply ? c.input_reciprocal : c.input_period);
+				const __m128d origin = _mm_set1_pd(c.origin);
+				const __m128d minimum = _mm_set1_pd(c.minimum);
+				const __m128d output_period = _mm_set1_pd(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					const __m128d values = _mm_loadu_pd(input_values + i);
+					const __m128d scaled = Multiply ? _mm_mul_pd(values, scale) : _mm_div_pd(values, scale);
+					const __m128d norm_input = _mm_add_pd(scaled, origin);
+					const __m128d whole = _mm_round_pd(_mm_sub_pd(norm_input, minimum), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					_mm_storeu_pd(output_values + i, _mm_mul_pd(output_period, _mm_sub_pd(norm_input, whole)));
+				}
+
+				forward_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("sse4.2") static void reverse_sse42(const double *input_values, double *output_values, std::size_t count, const constants &c) noexcept
+			{
+				const __m128d scale = _mm_set1_pd(Multiply ? c.input_reciprocal : c.input_period);
+				const __m128d origin = _mm_set1_pd(c.origin);
+				const __m128d minimum = _mm_set1_pd(c.minimum);
+				const __m128d output_period = _mm_set1_pd(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					const __m128d values = _mm_loadu_pd(input_values + i);
+					const __m128d scaled = Multiply ? _mm_mul_pd(values, scale) : _mm_div_pd(values, scale);
+					const __m128d norm_input = _mm_sub_pd(scaled, origin);
+					const __m128d whole = _mm_round_pd(_mm_add_pd(norm_input, minimum), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+					_mm_storeu_pd(output_values + i, _mm_mul_pd(output_period, _mm_sub_pd(whole, norm_input)));
+				}
+
+				reverse_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			//
+			// avx2 - 4 lanes
+			//
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("avx2") static void forward_avx2(const double *input_values, double *output_values, std::size_t count, const constants &c) noexcept
+			{
+				const __m256d scale = _mm256_set1_pd(Multiply ? c.input_reciprocal : c.input_period);
+				const __m256d origin = _mm256_set1_pd(c.origin);
+				const __m256d minimum = _mm256_set1_pd(c.minimum);
+				const __m256d output_period = _mm256_set1_pd(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256d values = _mm256_loadu_pd(input_values + i);
+					const __m256d scaled = Multiply ? _mm256_mul_pd(values, scale) : _mm256_div_pd(values, scale);
+					const __m256d norm_input = _mm256_add_pd(scaled, origin);
+					const __m256d whole = _mm256_round_pd(_mm256_sub_pd(norm_input, minimum), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					_mm256_storeu_pd(output_values + i, _mm256_mul_pd(output_period, _mm256_sub_pd(norm_input, whole)));
+				}
+
+				forward_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("avx2") static void reverse_avx2(const double *input_values, double *output_values, std::size_t count, const constants &c) noexcept
+			{
+				const __m256d scale = _mm256_set1_pd(Multiply ? c.input_reciprocal : c.input_period);
+				const __m256d origin = _mm256_set1_pd(c.origin);
+				const __m256d minimum = _mm256_set1_pd(c.minimum);
+				const __m256d output_period = _mm256_set1_pd(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256d values = _mm256_loadu_pd(input_values + i);
+					const __m256d scaled = Multiply ? _mm256_mul_pd(values, scale) : _mm256_div_pd(values, scale);
+					const __m256d norm_input = _mm256_sub_pd(scaled, origin);
+					const __m256d whole = _mm256_round_pd(_mm256_add_pd(norm_input, minimum), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+					_mm256_storeu_pd(output_values + i, _mm256_mul_pd(output_period, _mm256_sub_pd(whole, norm_input)));
+				}
+
+				reverse_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			//
+			// avx-512 - 8 lanes
+			//
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void forward_avx512(const double *input_values, double *output_values, std::size_t count, const constants &c) noexcept
+			{
+				const __m512d scale = _mm512_set1_pd(Multiply ? c.input_reciprocal : c.input_period);
+				const __m512d origin = _mm512_set1_pd(c.origin);
+				const __m512d minimum = _mm512_set1_pd(c.minimum);
+				const __m512d output_period = _mm512_set1_pd(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m512d values = _mm512_loadu_pd(input_values + i);
+					const __m512d scaled = Multiply ? _mm512_mul_pd(values, scale) : _mm512_div_pd(values, scale);
+					const __m512d norm_input = _mm512_add_pd(scaled, origin);
+					const __m512d whole = _mm512_roundscale_pd(_mm512_sub_pd(norm_input, minimum), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					_mm512_storeu_pd(output_values + i, _mm512_mul_pd(output_period, _mm512_sub_pd(norm_input, whole)));
+				}
+
+				forward_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void reverse_avx512(const double *input_values, double *output_values, std::size_t count, const constants &c) noexcept
+			{
+				const __m512d scale = _mm512_set1_pd(Multiply ? c.input_reciprocal : c.input_period);
+				const __m512d origin = _mm512_set1_pd(c.origin);
+				const __m512d minimum = _mm512_set1_pd(c.minimum);
+				const __m512d output_period = _mm512_set1_pd(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m512d values = _mm512_loadu_pd(input_values + i);
+					const __m512d scaled = Multiply ? _mm512_mul_pd(values, scale) : _mm512_div_pd(values, scale);
+					const __m512d norm_input = _mm512_sub_pd(scaled, origin);
+					const __m512d whole = _mm512_roundscale_pd(_mm512_add_pd(norm_input, minimum), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+					_mm512_storeu_pd(output_values + i, _mm512_mul_pd(output_period, _mm512_sub_pd(whole, norm_input)));
+				}
+
+				reverse_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			//
+			// sse4.2, float - 4 lanes, with the sse4.1 roundps
+			//
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("sse4.2") static void forward_sse42(const float *input_values, float *output_values, std::size_t count, const float_constants &c) noexcept
+			{
+				const __m128 scale = _mm_set1_ps(Multiply ? c.input_reciprocal : c.input_period);
+				const __m128 origin = _mm_set1_ps(c.origin);
+				const __m128 minimum = _mm_set1_ps(c.minimum);
+				const __m128 output_period = _mm_set1_ps(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128 values = _mm_loadu_ps(input_values + i);
+					const __m128 scaled = Multiply ? _mm_mul_ps(values, scale) : _mm_div_ps(values, scale);
+					const __m128 norm_input = _mm_add_ps(scaled, origin);
+					const __m128 whole = _mm_round_ps(_mm_sub_ps(norm_input, minimum), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					_mm_storeu_ps(output_values + i, _mm_mul_ps(output_period, _mm_sub_ps(norm_input, whole)));
+				}
+
+				forward_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("sse4.2") static void reverse_sse42(const float *input_values, float *output_values, std::size_t count, const float_constants &c) noexcept
+			{
+				const __m128 scale = _mm_set1_ps(Multiply ? c.input_reciprocal : c.input_period);
+				const __m128 origin = _mm_set1_ps(c.origin);
+				const __m128 minimum = _mm_set1_ps(c.minimum);
+				const __m128 output_period = _mm_set1_ps(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128 values = _mm_loadu_ps(input_values + i);
+					const __m128 scaled = Multiply ? _mm_mul_ps(values, scale) : _mm_div_ps(values, scale);
+					const __m128 norm_input = _mm_sub_ps(scaled, origin);
+					const __m128 whole = _mm_round_ps(_mm_add_ps(norm_input, minimum), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+					_mm_storeu_ps(output_values + i, _mm_mul_ps(output_period, _mm_sub_ps(whole, norm_input)));
+				}
+
+				reverse_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			//
+			// avx2, float - 8 lanes
+			//
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("avx2") static void forward_avx2(const float *input_values, float *output_values, std::size_t count, const float_constants &c) noexcept
+			{
+				const __m256 scale = _mm256_set1_ps(Multiply ? c.input_reciprocal : c.input_period);
+				const __m256 origin = _mm256_set1_ps(c.origin);
+				const __m256 minimum = _mm256_set1_ps(c.minimum);
+				const __m256 output_period = _mm256_set1_ps(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256 values = _mm256_loadu_ps(input_values + i);
+					const __m256 scaled = Multiply ? _mm256_mul_ps(values, scale) : _mm256_div_ps(values, scale);
+					const __m256 norm_input = _mm256_add_ps(scaled, origin);
+					const __m256 whole = _mm256_round_ps(_mm256_sub_ps(norm_input, minimum), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					_mm256_storeu_ps(output_values + i, _mm256_mul_ps(output_period, _mm256_sub_ps(norm_input, whole)));
+				}
+
+				forward_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("avx2") static void reverse_avx2(const float *input_values, float *output_values, std::size_t count, const float_constants &c) noexcept
+			{
+				const __m256 scale = _mm256_set1_ps(Multiply ? c.input_reciprocal : c.input_period);
+				const __m256 origin = _mm256_set1_ps(c.origin);
+				const __m256 minimum = _mm256_set1_ps(c.minimum);
+				const __m256 output_period = _mm256_set1_ps(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256 values = _mm256_loadu_ps(input_values + i);
+					const __m256 scaled = Multiply ? _mm256_mul_ps(values, scale) : _mm256_div_ps(values, scale);
+					const __m256 norm_input = _mm256_sub_ps(scaled, origin);
+					const __m256 whole = _mm256_round_ps(_mm256_add_ps(norm_input, minimum), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+					_mm256_storeu_ps(output_values + i, _mm256_mul_ps(output_period, _mm256_sub_ps(whole, norm_input)));
+				}
+
+				reverse_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			//
+			// avx-512, float - 16 lanes
+			//
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void forward_avx512(const float *input_values, float *output_values, std::size_t count, const float_constants &c) noexcept
+			{
+				const __m512 scale = _mm512_set1_ps(Multiply ? c.input_reciprocal : c.input_period);
+				const __m512 origin = _mm512_set1_ps(c.origin);
+				const __m512 minimum = _mm512_set1_ps(c.minimum);
+				const __m512 output_period = _mm512_set1_ps(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 16 <= count; i += 16)
+				{
+					const __m512 values = _mm512_loadu_ps(input_values + i);
+					const __m512 scaled = Multiply ? _mm512_mul_ps(values, scale) : _mm512_div_ps(values, scale);
+					const __m512 norm_input = _mm512_add_ps(scaled, origin);
+					const __m512 whole = _mm512_roundscale_ps(_mm512_sub_ps(norm_input, minimum), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					_mm512_storeu_ps(output_values + i, _mm512_mul_ps(output_period, _mm512_sub_ps(norm_input, whole)));
+				}
+
+				forward_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+			template <bool Multiply>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void reverse_avx512(const float *input_values, float *output_values, std::size_t count, const float_constants &c) noexcept
+			{
+				const __m512 scale = _mm512_set1_ps(Multiply ? c.input_reciprocal : c.input_period);
+				const __m512 origin = _mm512_set1_ps(c.origin);
+				const __m512 minimum = _mm512_set1_ps(c.minimum);
+				const __m512 output_period = _mm512_set1_ps(c.output_period);
+
+				std::size_t i = 0;
+				for (; i + 16 <= count; i += 16)
+				{
+					const __m512 values = _mm512_loadu_ps(input_values + i);
+					const __m512 scaled = Multiply ? _mm512_mul_ps(values, scale) : _mm512_div_ps(values, scale);
+					const __m512 norm_input = _mm512_sub_ps(scaled, origin);
+					const __m512 whole = _mm512_roundscale_ps(_mm512_add_ps(norm_input, minimum), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+					_mm512_storeu_ps(output_values + i, _mm512_mul_ps(output_period, _mm512_sub_ps(whole, norm_input)));
+				}
+
+				reverse_scalar(input_values + i, output_values + i, count - i, c);
+			}
+
+#endif
+
+			//
+			// dispatch
+			//
+
+			template <typename T>
+			using convert_kernel = void (*)(const T *, T *, std::size_t, const detail::convert_constants<T> &) noexcept;
+
+			template <typename T>
+			static convert_kernel<T> select_forward(instruction_set isa, const detail::convert_constants<T> &c) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				if (c.input_reciprocal != T(0))
+					return kernels::select<convert_kernel<T>>(isa, forward_scalar, forward_sse42<true>, forward_avx2<true>, forward_avx512<true>);
+
+				return kernels::select<convert_kernel<T>>(isa, forward_scalar, forward_sse42<false>, forward_avx2<false>, forward_avx512<false>);
+#else
+				return kernels::select<convert_kernel<T>>(isa, forward_scalar, forward_scalar, forward_scalar, forward_scalar);
+#endif
+			}
+
+			template <typename T>
+			static convert_kernel<T> select_reverse(instruction_set isa, const detail::convert_constants<T> &c) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				if (c.input_reciprocal != T(0))
+					return kernels::select<convert_kernel<T>>(isa, reverse_scalar, reverse_sse42<true>, reverse_avx2<true>, reverse_avx512<true>);
+
+				return kernels::select<convert_kernel<T>>(isa, reverse_scalar, reverse_sse42<false>, reverse_avx2<false>, reverse_avx512<false>);
+#else
+				return kernels::select<convert_kernel<T>>(isa, reverse_scalar, reverse_scalar, reverse_scalar, reverse_scalar);
+#endif
+			}
+
+			template <typename T>
+			static void convert(convert_kernel<T> kernel, std::span<const T> input_values, std::span<T> output_values, const detail::convert_constants<T> &c) noexcept
+			{
+				const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+				kernel(input_values.data(), output_values.data(), count, c);
+			}
+		};
+
+		//
+		// span interface. each converts the first min(input_values.size(), output_values.size()) values. the instruction set
+		// defaults to the best one supported, and asking for more than is supported gets what is supported.
+		//
+
+		// same as pcs::forward_convert() for each value
+		inline void forward_convert(std::span<const double> input_values, std::span<double> output_values,
+									double input_period, double input_origin, double output_min, double output_period,
+									instruction_set isa = supported_instruction_set()) noexcept
+		{
+			const auto constants = detail::make_convert_constants(input_period, input_origin, output_min, output_period);
+			convert_kernels::convert(convert_kernels::select_forward(isa, constants), input_values, output_values, constants);
+		}
+
+		// same as pcs::reverse_convert() for each value
+		inline void reverse_convert(std::span<const double> input_values, std::span<double> output_values,
+									double input_period, double input_origin, double output_min, double output_period,
+									instruction_set isa = supported_instruction_set()) noexcept
+		{
+			const auto constants = detail::make_convert_constants(input_period, input_origin, output_min, output_period);
+			convert_kernels::convert(convert_kernels::select_reverse(isa, constants), input_values, output_values, constants);
+		}
+
+		// the float versions, with twice the lanes
+		inline void forward_convert(std::span<const float> input_values, std::span<float> output_values,
+									float input_period, float input_origin, float output_min, float output_period,
+									instruction_set isa = supported_instruction_set()) noexcept
+		{
+			const auto constants = detail::make_convert_constants(input_period, input_origin, output_min, output_period);
+			convert_kernels::convert(convert_kernels::select_forward(isa, constants), input_values, output_values, constants);
+		}
+
+		inline void reverse_convert(std::span<const float> input_values, std::span<float> output_values,
+									float input_period, float input_origin, float output_min, float output_period,
+									instruction_set isa = supported_instruction_set()) noexcept
+		{
+			const auto constants = detail::make_convert_constants(input_period, input_origin, output_min, output_period);
+			convert_kernels::convert(convert_kernels::select_reverse(isa, constants), input_values, output_values, constants);
+		}
+
+		// which of the cxcm rounding functions a rounding kernel does
+		enum class rounding : int
+		{
+			floor,
+			ceil,
+			trunc,
+			round,				// halfway cases away from zero
+			round_even,			// halfway cases to even
+			fract				// value - floor(value), but values with no fractional part, including +/-0, come back as they are
+		};
+
+		struct rounding_kernels
+		{
+			//
+			// scalar - the cxcm functions, which are the standard library ones at runtime
+			//
+
+			template <rounding Mode, typename T>
+			static T round_one(T value) noexcept
+			{
+				if constexpr (Mode == rounding::floor)				{ return cxcm::floor(value); }
+				else if constexpr (Mode == rounding::ceil)			{ return cxcm::ceil(value); }
+				else if constexpr (Mode == rounding::trunc)			{ return cxcm::trunc(value); }
+				else if constexpr (Mode == rounding::round)			{ return cxcm::round(value); }
+				else if constexpr (Mode == rounding::round_even)	{ return std::nearbyint(value); }
+				else												{ return cxcm::fract(value); }
+			}
+
+			template <rounding Mode, typename T>
+			static void round_scalar(const T *values, T *results, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ results[i] = round_one<Mode>(values[i]); }
+			}
+
+#if defined(PCS_SIMD_X86)
+
+			//
+			// sse4.2 - 2 doubles or 4 floats, with the sse4.1 roundpd and roundps
+			//
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("sse4.2") static __m128d round_sse42(__m128d values) noexcept
+			{
+				const __m128d sign = _mm_set1_pd(-0.0);
+				if constexpr (Mode == rounding::floor)				{ return _mm_round_pd(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::ceil)			{ return _mm_round_pd(values, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::trunc)			{ return _mm_round_pd(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round_even)	{ return _mm_round_pd(values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round)
+				{
+					// value - trunc(value) is exact, and when it is at least a half, step away from zero. a blend, not an add of
+					// zero, keeps -0. infinities give NaN differences, which don't compare.
+					const __m128d whole = _mm_round_pd(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+					const __m128d away = _mm_cmpge_pd(_mm_andnot_pd(sign, _mm_sub_pd(values, whole)), _mm_set1_pd(0.5));
+					const __m128d step = _mm_or_pd(_mm_and_pd(values, sign), _mm_set1_pd(1.0));
+					return _mm_blendv_pd(whole, _mm_add_pd(whole, step), away);
+				}
+				else
+				{
+					const __m128d whole = _mm_round_pd(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					const __m128d fractional = _mm_and_pd(_mm_cmple_pd(_mm_andnot_pd(sign, values), _mm_set1_pd(cxcm::limits::largest_fractional_value<double>)),
+														  _mm_cmpneq_pd(values, _mm_setzero_pd()));
+					return _mm_blendv_pd(values, _mm_sub_pd(values, whole), fractional);
+				}
+			}
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("sse4.2") static __m128 round_sse42(__m128 values) noexcept
+			{
+				const __m128 sign = _mm_set1_ps(-0.0f);
+				if constexpr (Mode == rounding::floor)				{ return _mm_round_ps(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::ceil)			{ return _mm_round_ps(values, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::trunc)			{ return _mm_round_ps(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round_even)	{ return _mm_round_ps(values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round)
+				{
+					const __m128 whole = _mm_round_ps(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+					const __m128 away = _mm_cmpge_ps(_mm_andnot_ps(sign, _mm_sub_ps(values, whole)), _mm_set1_ps(0.5f));
+					const __m128 step = _mm_or_ps(_mm_and_ps(values, sign), _mm_set1_ps(1.0f));
+					return _mm_blendv_ps(whole, _mm_add_ps(whole, step), away);
+				}
+				else
+				{
+					const __m128 whole = _mm_round_ps(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					const __m128 fractional = _mm_and_ps(_mm_cmple_ps(_mm_andnot_ps(sign, values), _mm_set1_ps(cxcm::limits::largest_fractional_value<float>)),
+														 _mm_cmpneq_ps(values, _mm_setzero_ps()));
+					return _mm_blendv_ps(values, _mm_sub_ps(values, whole), fractional);
+				}
+			}
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("sse4.2") static void round_sse42(const double *values, double *results, std::size_t count) noexcept
+			{
+				std::size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+					_mm_storeu_pd(results + i, round_sse42<Mode>(_mm_loadu_pd(values + i)));
+
+				round_scalar<Mode>(values + i, results + i, count - i);
+			}
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("sse4.2") static void round_sse42(const float *values, float *results, std::size_t count) noexcept
+			{
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+					_mm_storeu_ps(results + i, round_sse42<Mode>(_mm_loadu_ps(values + i)));
+
+				round_scalar<Mode>(values + i, results + i, count - i);
+			}
+
+			//
+			// avx2 - 4 doubles or 8 floats. the rounding only needs avx, but this is the tier that has it.
+			//
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("avx2") static __m256d round_avx2(__m256d values) noexcept
+			{
+				const __m256d sign = _mm256_set1_pd(-0.0);
+				if constexpr (Mode == rounding::floor)				{ return _mm256_round_pd(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::ceil)			{ return _mm256_round_pd(values, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::trunc)			{ return _mm256_round_pd(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round_even)	{ return _mm256_round_pd(values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round)
+				{
+					const __m256d whole = _mm256_round_pd(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+					const __m256d away = _mm256_cmp_pd(_mm256_andnot_pd(sign, _mm256_sub_pd(values, whole)), _mm256_set1_pd(0.5), _CMP_GE_OQ);
+					const __m256d step = _mm256_or_pd(_mm256_and_pd(values, sign), _mm256_set1_pd(1.0));
+					return _mm256_blendv_pd(whole, _mm256_add_pd(whole, step), away);
+				}
+				else
+				{
+					const __m256d whole = _mm256_round_pd(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					const __m256d fractional = _mm256_and_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign, values), _mm256_set1_pd(cxcm::limits::largest_fractional_value<double>), _CMP_LE_OQ),
+															 _mm256_cmp_pd(values, _mm256_setzero_pd(), _CMP_NEQ_UQ));
+					return _mm256_blendv_pd(values, _mm256_sub_pd(values, whole), fractional);
+				}
+			}
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("avx2") static __m256 round_avx2(__m256 values) noexcept
+			{
+				const __m256 sign = _mm256_set1_ps(-0.0f);
+				if constexpr (Mode == rounding::floor)				{ return _mm256_round_ps(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::ceil)			{ return _mm256_round_ps(values, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::trunc)			{ return _mm256_round_ps(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round_even)	{ return _mm256_round_ps(values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round)
+				{
+					const __m256 whole = _mm256_round_ps(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+					const __m256 away = _mm256_cmp_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(values, whole)), _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+					const __m256 step = _mm256_or_ps(_mm256_and_ps(values, sign), _mm256_set1_ps(1.0f));
+					return _mm256_blendv_ps(whole, _mm256_add_ps(whole, step), away);
+				}
+				else
+				{
+					const __m256 whole = _mm256_round_ps(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					const __m256 fractional = _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(sign, values), _mm256_set1_ps(cxcm::limits::largest_fractional_value<float>), _CMP_LE_OQ),
+															_mm256_cmp_ps(values, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+					return _mm256_blendv_ps(values, _mm256_sub_ps(values, whole), fractional);
+				}
+			}
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("avx2") static void round_avx2(const double *values, double *results, std::size_t count) noexcept
+			{
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+					_mm256_storeu_pd(results + i, round_avx2<Mode>(_mm256_loadu_pd(values + i)));
+
+				round_sse42<Mode>(values + i, results + i, count - i);
+			}
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("avx2") static void round_avx2(const float *values, float *results, std::size_t count) noexcept
+			{
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+					_mm256_storeu_ps(results + i, round_avx2<Mode>(_mm256_loadu_ps(values + i)));
+
+				round_sse42<Mode>(values + i, results + i, count - i);
+			}
+
+			//
+			// avx-512 - 8 doubles or 16 floats, with roundscale and mask blends
+			//
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512d round_avx512(__m512d values) noexcept
+			{
+				if constexpr (Mode == rounding::floor)				{ return _mm512_roundscale_pd(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::ceil)			{ return _mm512_roundscale_pd(values, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::trunc)			{ return _mm512_roundscale_pd(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round_even)	{ return _mm512_roundscale_pd(values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round)
+				{
+					const __m512d whole = _mm512_roundscale_pd(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+					const __mmask8 away = _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_sub_pd(values, whole)), _mm512_set1_pd(0.5), _CMP_GE_OQ);
+					const __m512d step = _mm512_or_pd(_mm512_and_pd(values, _mm512_set1_pd(-0.0)), _mm512_set1_pd(1.0));
+					return _mm512_mask_add_pd(whole, away, whole, step);
+				}
+				else
+				{
+					const __m512d whole = _mm512_roundscale_pd(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					const __mmask8 fractional = _mm512_cmp_pd_mask(_mm512_abs_pd(values), _mm512_set1_pd(cxcm::limits::largest_fractional_value<double>), _CMP_LE_OQ) &
+												_mm512_cmp_pd_mask(values, _mm512_setzero_pd(), _CMP_NEQ_UQ);
+					return _mm512_mask_sub_pd(values, fractional, values, whole);
+				}
+			}
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static __m512 round_avx512(__m512 values) noexcept
+			{
+				if constexpr (Mode == rounding::floor)				{ return _mm512_roundscale_ps(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::ceil)			{ return _mm512_roundscale_ps(values, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::trunc)			{ return _mm512_roundscale_ps(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round_even)	{ return _mm512_roundscale_ps(values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+				else if constexpr (Mode == rounding::round)
+				{
+					const __m512 whole = _mm512_roundscale_ps(values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+					const __mmask16 away = _mm512_cmp_ps_mask(_mm512_abs_ps(_mm512_sub_ps(values, whole)), _mm512_set1_ps(0.5f), _CMP_GE_OQ);
+					const __m512 step = _mm512_or_ps(_mm512_and_ps(values, _mm512_set1_ps(-0.0f)), _mm512_set1_ps(1.0f));
+					return _mm512_mask_add_ps(whole, away, whole, step);
+				}
+				else
+				{
+					const __m512 whole = _mm512_roundscale_ps(values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+					const __mmask16 fractional = _mm512_cmp_ps_mask(_mm512_abs_ps(values), _mm512_set1_ps(cxcm::limits::largest_fractional_value<float>), _CMP_LE_OQ) &
+												 _mm512_cmp_ps_mask(values, _mm512_setzero_ps(), _CMP_NEQ_UQ);
+					return _mm512_mask_sub_ps(values, fractional, values, whole);
+				}
+			}
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void round_avx512(const double *values, double *results, std::size_t count) noexcept
+			{
+				std::size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+					_mm512_storeu_pd(results + i, round_avx512<Mode>(_mm512_loadu_pd(values + i)));
+
+				round_avx2<Mode>(values + i, results + i, count - i);
+			}
+
+			template <rounding Mode>
+			PCS_SIMD_TARGET("avx512f,avx512dq") static void round_avx512(const float *values, float *results, std::size_t count) noexcept
+			{
+				std::size_t i = 0;
+				for (; i + 16 <= count; i += 16)
+					_mm512_storeu_ps(results + i, round_avx512<Mode>(_mm512_loadu_ps(values + i)));
+
+				round_avx2<Mode>(values + i, results + i, count - i);
+			}
+
+#endif
+
+			//
+			// dispatch
+			//
+
+			template <typename T>
+			using rounding_kernel = void (*)(const T *, T *, std::size_t) noexcept;
+
+			template <rounding Mode, typename T>
+			static rounding_kernel<T> select_rounding(instruction_set isa) noexcept
+			{
+#if defined(PCS_SIMD_X86)
+				return kernels::select<rounding_kernel<T>>(isa, round_scalar<Mode, T>, round_sse42<Mode>, round_avx2<Mode>, round_avx512<Mode>);
+#else
+				return kernels::select<rounding_kernel<T>>(isa, round_scalar<Mode, T>, round_scalar<Mode, T>, round_scalar<Mode, T>, round_scalar<Mode, T>);
+#endif
+			}
+
+			// the first min(values.size(), results.size()). results can be values itself.
+			template <rounding Mode, typename T>
+			static void apply(std::span<const T> values, std::span<T> results, instruction_set isa) noexcept
+			{
+				const std::size_t count = (values.size() < results.size()) ? values.size() : results.size();
+				select_rounding<Mode, T>(isa)(values.data(), results.data(), count);
+			}
+		};
+
+	}	// namespace simd
+
+	namespace cxcm
+	{
+		//
+		// span versions of the rounding functions, for float and double. each rounds the first min(values.size(),
+		// results.size()) values, and results can be values itself. the instruction set defaults to the best one supported.
+		//
+
+		inline void floor(std::span<const double> values, std::span<double> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::floor>(values, results, isa);
+		}
+
+		inline void floor(std::span<const float> values, std::span<float> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::floor>(values, results, isa);
+		}
+
+		inline void ceil(std::span<const double> values, std::span<double> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::ceil>(values, results, isa);
+		}
+
+		inline void ceil(std::span<const float> values, std::span<float> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::ceil>(values, results, isa);
+		}
+
+		inline void trunc(std::span<const double> values, std::span<double> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::trunc>(values, results, isa);
+		}
+
+		inline void trunc(std::span<const float> values, std::span<float> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::trunc>(values, results, isa);
+		}
+
+		// halfway cases away from zero
+		inline void round(std::span<const double> values, std::span<double> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::round>(values, results, isa);
+		}
+
+		inline void round(std::span<const float> values, std::span<float> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::round>(values, results, isa);
+		}
+
+		// halfway cases to even
+		inline void round_even(std::span<const double> values, std::span<double> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::round_even>(values, results, isa);
+		}
+
+		inline void round_even(std::span<const float> values, std::span<float> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::round_even>(values, results, isa);
+		}
+
+		inline void fract(std::span<const double> values, std::span<double> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::fract>(values, results, isa);
+		}
+
+		inline void fract(std::span<const float> values, std::span<float> results, simd::instruction_set isa = simd::supported_instruction_set()) noexcept
+		{
+			simd::rounding_kernels::apply<simd::rounding::fract>(values, results, isa);
+		}
+
+	}	// namespace cxcm
+
+}	// namespace pcs
+
+// closing include guard
+#endif
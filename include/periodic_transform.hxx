@@ -0,0 +1,156 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_PERIODIC_TRANSFORM_HXX)
+#define PCS_PERIODIC_TRANSFORM_HXX
+
+#include "bam64.hxx"
+#include "periodic.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// the periodic transform from the README's figures, from a system A to a system B:
+	//
+	//		x_B = theta * x_A + P
+	//
+	// where theta is +1 or -1 and P is A's origin in B's coordinates. the offset is kept as a bam64, i.e., in turns, so applying
+	// a transform to a bam64 is an add, or a subtract from the offset when theta is -1, and it wraps without any rounding.
+	// composing and inverting are also exact:
+	//
+	//		(X2 * X1): theta = theta2 * theta1,	P = theta2 * P1 + P2
+	//		inverse(X): theta = theta,			P = -theta * P
+	//
+	// the periods only matter for double values. input_period is for values in A, and output_period is for values in B.
+	//
+
+	struct periodic_transform
+	{
+		std::int8_t orientation = 1;				// theta, +1 when A and B have the same orientation, -1 when they are opposite
+		bam64 offset = { .value = 0 };				// A's origin in B, in turns
+		double input_period = 1.0;					// the period of values in A
+		double output_period = 1.0;					// the period of values in B
+
+
+		// builders
+
+		// input_origin is A's origin in B's coordinates, so it is in output_period units, like the converters
+		[[nodiscard]] static constexpr periodic_transform from_origin(int orientation, double input_origin, double input_period = 1.0, double output_period = 1.0) noexcept
+		{
+			return periodic_transform
+			{
+				.orientation = static_cast<std::int8_t>((orientation < 0) ? -1 : 1),
+				.offset = bam64::from_base(input_origin, output_period),
+				.input_period = input_period,
+				.output_period = output_period
+			};
+		}
+
+		[[nodiscard]] static constexpr periodic_transform from_converter(const forward_period_converter &converter) noexcept
+		{
+			return from_origin(1, converter.input_origin, converter.input_period, converter.output_period);
+		}
+
+		[[nodiscard]] static constexpr periodic_transform from_converter(const reverse_period_converter &converter) noexcept
+		{
+			return from_origin(-1, converter.input_origin, converter.input_period, converter.output_period);
+		}
+
+
+		// properties
+
+		// A's origin in B's coordinates, in [0, output_period)
+		[[nodiscard]] constexpr double input_origin() const noexcept					{ return this->offset.fraction(this->output_period); }
+
+		// the transform from B back to A
+		[[nodiscard]] constexpr periodic_transform inverse() const noexcept
+		{
+			return periodic_transform
+			{
+				.orientation = this->orientation,
+				.offset = (this->orientation > 0) ? -this->offset : this->offset,
+				.input_period = this->output_period,
+				.output_period = this->input_period
+			};
+		}
+
+
+		// composition
+
+		// this after rhs, i.e., rhs goes from A to B, and this goes from B to C. rhs.output_period and input_period should
+		// describe the same system, and only the outer periods are kept.
+		[[nodiscard]] constexpr periodic_transform operator *(const periodic_transform &rhs) const noexcept
+		{
+			return periodic_transform
+			{
+				.orientation = static_cast<std::int8_t>(this->orientation * rhs.orientation),
+				.offset = this->apply(rhs.offset),
+				.input_period = rhs.input_period,
+				.output_period = this->output_period
+			};
+		}
+
+
+		// applying the transform
+
+		// x_B = theta * x_A + P, in the integer domain
+		[[nodiscard]] constexpr bam64 apply(bam64 value) const noexcept
+		{
+			return (this->orientation > 0) ? (this->offset + value) : (this->offset - value);
+		}
+
+		//
+		[[nodiscard]] constexpr bam64 operator()(bam64 value) const noexcept				{ return this->apply(value); }
+
+		// batch version, for the first min(input_values.size(), output_values.size()) values. the orientation is checked once,
+		// so each loop is a plain add or subtract that the compiler can vectorize.
+		constexpr void apply(std::span<const bam64> input_values, std::span<bam64> output_values) const noexcept
+		{
+			const std::size_t count = (input_values.size() < output_values.size()) ? input_values.size() : output_values.size();
+			const unsigned long long offset_value = this->offset.value;
+			if (this->orientation > 0)
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ output_values[i].value = offset_value + input_values[i].value; }
+			}
+			else
+			{
+				for (std::size_t i = 0; i < count; ++i)		{ output_values[i].value = offset_value - input_values[i].value; }
+			}
+		}
+
+		// a double value in A's period to B's period, in the range [output_min, output_min + output_period)
+		[[nodiscard]] constexpr double convert(double input_value, double output_min = 0.0) const noexcept
+		{
+			return (this->orientation > 0) ? forward_convert(input_value, this->input_period, this->input_origin(), output_min, this->output_period)
+										   : reverse_convert(input_value, this->input_period, this->input_origin(), output_min, this->output_period);
+		}
+
+
+		// comparison functions
+
+		[[nodiscard]] constexpr bool operator ==(const periodic_transform &other) const noexcept = default;
+
+	};	// struct periodic_transform
+
+	// the identity transform for a period
+	[[nodiscard]] inline constexpr periodic_transform identity_transform(double period = 1.0) noexcept
+	{
+		return periodic_transform{ .orientation = 1, .offset = { .value = 0 }, .input_period = period, .output_period = period };
+	}
+
+}	// namespace pcs
+
+// closing include guard
+#endif
@@ -0,0 +1,271 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// opening include guard
+#if !defined(PCS_RADIX_SORT_HXX)
+#define PCS_RADIX_SORT_HXX
+
+#include "bam64.hxx"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace pcs
+{
+	//          Copyright David Browne 2025.
+	// Distributed under the Boost Software License, Version 1.0.
+	//    (See accompanying file LICENSE_1_0.txt or copy at
+	//          https://www.boost.org/LICENSE_1_0.txt)
+
+	//
+	// lsd radix sort of bam64 by value, optionally moving a payload along with each key. the sort is stable.
+	//
+	// the digits are 11 bits, so there are six passes over the keys, and the histograms for all six come from one pass before
+	// them. a pass is skipped when every key has the same digit there. that is common for bams from the _alt builders, which
+	// only have 53 bits, and for angles that are all in a small arc.
+	//
+	// the parallel versions give each thread a slice of the keys. for each pass, every thread counts the digits in its slice,
+	// the counts are turned into offsets by bucket, then by thread, and every thread moves its slice to those offsets. the
+	// result is the same as the serial sort.
+	//
+
+	namespace detail
+	{
+		inline constexpr int radix_bits = 11;
+		inline constexpr std::size_t radix_buckets = std::size_t{1} << radix_bits;
+		inline constexpr int radix_passes = (64 + radix_bits - 1) / radix_bits;
+
+		// below this, sorting only keys uses std::sort, since clearing and summing the histograms costs more than the sort
+		inline constexpr std::size_t radix_sort_minimum = std::size_t{1} << 12;
+
+		// below this, the parallel versions just use one thread
+		inline constexpr std::size_t radix_parallel_minimum = std::size_t{1} << 16;
+
+		constexpr std::size_t radix_digit(bam64 key, int pass) noexcept
+		{
+			return static_cast<std::size_t>(key.value >> (pass * radix_bits)) & (radix_buckets - 1);
+		}
+
+		// counts of every digit, for every pass, in one pass over the keys
+		inline void radix_histograms(const bam64 *keys, std::size_t count, std::size_t *counts) noexcept
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				for (int pass = 0; pass < radix_passes; ++pass)
+					++counts[pass * radix_buckets + radix_digit(keys[i], pass)];
+			}
+		}
+
+		// run f(thread) for each thread, where the calling thread is thread 0. the jthreads join when they go out of scope,
+		// even if something throws, and any thread that can't be started has its f(thread) run by the calling thread.
+		template <typename F>
+		void radix_run(std::size_t thread_count, F &f)
+		{
+			std::vector<std::jthread> workers;
+			workers.reserve(thread_count - 1);
+
+			std::size_t started = 1;
+			try
+			{
+				for (; started < thread_count; ++started)
+					workers.emplace_back([&f, thread = started]() { f(thread); });
+			}
+			catch (const std::system_error &)
+			{
+			}
+
+			f(0);
+			for (std::size_t thread = started; thread < thread_count; ++thread)
+				f(thread);
+		}
+
+		// payloads is ignored unless HasPayload. thread_count of 1 is the serial sort.
+		template <bool HasPayload, typename Payload>
+		void radix_sort(std::span<bam64> keys, Payload *payloads, std::size_t thread_count)
+		{
+			const std::size_t size = keys.size();
+			if (size < 2)
+				return;
+
+			// equal keys without payloads can't be told apart, so this doesn't need to be stable
+			if constexpr (!HasPayload)
+			{
+				if (size < radix_sort_minimum)
+				{
+					std::sort(keys.begin(), keys.end());
+					return;
+				}
+			}
+
+			if (size < radix_parallel_minimum)
+				thread_count = 1;
+
+			std::vector<bam64> key_buffer(size);
+
+			// copies rather than default constructed ones, so Payload only has to be copyable
+			std::vector<Payload> payload_buffer;
+			if constexpr (HasPayload)
+				payload_buffer.assign(payloads, payloads + size);
+
+			bam64 *source = keys.data();
+			bam64 *destination = key_buffer.data();
+			Payload *source_payloads = payloads;
+			Payload *destination_payloads = payload_buffer.data();
+
+			// thread t gets [slice(t), slice(t + 1))
+			auto slice = [size, thread_count](std::size_t thread) { return size / thread_count * thread + std::min(thread, size % thread_count); };
+
+			// which passes can be skipped
+			std::vector<std::size_t> totals(radix_passes * radix_buckets, 0);
+			if (thread_count == 1)
+			{
+				radix_histograms(source, size, totals.data());
+			}
+			else
+			{
+				std::vector<std::size_t> counts(thread_count * radix_passes * radix_buckets, 0);
+				auto count_slice = [&](std::size_t thread)
+				{
+					radix_histograms(source + slice(thread), slice(thread + 1) - slice(thread), counts.data() + thread * radix_passes * radix_buckets);
+				};
+				radix_run(thread_count, count_slice);
+
+				for (std::size_t thread = 0; thread < thread_count; ++thread)
+				{
+					for (std::size_t i = 0; i < totals.size(); ++i)
+						totals[i] += counts[thread * radix_passes * radix_buckets + i];
+				}
+			}
+
+			std::vector<std::size_t> offsets(thread_count * radix_buckets);
+			for (int pass = 0; pass < radix_passes; ++pass)
+			{
+				const std::size_t *pass_totals = totals.data() + pass * radix_buckets;
+				if (pass_totals[radix_digit(source[0], pass)] == size)
+					continue;
+
+				auto scatter = [&](std::size_t thread)
+				{
+					std::size_t *thread_offsets = offsets.data() + thread * radix_buckets;
+					for (std::size_t i = slice(thread); i < slice(thread + 1); ++i)
+					{
+						const std::size_t position = thread_offsets[radix_digit(source[i], pass)]++;
+						destination[position] = source[i];
+						if constexpr (HasPayload)
+							destination_payloads[position] = source_payloads[i];
+					}
+				};
+
+				if (thread_count == 1)
+				{
+					std::size_t offset = 0;
+					for (std::size_t bucket = 0; bucket < radix_buckets; ++bucket)
+					{
+						offsets[bucket] = offset;
+						offset += pass_totals[bucket];
+					}
+
+					scatter(0);
+				}
+				else
+				{
+					// the slices have moved since the last pass, so they are counted again
+					std::fill(offsets.begin(), offsets.end(), std::size_t{0});
+					auto count_slice = [&](std::size_t thread)
+					{
+						std::size_t *thread_counts = offsets.data() + thread * radix_buckets;
+						for (std::size_t i = slice(thread); i < slice(thread + 1); ++i)
+							++thread_counts[radix_digit(source[i], pass)];
+					};
+					radix_run(thread_count, count_slice);
+
+					// by bucket, then by thread, which keeps the sort stable
+					std::size_t offset = 0;
+					for (std::size_t bucket = 0; bucket < radix_buckets; ++bucket)
+					{
+						for (std::size_t thread = 0; thread < thread_count; ++thread)
+						{
+							const std::size_t count = offsets[thread * radix_buckets + bucket];
+							offsets[thread * radix_buckets + bucket] = offset;
+							offset += count;
+						}
+					}
+
+					radix_run(thread_count, scatter);
+				}
+
+				std::swap(source, destination);
+				std::swap(source_payloads, destination_payloads);
+			}
+
+			// an odd number of passes leaves everything in the buffers
+			if (source != keys.data())
+			{
+				std::copy(source, source + size, keys.data());
+				if constexpr (HasPayload)
+					std::copy(source_payloads, source_payloads + size, payloads);
+			}
+		}
+
+		// no more threads than there are cores, when that is known, and at least radix_parallel_minimum keys for each one
+		inline std::size_t radix_thread_count(unsigned int thread_count, std::size_t size) noexcept
+		{
+			const std::size_t cores = std::thread::hardware_concurrency();
+			std::size_t count = (thread_count == 0) ? cores : thread_count;
+
+			if ((cores != 0) && (count > cores))
+				count = cores;
+
+			if (count > size / radix_parallel_minimum)
+				count = size / radix_parallel_minimum;
+
+			return (count == 0) ? 1 : count;
+		}
+
+	}	// namespace detail
+
+	// sort bams by value
+	inline void radix_sort(std::span<bam64> bams)
+	{
+		detail::radix_sort<false, char>(bams, nullptr, 1);
+	}
+
+	// sort keys by value, and payloads along with them
+	template <std::copyable Payload>
+	void radix_sort(std::span<bam64> keys, std::span<Payload> payloads)
+	{
+		if (keys.size() != payloads.size())
+			throw std::invalid_argument("radix_sort: keys and payloads need the same size");
+
+		detail::radix_sort<true, Payload>(keys, payloads.data(), 1);
+	}
+
+	// the same, spread across threads. thread_count of zero uses std::thread::hardware_concurrency(). no more threads are
+	// started than there are cores, or than one for every radix_parallel_minimum keys, so small inputs only use the calling
+	// thread.
+	inline void parallel_radix_sort(std::span<bam64> bams, unsigned int thread_count = 0)
+	{
+		detail::radix_sort<false, char>(bams, nullptr, detail::radix_thread_count(thread_count, bams.size()));
+	}
+
+	template <std::copyable Payload>
+	void parallel_radix_sort(std::span<bam64> keys, std::span<Payload> payloads, unsigned int thread_count = 0)
+	{
+		if (keys.size() != payloads.size())
+			throw std::invalid_argument("parallel_radix_sort: keys and payloads need the same size");
+
+		detail::radix_sort<true, Payload>(keys, payloads.data(), detail::radix_thread_count(thread_count, keys.size()));
+	}
+
+}	// namespace pcs
+
+// closing include guard
+#endif
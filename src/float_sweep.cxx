@@ -0,0 +1,35 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+//
+//
+// This file contains main() for the float_sweep target, which only runs the exhaustive float sweeps in
+// tests/float_sweep_test.cxx. They take too long to be part of the periodic unit tests. The usual doctest
+// options still work, e.g., --test-case="*sqrt*" runs just the sqrt sweeps.
+//
+//
+
+#if defined(__clang__) && (__clang_major__ < 13)
+// clang 10.0 does not like colors on windows (link problems with isatty and fileno)
+#define DOCTEST_CONFIG_COLORS_NONE
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest.h"
+
+#include <cstdlib>
+
+int main(int argc, char *argv[])
+{
+	doctest::Context context;
+	context.applyCommandLine(argc, argv);
+
+	const int doctest_result = context.run();
+
+	if (context.shouldExit())					// important - query flags (and --exit) rely on the user doing this
+		return doctest_result;					// propagate the result of the tests
+
+	return EXIT_SUCCESS + doctest_result;
+}
@@ -0,0 +1,126 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "angle_index.hxx"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+	// the payloads of every angle within the tolerance, the slow way
+	std::vector<std::size_t> linear_within(const std::vector<pcs::bam64> &angles, pcs::bam64 center, pcs::bam64 tolerance)
+	{
+		std::vector<std::size_t> found;
+		for (std::size_t i = 0; i < angles.size(); ++i)
+		{
+			if (pcs::within_distance(angles[i], center, tolerance))
+				found.push_back(i);
+		}
+
+		return found;
+	}
+
+}	// namespace
+
+TEST_SUITE("test angle index")
+{
+	TEST_CASE("build")
+	{
+		std::mt19937_64 gen(0x1de5);
+		std::vector<pcs::bam64> angles(10'000);
+		for (auto &angle : angles)
+			angle.value = gen();
+
+		// some duplicates, and the extremes
+		angles[10] = angles[20];
+		angles[30].value = 0;
+		angles[40].value = ~0ULL;
+
+		const pcs::angle_index index(angles);
+		REQUIRE_EQ(index.size(), angles.size());
+
+		auto sorted = angles;
+		std::sort(sorted.begin(), sorted.end());
+		for (std::size_t i = 0; i < sorted.size(); ++i)
+		{
+			CHECK_EQ(index.angle(i), sorted[i]);
+			CHECK_EQ(angles[index.payload(i)], index.angle(i));
+		}
+
+		// 53-bit angles have all their low digits the same, which are skipped
+		std::vector<pcs::bam64> coarse(1000);
+		for (auto &angle : coarse)
+			angle.value = gen() & ~0x7ffULL;
+
+		const pcs::angle_index coarse_index(coarse);
+		CHECK(std::is_sorted(coarse_index.sorted_payloads().begin(), coarse_index.sorted_payloads().end(),
+							 [&](std::size_t a, std::size_t b) { return coarse[a] < coarse[b]; }));
+
+		// given payloads
+		const std::vector<pcs::bam64> three{ { .value = 30 }, { .value = 10 }, { .value = 20 } };
+		const std::vector<std::size_t> names{ 300, 100, 200 };
+		const pcs::angle_index named(three, names);
+		CHECK_EQ(named.payload(0), 100);
+		CHECK_EQ(named.payload(2), 300);
+
+		CHECK_THROWS_AS(pcs::angle_index(three, std::vector<std::size_t>(2)), std::invalid_argument);
+		CHECK(pcs::angle_index().empty());
+	}
+
+	TEST_CASE("arc queries")
+	{
+		const std::vector<pcs::bam64> angles{ pcs::bam64_from_degrees(350.0), pcs::bam64_from_degrees(5.0), pcs::bam64_from_degrees(90.0),
+											  pcs::bam64_from_degrees(180.0), pcs::bam64_from_degrees(359.0), pcs::bam64_from_degrees(0.0) };
+		const pcs::angle_index index(angles);
+
+		// across zero, in arc order
+		const auto north = index.arc(pcs::bam64_from_degrees(340.0), pcs::bam64_from_degrees(10.0));
+		CHECK_EQ(north.size(), 4);
+		std::vector<std::size_t> found;
+		index.payloads_in(north, found);
+		CHECK_EQ(found, std::vector<std::size_t>{ 0, 4, 5, 1 });
+
+		// both ends are included
+		CHECK_EQ(index.arc(pcs::bam64_from_degrees(90.0), pcs::bam64_from_degrees(180.0)).size(), 2);
+		CHECK_EQ(index.arc(pcs::bam64_from_degrees(90.0), pcs::bam64_from_degrees(90.0)).size(), 1);
+		CHECK(index.arc(pcs::bam64_from_degrees(91.0), pcs::bam64_from_degrees(179.0)).empty());
+
+		CHECK_EQ(index.within(pcs::bam64_from_degrees(0.0), pcs::bam64_from_degrees(5.0)).size(), 3);
+		CHECK_EQ(index.within(pcs::bam64_from_degrees(0.0), pcs::bam64{ .value = pcs::half }).size(), angles.size());
+
+		std::size_t visited = 0;
+		index.for_each(index.within(pcs::bam64_from_degrees(180.0), pcs::bam64_from_degrees(1.0)), [&](pcs::bam64 angle, std::size_t payload)
+		{
+			CHECK_EQ(angle, angles[payload]);
+			++visited;
+		});
+		CHECK_EQ(visited, 1);
+	}
+
+	TEST_CASE("matches a linear scan")
+	{
+		std::mt19937_64 gen(0x5ca7);
+		std::vector<pcs::bam64> angles(2000);
+		for (auto &angle : angles)
+			angle.value = gen();
+
+		const pcs::angle_index index(angles);
+		for (int i = 0; i < 500; ++i)
+		{
+			const pcs::bam64 center{ .value = (i % 5 == 0) ? (gen() >> 60) : gen() };
+			const pcs::bam64 tolerance{ .value = gen() >> (1 + gen() % 16) };
+
+			std::vector<std::size_t> found;
+			index.payloads_in(index.within(center, tolerance), found);
+			std::sort(found.begin(), found.end());
+			CHECK_EQ(found, linear_within(angles, center, tolerance));
+		}
+	}
+}
@@ -0,0 +1,216 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "arc_set.hxx"
+
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+	// [start, end), the slow way
+	struct plain_arc
+	{
+		pcs::bam64 start;
+		pcs::bam64 end;
+
+		bool contains(pcs::bam64 angle) const noexcept		{ return (angle - start).value < (end - start).value; }
+	};
+
+	bool any_contains(const std::vector<plain_arc> &arcs, pcs::bam64 angle)
+	{
+		for (const auto &arc : arcs)
+		{
+			if (arc.contains(angle))
+				return true;
+		}
+
+		return false;
+	}
+
+	// arcs with ends on a grid of 256 steps, so the coverage is exact and the edges can be checked on both sides
+	constexpr unsigned long long step = 1ULL << 56;
+
+	std::vector<plain_arc> make_arcs(std::mt19937_64 &gen, std::size_t count)
+	{
+		std::vector<plain_arc> arcs(count);
+		for (auto &arc : arcs)
+		{
+			arc.start.value = (gen() & 0xff) * step;
+			arc.end.value = arc.start.value + (1 + gen() % 40) * step;
+		}
+
+		return arcs;
+	}
+
+	template <std::size_t N>
+	pcs::basic_arc_set<N> make_set(const std::vector<plain_arc> &arcs)
+	{
+		pcs::basic_arc_set<N> set;
+		for (const auto &arc : arcs)
+			set.add(arc.start, arc.end);
+
+		return set;
+	}
+
+	// the points at, just before, and just after each grid step
+	std::vector<pcs::bam64> grid_points()
+	{
+		std::vector<pcs::bam64> points;
+		for (unsigned long long i = 0; i < 256; ++i)
+		{
+			points.push_back({ .value = i * step });
+			points.push_back({ .value = i * step - 1 });
+			points.push_back({ .value = i * step + 1 });
+			points.push_back({ .value = i * step + step / 2 });
+		}
+
+		return points;
+	}
+
+	// the sorted intervals don't overlap or touch
+	template <std::size_t N>
+	bool normalized(const pcs::basic_arc_set<N> &set)
+	{
+		for (std::size_t i = 0; i < set.size(); ++i)
+		{
+			if (set[i].last < set[i].first)
+				return false;
+
+			if ((i > 0) && (set[i].first.value <= set[i - 1].last.value + 1))
+				return false;
+		}
+
+		return true;
+	}
+
+}	// namespace
+
+TEST_SUITE("test arc set")
+{
+	TEST_CASE("single arcs")
+	{
+		const pcs::arc_set east(pcs::bam64_from_degrees(45.0), pcs::bam64_from_degrees(135.0));
+		REQUIRE_EQ(east.size(), 1);
+		CHECK(east.contains(pcs::bam64_from_degrees(90.0)));
+		CHECK(east.contains(pcs::bam64_from_degrees(45.0)));
+		CHECK_FALSE(east.contains(pcs::bam64_from_degrees(135.0)));
+		CHECK_EQ(east.coverage(), doctest::Approx(0.25));
+
+		// across zero is two intervals
+		const pcs::arc_set north(pcs::bam64_from_degrees(315.0), pcs::bam64_from_degrees(45.0));
+		REQUIRE_EQ(north.size(), 2);
+		CHECK_EQ(north[0].first.value, 0);
+		CHECK_EQ(north[1].last.value, ~0ULL);
+		CHECK(north.contains(pcs::bam64{ .value = 0 }));
+		CHECK(north.contains(pcs::bam64{ .value = ~0ULL }));
+		CHECK_FALSE(north.contains(pcs::bam64_from_degrees(90.0)));
+		CHECK_EQ(north.coverage(), doctest::Approx(0.25));
+
+		// up to zero, and from zero
+		CHECK_EQ(pcs::arc_set(pcs::bam64{ .value = pcs::half }, pcs::bam64{ .value = 0 }).size(), 1);
+		CHECK_EQ(pcs::arc_set(pcs::bam64{ .value = 0 }, pcs::bam64{ .value = pcs::half }).size(), 1);
+
+		CHECK(pcs::arc_set(pcs::bam64_from_degrees(10.0), pcs::bam64_from_degrees(10.0)).empty());
+		CHECK(pcs::arc_set().complement().is_full());
+		CHECK(pcs::arc_set::full().complement().empty());
+		CHECK_EQ(pcs::arc_set::full().coverage(), 1.0);
+		CHECK_EQ(north.complement(), pcs::arc_set(pcs::bam64_from_degrees(45.0), pcs::bam64_from_degrees(315.0)));
+
+		// touching arcs merge, including across zero
+		pcs::arc_set halves(pcs::bam64{ .value = 0 }, pcs::bam64{ .value = pcs::half });
+		halves.add(pcs::bam64{ .value = pcs::half }, pcs::bam64{ .value = 0 });
+		CHECK(halves.is_full());
+	}
+
+	TEST_CASE("set operations match membership")
+	{
+		std::mt19937_64 gen(0xa2c5);
+		const auto points = grid_points();
+
+		for (int trial = 0; trial < 200; ++trial)
+		{
+			const auto a_arcs = make_arcs(gen, 1 + gen() % 12);
+			const auto b_arcs = make_arcs(gen, 1 + gen() % 12);
+
+			// a small inline capacity, so some of these spill to the heap
+			const auto a = make_set<2>(a_arcs);
+			const auto b = make_set<2>(b_arcs);
+			const auto either = a | b;
+			const auto both = a & b;
+			const auto only_a = a - b;
+			const auto not_a = a.complement();
+
+			// add() merges in place, which gives the same set as a union
+			pcs::basic_arc_set<2> unioned;
+			for (const auto &arc : a_arcs)
+				unioned |= pcs::basic_arc_set<2>(arc.start, arc.end);
+
+			CHECK_EQ(unioned, a);
+			CHECK(normalized(a));
+			CHECK(normalized(either));
+			CHECK(normalized(both));
+			CHECK(normalized(only_a));
+			CHECK(normalized(not_a));
+
+			std::size_t covered = 0;
+			for (const auto &point : points)
+			{
+				const bool in_a = any_contains(a_arcs, point);
+				const bool in_b = any_contains(b_arcs, point);
+				REQUIRE_EQ(a.contains(point), in_a);
+				REQUIRE_EQ(either.contains(point), in_a || in_b);
+				REQUIRE_EQ(both.contains(point), in_a && in_b);
+				REQUIRE_EQ(only_a.contains(point), in_a && !in_b);
+				REQUIRE_EQ(not_a.contains(point), !in_a);
+
+				if ((point.value % step == step / 2) && in_a)
+					++covered;
+			}
+
+			// the ends are on the grid, so this is exact
+			CHECK_EQ(a.coverage(), static_cast<double>(covered) / 256.0);
+			CHECK_EQ(a.coverage() + not_a.coverage(), 1.0);
+			CHECK_EQ(a.coverage(b), both.coverage());
+			CHECK_EQ(a.coverage(pcs::basic_arc_set<2>::full()), a.coverage());
+			CHECK_EQ(pcs::basic_arc_set<2>::full().coverage(a), a.coverage());
+
+			// the same set whatever the storage
+			const auto inline_a = make_set<64>(a_arcs);
+			REQUIRE_EQ(inline_a.size(), a.size());
+			for (std::size_t i = 0; i < a.size(); ++i)
+				CHECK_EQ(inline_a[i], a[i]);
+		}
+	}
+
+	TEST_CASE("algebra")
+	{
+		std::mt19937_64 gen(0x5e75);
+		for (int trial = 0; trial < 100; ++trial)
+		{
+			const auto a = make_set<8>(make_arcs(gen, 1 + gen() % 6));
+			const auto b = make_set<8>(make_arcs(gen, 1 + gen() % 6));
+
+			CHECK_EQ(a | b, b | a);
+			CHECK_EQ(a & b, b & a);
+			CHECK_EQ((a | b).complement(), a.complement() & b.complement());
+			CHECK_EQ((a - b) | (a & b), a);
+			CHECK((a - a).empty());
+			CHECK((a | a.complement()).is_full());
+
+			auto c = a;
+			c |= b;
+			c -= b;
+			CHECK_EQ(c, a - b);
+			c &= a;
+			CHECK_EQ(c, a - b);
+
+			c.clear();
+			CHECK(c.empty());
+		}
+	}
+}
@@ -0,0 +1,132 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "bam128.hxx"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "doctest.h"
+
+#if defined(PCS_HAS_BAM128)
+
+namespace
+{
+	// distance between two bam128 values, in units of 2^-128 turns. only good for small distances.
+	unsigned long long bam_distance(pcs::bam128 a, pcs::bam128 b)
+	{
+		const auto difference = static_cast<long long>(static_cast<unsigned long long>(a.value - b.value));
+		return static_cast<unsigned long long>((difference < 0) ? -difference : difference);
+	}
+
+}	// namespace
+
+TEST_SUITE("test bam128")
+{
+	TEST_CASE("builders")
+	{
+		CHECK_EQ(pcs::bam128_from_turns(pcs::dd_real(0.75)), pcs::bam128::from_words(pcs::three_fourths, 0));
+		CHECK_EQ(pcs::bam128_from_turns(pcs::dd_real(-0.25)), pcs::bam128::from_words(pcs::three_fourths, 0));
+		CHECK_EQ(pcs::bam128_from_turns(pcs::dd_real(12345.5)), pcs::bam128::from_words(pcs::half, 0));
+		CHECK_EQ(pcs::bam128_from_degrees(pcs::dd_real(-450.0)), pcs::bam128::from_words(pcs::three_fourths, 0));
+
+		// the low part of a dd_real reaches bits that a double can't
+		CHECK_EQ(pcs::bam128_from_turns(pcs::dd_real(0.5, 0x1p-100)), pcs::bam128::from_words(pcs::half, 1ULL << 28));
+		CHECK_EQ(pcs::bam128_from_turns(pcs::dd_real(0.5, -0x1p-128)), pcs::bam128::from_words(pcs::half - 1, ~0ULL));
+
+		// a third, with 106 bits from the dd_real division
+		const auto third = pcs::bam128_from_base(pcs::dd_real(1.0), pcs::dd_real(3.0));
+		CHECK_EQ(third.high_word(), 0x5555555555555555);
+		CHECK_EQ(third.low_word() >> 24, 0x5555555555);
+
+		// radians go through a double-double 2pi
+		const auto quarter = pcs::bam128_from_radians(pcs::dd_real(pcs::half_pi, 6.123233995736766e-17));
+		CHECK_LT(bam_distance(quarter, pcs::bam128::from_words(pcs::fourth, 0)), 1ULL << 26);
+
+		// nan and infinity give zero
+		CHECK_EQ(pcs::bam128_from_turns(pcs::dd_real(std::numeric_limits<double>::infinity())).value, 0);
+		CHECK_EQ(pcs::bam128_from_turns(pcs::dd_real(std::numeric_limits<double>::quiet_NaN())).value, 0);
+	}
+
+	TEST_CASE("bam64 conversions")
+	{
+		std::mt19937_64 gen(0xb128);
+		for (int i = 0; i < 1000; ++i)
+		{
+			const auto bam = pcs::bam64::from_bam_value(gen());
+			CHECK_EQ(pcs::bam128::from_bam64(bam).to_bam64(), bam);
+		}
+
+		// rounding to nearest, ties to even, wrapping at a full turn
+		CHECK_EQ(pcs::bam128::from_words(4, 0x8000000000000000).to_bam64().value, 4);
+		CHECK_EQ(pcs::bam128::from_words(5, 0x8000000000000000).to_bam64().value, 6);
+		CHECK_EQ(pcs::bam128::from_words(5, 0x8000000000000001).to_bam64().value, 6);
+		CHECK_EQ(pcs::bam128::from_words(~0ULL, ~0ULL).to_bam64().value, 0);
+		CHECK_EQ(pcs::bam128::from_words(~0ULL, ~0ULL).to_bam64(pcs::bam_rounding::truncate).value, ~0ULL);
+	}
+
+	TEST_CASE("fraction")
+	{
+		CHECK_EQ(pcs::bam128::from_words(pcs::three_fourths, 0).fraction()[0], 0.75);
+		CHECK_EQ(pcs::bam128::from_words(0, 1).fraction()[0], 0x1p-128);
+		CHECK_EQ(pcs::to_degrees(pcs::bam128::from_words(pcs::fourth, 0))[0], 90.0);
+
+		// always less than a full turn
+		const auto almost = pcs::bam128::from_words(~0ULL, ~0ULL).fraction();
+		CHECK_LT(almost[0], 1.0);
+		CHECK_GT(almost[1], 0.0);
+
+		// the round trip keeps 106 bits
+		std::mt19937_64 gen(0xf4ac);
+		unsigned long long worst = 0;
+		for (int i = 0; i < 10'000; ++i)
+		{
+			const auto bam = pcs::bam128::from_words(gen(), gen() >> (gen() % 64));
+			const unsigned long long distance = bam_distance(pcs::bam128_from_turns(pcs::to_fraction(bam)), bam);
+			worst = (distance > worst) ? distance : worst;
+		}
+		CHECK_LE(worst, 1ULL << 22);
+	}
+
+	TEST_CASE("phase accumulation")
+	{
+		// a third of a turn per step, which isn't a dyadic fraction. three steps are a whole turn.
+		const auto step128 = pcs::bam128_from_base(pcs::dd_real(1.0), pcs::dd_real(3.0));
+		const auto step64 = step128.to_bam64();
+
+		auto phase128 = pcs::bam128{ .value = 0 };
+		auto phase64 = pcs::bam64{ .value = 0 };
+		for (int i = 0; i < 3'000'000; ++i)
+		{
+			phase128 = phase128 + step128;
+			phase64 = phase64 + step64;
+		}
+
+		// bam64 is off by a unit every three steps, while bam128 is still exact to 64 bits
+		CHECK_EQ(phase128.to_bam64().value, 0);
+		CHECK_EQ(phase64.value, 0 - 1'000'000ULL);
+	}
+
+	TEST_CASE("operators")
+	{
+		const auto a = pcs::bam128::from_words(pcs::three_fourths, 7);
+		const auto b = pcs::bam128::from_words(pcs::half, 9);
+
+		CHECK_EQ(a + b, pcs::bam128::from_words(pcs::fourth, 16));
+		CHECK_EQ(b - a, pcs::bam128::from_words(pcs::three_fourths, 2));
+		CHECK_EQ(-a, pcs::bam128::from_words(pcs::fourth - 1, 0 - 7ULL));
+		CHECK_EQ(~a, -a);
+		CHECK_EQ(a.make_opposite(), pcs::bam128::from_words(pcs::fourth, 7));
+		CHECK_GT(a, b);
+
+		// usable at compile time
+		constexpr auto sum = pcs::bam128_from_turns(pcs::dd_real(0.5, 0x1p-100)) + pcs::bam128_from_degrees(pcs::dd_real(90.0));
+		static_assert(sum.high_word() == pcs::three_fourths);
+		static_assert(sum.low_word() == (1ULL << 28));
+	}
+}
+
+#endif
@@ -0,0 +1,1374 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "angle_index.hxx"
+#include "arc_set.hxx"
+#include "bam128.hxx"
+#include "circular_reduce.hxx"
+#include "circular_stats.hxx"
+#include "dd_real_simd.hxx"
+#include "bam64.hxx"
+#include "bam64_cordic.hxx"
+#include "bam64_simd.hxx"
+#include "bam64_trig.hxx"
+#include "nco.hxx"
+#include "periodic_frame_graph.hxx"
+#include "periodic_transform.hxx"
+#include "periodic_simd.hxx"
+#include "radix_sort.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "doctest.h"
+#include "nanobench.h"
+
+//
+// benchmarks for understanding implementation tradeoffs. these are skipped by default, so they
+// need to be asked for explicitly, e.g.:
+//
+//    periodic --no-skip --test-suite="bam64 benchmarks"
+//
+
+namespace
+{
+	constexpr std::size_t bench_size = 4096;
+
+	// uniformly distributed values in [-range, range)
+	std::vector<double> make_values(double range)
+	{
+		std::mt19937_64 gen(0x5eed);
+		std::uniform_real_distribution<double> dist(-range, range);
+
+		std::vector<double> values(bench_size);
+		for (auto &value : values)
+			value = dist(gen);
+
+		return values;
+	}
+
+	ankerl::nanobench::Bench make_bench(const char *title)
+	{
+		ankerl::nanobench::Bench bench;
+		bench.title(title).unit("value").batch(bench_size).relative(true).warmup(10).minEpochIterations(300);
+		return bench;
+	}
+
+}	// namespace
+
+TEST_SUITE("bam64 benchmarks" * doctest::skip())
+{
+	TEST_CASE("batch builders")
+	{
+		const auto degrees = make_values(720.0);
+		std::vector<pcs::bam64> bams(bench_size);
+
+		auto bench = make_bench("bam64_from_degrees");
+
+		bench.run("scalar loop", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams[i] = pcs::bam64_from_degrees(degrees[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		bench.run("span", [&]
+		{
+			pcs::bam64_from_degrees(degrees, bams);
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		const auto turns = make_values(1.5);
+		auto turn_bench = make_bench("bam64_from_turns");
+
+		turn_bench.run("scalar loop", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams[i] = pcs::bam64_from_turns(turns[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		turn_bench.run("span", [&]
+		{
+			pcs::bam64_from_turns(turns, bams);
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+	}
+
+	TEST_CASE("simd kernels")
+	{
+		const auto degrees = make_values(720.0);
+		std::vector<pcs::bam64> bams(bench_size);
+		std::vector<double> values(bench_size);
+
+		constexpr std::pair<pcs::simd::instruction_set, const char *> isas[] =
+		{
+			{ pcs::simd::instruction_set::scalar,	"scalar" },
+			{ pcs::simd::instruction_set::sse42,	"sse4.2" },
+			{ pcs::simd::instruction_set::avx2,		"avx2" },
+			{ pcs::simd::instruction_set::avx512,	"avx-512" }
+		};
+
+		auto from_bench = make_bench("simd::from_base (degrees)");
+		for (const auto &[isa, name] : isas)
+		{
+			if (isa <= pcs::simd::supported_instruction_set())
+			{
+				from_bench.run(name, [&]
+				{
+					pcs::simd::from_base(degrees, pcs::full_degrees, bams, isa);
+					ankerl::nanobench::doNotOptimizeAway(bams.data());
+				});
+			}
+		}
+
+		auto to_bench = make_bench("simd::to_base (degrees)");
+		for (const auto &[isa, name] : isas)
+		{
+			if (isa <= pcs::simd::supported_instruction_set())
+			{
+				to_bench.run(name, [&]
+				{
+					pcs::simd::to_base(bams, pcs::full_degrees, values, isa);
+					ankerl::nanobench::doNotOptimizeAway(values.data());
+				});
+			}
+		}
+	}
+
+	TEST_CASE("exact turns")
+	{
+		const auto turns = make_values(1.5);
+		std::vector<pcs::bam64> bams(bench_size);
+
+		auto bench = make_bench("bam64 from turns");
+
+		bench.run("bam64_from_turns", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams[i] = pcs::bam64_from_turns(turns[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		bench.run("bam64_from_turns_exact", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams[i] = pcs::bam64_from_turns_exact(turns[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		bench.run("bam64_from_turns_exact (nearest)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams[i] = pcs::bam64_from_turns_exact(turns[i], pcs::bam_rounding::nearest);
+
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+	}
+
+	TEST_CASE("precise radians")
+	{
+		const auto small_radians = make_values(100.0);
+		const auto large_radians = make_values(1.0e300);
+		std::vector<pcs::bam64> bams(bench_size);
+
+		// what the precise version is meant to replace -- long double only helps when it is wider than double
+		auto long_double_bam = [](double radians)
+		{
+			constexpr long double two_pi_l = 2.0L * std::numbers::pi_v<long double>;
+			long double fraction = std::fmod(static_cast<long double>(radians), two_pi_l) / two_pi_l;
+			if (fraction < 0.0L)	{ fraction += 1.0L; }
+			return pcs::bam64::from_bam_value(static_cast<unsigned long long>(fraction * 0x1p64L));
+		};
+
+		for (const auto *radians : { &small_radians, &large_radians })
+		{
+			auto bench = make_bench((radians == &small_radians) ? "radians in [-100, 100)" : "radians in [-1e300, 1e300)");
+
+			bench.run("bam64_from_radians", [&]
+			{
+				for (std::size_t i = 0; i < bench_size; ++i)
+					bams[i] = pcs::bam64_from_radians((*radians)[i]);
+
+				ankerl::nanobench::doNotOptimizeAway(bams.data());
+			});
+
+			bench.run("long double fmod", [&]
+			{
+				for (std::size_t i = 0; i < bench_size; ++i)
+					bams[i] = long_double_bam((*radians)[i]);
+
+				ankerl::nanobench::doNotOptimizeAway(bams.data());
+			});
+
+			bench.run("bam64_from_radians_precise", [&]
+			{
+				for (std::size_t i = 0; i < bench_size; ++i)
+					bams[i] = pcs::bam64_from_radians_precise((*radians)[i]);
+
+				ankerl::nanobench::doNotOptimizeAway(bams.data());
+			});
+		}
+	}
+
+	TEST_CASE("sincos")
+	{
+		std::vector<pcs::bam64> bams(bench_size);
+		pcs::bam64_from_degrees(make_values(720.0), bams);
+
+		std::vector<double> sines(bench_size);
+		std::vector<double> cosines(bench_size);
+
+		auto bench = make_bench("sine and cosine of a bam64");
+
+		bench.run("std::sin/std::cos of to_radians()", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+			{
+				const double radians = pcs::to_radians(bams[i]);
+				sines[i] = std::sin(radians);
+				cosines[i] = std::cos(radians);
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(sines.data());
+			ankerl::nanobench::doNotOptimizeAway(cosines.data());
+		});
+
+		constexpr std::pair<pcs::trig_accuracy, const char *> tiers[] =
+		{
+			{ pcs::trig_accuracy::precise,	"pcs::sincos (precise)" },
+			{ pcs::trig_accuracy::balanced,	"pcs::sincos (balanced)" },
+			{ pcs::trig_accuracy::fast,		"pcs::sincos (fast)" }
+		};
+
+		for (const auto &[accuracy, name] : tiers)
+		{
+			bench.run(name, [&]
+			{
+				for (std::size_t i = 0; i < bench_size; ++i)
+				{
+					const auto [s, c] = pcs::sincos(bams[i], accuracy);
+					sines[i] = s;
+					cosines[i] = c;
+				}
+
+				ankerl::nanobench::doNotOptimizeAway(sines.data());
+				ankerl::nanobench::doNotOptimizeAway(cosines.data());
+			});
+		}
+
+		bench.run("pcs::sincos span (precise)", [&]
+		{
+			pcs::sincos(bams, sines, cosines);
+			ankerl::nanobench::doNotOptimizeAway(sines.data());
+			ankerl::nanobench::doNotOptimizeAway(cosines.data());
+		});
+	}
+
+	TEST_CASE("cordic")
+	{
+		std::mt19937_64 gen(0xc0d1c);
+		std::vector<long long> xs(bench_size);
+		std::vector<long long> ys(bench_size);
+		for (std::size_t i = 0; i < bench_size; ++i)
+		{
+			xs[i] = static_cast<long long>(gen()) >> 24;
+			ys[i] = static_cast<long long>(gen()) >> 24;
+		}
+
+		std::vector<pcs::bam64> bams(bench_size);
+		pcs::bam64_from_degrees(make_values(720.0), bams);
+
+		std::vector<long long> out_x(bench_size);
+		std::vector<long long> out_y(bench_size);
+
+		// nanobench shows cycles per call where the hardware counters are available
+		auto atan2_bench = make_bench("atan2 to bam64");
+		atan2_bench.unit("call");
+
+		atan2_bench.run("bam64_from_radians(std::atan2())", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams[i] = pcs::bam64_from_radians(std::atan2(static_cast<double>(ys[i]), static_cast<double>(xs[i])));
+
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		atan2_bench.run("pcs::atan2_bam", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams[i] = pcs::atan2_bam(ys[i], xs[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		auto sincos_bench = make_bench("fixed point sine and cosine");
+		sincos_bench.unit("call");
+
+		sincos_bench.run("std::sin/std::cos of to_radians()", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+			{
+				const double radians = pcs::to_radians(bams[i]);
+				out_x[i] = static_cast<long long>(std::cos(radians) * 0x1p62);
+				out_y[i] = static_cast<long long>(std::sin(radians) * 0x1p62);
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(out_x.data());
+			ankerl::nanobench::doNotOptimizeAway(out_y.data());
+		});
+
+		sincos_bench.run("pcs::sincos_fixed", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+			{
+				const auto [s, c] = pcs::sincos_fixed(bams[i]);
+				out_x[i] = c;
+				out_y[i] = s;
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(out_x.data());
+			ankerl::nanobench::doNotOptimizeAway(out_y.data());
+		});
+
+		auto rotate_bench = make_bench("rotate an integer point");
+		rotate_bench.unit("call");
+
+		rotate_bench.run("double rotation of to_radians()", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+			{
+				const double radians = pcs::to_radians(bams[i]);
+				const double s = std::sin(radians);
+				const double c = std::cos(radians);
+				const auto x = static_cast<double>(xs[i]);
+				const auto y = static_cast<double>(ys[i]);
+				out_x[i] = std::llround(x * c - y * s);
+				out_y[i] = std::llround(x * s + y * c);
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(out_x.data());
+			ankerl::nanobench::doNotOptimizeAway(out_y.data());
+		});
+
+		rotate_bench.run("pcs::rotate", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+			{
+				const auto [x, y] = pcs::rotate(xs[i], ys[i], bams[i]);
+				out_x[i] = x;
+				out_y[i] = y;
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(out_x.data());
+			ankerl::nanobench::doNotOptimizeAway(out_y.data());
+		});
+	}
+
+	TEST_CASE("atan2")
+	{
+		const auto ys = make_values(100.0);
+		auto xs = make_values(100.0);
+		std::reverse(xs.begin(), xs.end());
+		std::vector<pcs::bam64> bams(bench_size);
+
+		auto bench = make_bench("heading of a vector as a bam64");
+
+		bench.run("bam64_from_radians(std::atan2())", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams[i] = pcs::bam64_from_radians(std::atan2(ys[i], xs[i]));
+
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		bench.run("pcs::bam64_atan2", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams[i] = pcs::bam64_atan2(ys[i], xs[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		constexpr std::pair<pcs::simd::instruction_set, const char *> isas[] =
+		{
+			{ pcs::simd::instruction_set::scalar,	"simd::atan2 (scalar)" },
+			{ pcs::simd::instruction_set::sse42,	"simd::atan2 (sse4.2)" },
+			{ pcs::simd::instruction_set::avx2,		"simd::atan2 (avx2)" },
+			{ pcs::simd::instruction_set::avx512,	"simd::atan2 (avx-512)" }
+		};
+
+		for (const auto &[isa, name] : isas)
+		{
+			if (isa <= pcs::simd::supported_instruction_set())
+			{
+				bench.run(name, [&]
+				{
+					pcs::simd::atan2(ys, xs, bams, isa);
+					ankerl::nanobench::doNotOptimizeAway(bams.data());
+				});
+			}
+		}
+	}
+
+	TEST_CASE("bam widths")
+	{
+		// the same wrapping add over arrays of each width. narrower bams fit more lanes in each simd register, when the
+		// compiler vectorizes the loop (e.g. -O3 or /O2).
+		auto bench = make_bench("add headings");
+
+		auto add_run = [&bench]<typename Bam>(const char *name, Bam)
+		{
+			std::vector<Bam> headings(bench_size);
+			std::vector<Bam> turns(bench_size);
+			Bam::from_base(make_values(720.0), pcs::full_degrees, headings);
+			Bam::from_base(make_values(10.0), pcs::full_degrees, turns);
+
+			bench.run(name, [&]
+			{
+				for (std::size_t i = 0; i < bench_size; ++i)
+					headings[i] = headings[i] + turns[i];
+
+				ankerl::nanobench::doNotOptimizeAway(headings.data());
+			});
+		};
+
+		add_run("bam64", pcs::bam64{});
+		add_run("bam32", pcs::bam32{});
+		add_run("bam16", pcs::bam16{});
+		add_run("bam8", pcs::bam8{});
+
+		std::vector<pcs::bam64> wide(bench_size);
+		std::vector<pcs::bam16> narrow(bench_size);
+		pcs::bam64_from_degrees(make_values(720.0), wide);
+
+		auto narrow_bench = make_bench("bam64 -> bam16");
+
+		narrow_bench.run("narrow (nearest)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				narrow[i] = wide[i].narrow<unsigned short>();
+
+			ankerl::nanobench::doNotOptimizeAway(narrow.data());
+		});
+
+		narrow_bench.run("narrow (truncate)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				narrow[i] = wide[i].narrow<unsigned short>(pcs::bam_rounding::truncate);
+
+			ankerl::nanobench::doNotOptimizeAway(narrow.data());
+		});
+	}
+
+	TEST_CASE("scaling")
+	{
+		std::vector<pcs::bam64> bams(bench_size);
+		std::vector<pcs::bam64> scaled(bench_size);
+		pcs::bam64_from_degrees(make_values(720.0), bams);
+
+		auto bench = make_bench("bam64 scaling");
+
+		bench.run("operator *(double)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				scaled[i] = bams[i] * 3.0;
+
+			ankerl::nanobench::doNotOptimizeAway(scaled.data());
+		});
+
+		bench.run("operator *(int)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				scaled[i] = bams[i] * 3;
+
+			ankerl::nanobench::doNotOptimizeAway(scaled.data());
+		});
+
+		bench.run("operator /(double)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				scaled[i] = bams[i] / 3.0;
+
+			ankerl::nanobench::doNotOptimizeAway(scaled.data());
+		});
+
+		bench.run("operator /(int)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				scaled[i] = bams[i] / 3;
+
+			ankerl::nanobench::doNotOptimizeAway(scaled.data());
+		});
+
+		bench.run("scale(2, 3)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				scaled[i] = bams[i].scale(2, 3);
+
+			ankerl::nanobench::doNotOptimizeAway(scaled.data());
+		});
+	}
+
+	TEST_CASE("forward_convert")
+	{
+		const auto degrees = make_values(720.0);
+		std::vector<double> outputs(bench_size);
+
+		auto bench = make_bench("forward_convert, degrees to [-180, 180)");
+
+		constexpr std::pair<pcs::simd::instruction_set, const char *> isas[] =
+		{
+			{ pcs::simd::instruction_set::scalar,	"simd::forward_convert (scalar)" },
+			{ pcs::simd::instruction_set::sse42,	"simd::forward_convert (sse4.2)" },
+			{ pcs::simd::instruction_set::avx2,		"simd::forward_convert (avx2)" },
+			{ pcs::simd::instruction_set::avx512,	"simd::forward_convert (avx-512)" }
+		};
+
+		bench.run("scalar forward_convert()", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				outputs[i] = pcs::forward_convert(degrees[i], 360.0, 90.0, -180.0, 360.0);
+
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+
+		bench.run("batch forward_convert()", [&]
+		{
+			pcs::forward_convert(degrees, outputs, 360.0, 90.0, -180.0, 360.0);
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+
+		for (const auto &[isa, name] : isas)
+		{
+			if (isa <= pcs::simd::supported_instruction_set())
+			{
+				bench.run(name, [&]
+				{
+					pcs::simd::forward_convert(degrees, outputs, 360.0, 90.0, -180.0, 360.0, isa);
+					ankerl::nanobench::doNotOptimizeAway(outputs.data());
+				});
+			}
+		}
+
+		bench.run("simd::forward_convert(), power of two period", [&]
+		{
+			pcs::simd::forward_convert(degrees, outputs, 512.0, 90.0, -180.0, 360.0);
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+	}
+
+	TEST_CASE("span rounding")
+	{
+		const auto values = make_values(1000.0);
+		std::vector<double> results(bench_size);
+
+		std::vector<float> float_values(values.begin(), values.end());
+		std::vector<float> float_results(bench_size);
+
+		auto bench = make_bench("cxcm rounding over spans");
+
+		bench.run("std::floor loop", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				results[i] = std::floor(values[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(results.data());
+		});
+
+		bench.run("cxcm::floor loop", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				results[i] = pcs::cxcm::floor(values[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(results.data());
+		});
+
+		constexpr std::pair<pcs::simd::instruction_set, const char *> isas[] =
+		{
+			{ pcs::simd::instruction_set::scalar,	"cxcm::floor span (scalar)" },
+			{ pcs::simd::instruction_set::sse42,	"cxcm::floor span (sse4.2)" },
+			{ pcs::simd::instruction_set::avx2,		"cxcm::floor span (avx2)" },
+			{ pcs::simd::instruction_set::avx512,	"cxcm::floor span (avx-512)" }
+		};
+
+		for (const auto &[isa, name] : isas)
+		{
+			if (isa <= pcs::simd::supported_instruction_set())
+			{
+				bench.run(name, [&]
+				{
+					pcs::cxcm::floor(values, results, isa);
+					ankerl::nanobench::doNotOptimizeAway(results.data());
+				});
+			}
+		}
+
+		bench.run("std::round loop", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				results[i] = std::round(values[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(results.data());
+		});
+
+		bench.run("cxcm::round span", [&]
+		{
+			pcs::cxcm::round(values, results);
+			ankerl::nanobench::doNotOptimizeAway(results.data());
+		});
+
+		bench.run("cxcm::fract loop", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				results[i] = pcs::cxcm::fract(values[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(results.data());
+		});
+
+		bench.run("cxcm::fract span", [&]
+		{
+			pcs::cxcm::fract(values, results);
+			ankerl::nanobench::doNotOptimizeAway(results.data());
+		});
+
+		bench.run("std::floor loop, float", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				float_results[i] = std::floor(float_values[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(float_results.data());
+		});
+
+		bench.run("cxcm::floor span, float", [&]
+		{
+			pcs::cxcm::floor(float_values, float_results);
+			ankerl::nanobench::doNotOptimizeAway(float_results.data());
+		});
+	}
+
+	TEST_CASE("compiled converter")
+	{
+		const auto degrees = make_values(720.0);
+		std::vector<double> outputs(bench_size);
+
+		const auto converter = pcs::forward_period_converter{ .input_period = 360.0, .output_period = pcs::two_pi, .input_origin = 1.0, .output_min = -pcs::pi };
+		const auto compiled = pcs::compiled_forward_converter(converter);
+
+		auto bench = make_bench("degrees to radians in [-pi, pi), per call");
+
+		bench.run("forward_period_converter", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				outputs[i] = converter(degrees[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+
+		bench.run("compiled_forward_converter", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				outputs[i] = compiled(degrees[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+
+		bench.run("compiled_forward_converter, batch", [&]
+		{
+			compiled.forward(degrees, outputs);
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+
+#if defined(PCS_STATIC_CONVERTERS)
+		constexpr auto fixed = pcs::static_forward_converter<360.0, pcs::two_pi, 1.0, -pcs::pi>{};
+
+		bench.run("static_forward_converter", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				outputs[i] = fixed(degrees[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+
+		// a power of two input period is a multiply
+		constexpr auto turns = pcs::static_forward_converter<1.0, 360.0, 0.0, -180.0>{};
+
+		bench.run("static_forward_converter, turns to degrees", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				outputs[i] = turns(degrees[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+#endif
+	}
+
+	TEST_CASE("periodic transform")
+	{
+		const auto degrees = make_values(180.0);
+		std::vector<double> outputs(bench_size);
+
+		std::vector<pcs::bam64> bams(bench_size);
+		pcs::simd::from_base(degrees, 360.0, bams);
+		std::vector<pcs::bam64> bam_outputs(bench_size);
+
+		// bearing to math, in degrees
+		const auto transform = pcs::periodic_transform::from_origin(-1, 90.0, 360.0, 360.0);
+		const auto converter = pcs::reverse_period_converter{ .input_period = 360.0, .output_period = 360.0, .input_origin = 90.0, .output_min = 0.0 };
+
+		auto bench = make_bench("bearing to math, per value");
+
+		bench.run("reverse_period_converter, batch", [&]
+		{
+			converter.forward(degrees, outputs);
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+
+		bench.run("periodic_transform::apply, bam64", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bam_outputs[i] = transform(bams[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(bam_outputs.data());
+		});
+
+		bench.run("periodic_transform::apply, bam64 batch", [&]
+		{
+			transform.apply(bams, bam_outputs);
+			ankerl::nanobench::doNotOptimizeAway(bam_outputs.data());
+		});
+	}
+
+	TEST_CASE("circular stats")
+	{
+		const auto degrees = make_values(180.0);
+		std::vector<pcs::bam64> bams(bench_size);
+		pcs::simd::from_base(degrees, 360.0, bams);
+
+		// samples per second on one core
+		auto bench = make_bench("circular statistics, per sample");
+
+		bench.run("circular_stats<>", [&]
+		{
+			pcs::circular_stats<> stats;
+			stats.add(bams);
+			ankerl::nanobench::doNotOptimizeAway(stats.mean());
+		});
+
+		bench.run("circular_stats<>, fast trig", [&]
+		{
+			pcs::circular_stats<> stats;
+			stats.add(bams, pcs::trig_accuracy::fast);
+			ankerl::nanobench::doNotOptimizeAway(stats.mean());
+		});
+
+		bench.run("compensated_circular_stats", [&]
+		{
+			pcs::compensated_circular_stats stats;
+			stats.add(bams);
+			ankerl::nanobench::doNotOptimizeAway(stats.mean());
+		});
+
+		// the window is full after the first run, so every sample is an add and a remove
+		pcs::sliding_circular_stats<> window(256);
+		bench.run("sliding_circular_stats<>, 256 samples", [&]
+		{
+			window.add(bams);
+			ankerl::nanobench::doNotOptimizeAway(window.mean());
+		});
+
+		pcs::sliding_circular_stats<true> compensated_window(256);
+		bench.run("sliding_circular_stats<true>, 256 samples", [&]
+		{
+			compensated_window.add(bams);
+			ankerl::nanobench::doNotOptimizeAway(compensated_window.mean());
+		});
+	}
+
+	TEST_CASE("circular reduce")
+	{
+		// 4M headings, which is 32 MB
+		constexpr std::size_t size = std::size_t{1} << 22;
+		std::vector<pcs::bam64> headings(size);
+		std::mt19937_64 gen(0x4ead);
+		for (auto &heading : headings)
+			heading.value = gen();
+
+		ankerl::nanobench::Bench bench;
+		bench.title("circular mean of 4M headings, per sample").unit("sample").batch(size).relative(true).warmup(1).minEpochIterations(3);
+
+		bench.run("compensated_circular_stats::add(), one thread", [&]
+		{
+			pcs::compensated_circular_stats stats;
+			stats.add(headings);
+			ankerl::nanobench::doNotOptimizeAway(stats.mean());
+		});
+
+		bench.run("circular_stats<>::add(), one thread", [&]
+		{
+			pcs::circular_stats<> stats;
+			stats.add(headings);
+			ankerl::nanobench::doNotOptimizeAway(stats.mean());
+		});
+
+		// 1, 2, 4, ... up to the number of cores
+		const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+		for (unsigned int threads = 1; threads < 2 * cores; threads *= 2)
+		{
+			const unsigned int used = std::min(threads, cores);
+			bench.run("circular_mean, " + std::to_string(used) + " thread(s)", [&]
+			{
+				ankerl::nanobench::doNotOptimizeAway(pcs::circular_mean(headings, used));
+			});
+
+			if (used == cores)
+				break;
+		}
+	}
+
+	TEST_CASE("angle index")
+	{
+		// 100k targets, and queries for everything within 5 degrees
+		constexpr std::size_t target_count = 100'000;
+		std::mt19937_64 gen(0x1de5);
+		std::vector<pcs::bam64> targets(target_count);
+		for (auto &target : targets)
+			target.value = gen();
+
+		std::vector<pcs::bam64> centers(bench_size);
+		for (auto &center : centers)
+			center.value = gen();
+
+		const auto tolerance = pcs::bam64_from_degrees(5.0);
+		const pcs::angle_index index(targets);
+
+		auto bench = make_bench("targets within 5 degrees of 100k, per query");
+		bench.minEpochIterations(3);
+
+		std::size_t found = 0;
+		bench.batch(64).run("linear scan with within_distance", [&]
+		{
+			for (std::size_t i = 0; i < 64; ++i)
+			{
+				for (const auto &target : targets)
+					found += pcs::within_distance(target, centers[i], tolerance) ? 1 : 0;
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(found);
+		});
+
+		bench.batch(bench_size).run("angle_index::within", [&]
+		{
+			for (const auto &center : centers)
+				found += index.within(center, tolerance).size();
+
+			ankerl::nanobench::doNotOptimizeAway(found);
+		});
+
+		auto build = make_bench("building an index of 100k, per angle");
+		build.batch(target_count).minEpochIterations(10);
+
+		build.run("angle_index", [&]
+		{
+			const pcs::angle_index built(targets);
+			ankerl::nanobench::doNotOptimizeAway(built.size());
+		});
+
+		build.run("std::sort of (angle, payload) pairs", [&]
+		{
+			std::vector<std::pair<unsigned long long, std::size_t>> pairs(target_count);
+			for (std::size_t i = 0; i < target_count; ++i)
+				pairs[i] = { targets[i].value, i };
+
+			std::sort(pairs.begin(), pairs.end());
+			ankerl::nanobench::doNotOptimizeAway(pairs.data());
+		});
+	}
+
+	TEST_CASE("arc set")
+	{
+		// the coverage of 8 sensors, each with a field of view of 20 to 60 degrees, and how much of it is inside a 90 degree
+		// sector, for many headings
+		constexpr std::size_t sensor_count = 8;
+		std::mt19937_64 gen(0xf0f);
+		std::uniform_real_distribution<double> width(20.0, 60.0);
+
+		std::vector<pcs::bam64> centers(sensor_count);
+		std::vector<pcs::bam64> half_widths(sensor_count);
+		for (std::size_t i = 0; i < sensor_count; ++i)
+		{
+			centers[i].value = gen();
+			half_widths[i] = pcs::bam64_from_degrees(width(gen) / 2);
+		}
+
+		std::vector<pcs::bam64> headings(bench_size);
+		for (auto &heading : headings)
+			heading.value = gen();
+
+		const pcs::arc_set sector(pcs::bam64_from_degrees(-45.0), pcs::bam64_from_degrees(45.0));
+
+		auto bench = make_bench("coverage of 8 sensor arcs inside a sector, per heading");
+		bench.minEpochIterations(10);
+
+		double total = 0.0;
+		bench.run("split, std::sort, and merge vector<pair>", [&]
+		{
+			std::vector<std::pair<unsigned long long, unsigned long long>> intervals;
+			for (const auto &heading : headings)
+			{
+				intervals.clear();
+				for (std::size_t i = 0; i < sensor_count; ++i)
+				{
+					const auto start = heading + centers[i] - half_widths[i];
+					const auto end = heading + centers[i] + half_widths[i];
+					if (start < end)
+					{
+						intervals.push_back({ start.value, end.value - 1 });
+					}
+					else
+					{
+						if (end.value != 0)
+							intervals.push_back({ 0, end.value - 1 });
+
+						intervals.push_back({ start.value, ~0ULL });
+					}
+				}
+
+				std::sort(intervals.begin(), intervals.end());
+
+				// clipped to the sector, which is [-45, 45) degrees
+				double covered = 0.0;
+				unsigned long long next = 0;
+				for (const auto &[first, last] : intervals)
+				{
+					const unsigned long long from = (first < next) ? next : first;
+					if (from > last)
+						continue;
+
+					for (const auto &part : sector)
+					{
+						const unsigned long long low = (from < part.first.value) ? part.first.value : from;
+						const unsigned long long high = (last < part.last.value) ? last : part.last.value;
+						if (low <= high)
+							covered += static_cast<double>(high - low) + 1.0;
+					}
+
+					if (last == ~0ULL)
+						break;
+
+					next = last + 1;
+				}
+
+				total += covered * 0x1p-64;
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(total);
+		});
+
+		bench.run("arc_set", [&]
+		{
+			for (const auto &heading : headings)
+			{
+				pcs::arc_set coverage;
+				for (std::size_t i = 0; i < sensor_count; ++i)
+					coverage.add(heading + centers[i] - half_widths[i], heading + centers[i] + half_widths[i]);
+
+				total += coverage.coverage(sector);
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(total);
+		});
+	}
+
+	TEST_CASE("nco")
+	{
+		// a 12.345678 MHz tone at 250 MS/s
+		std::vector<pcs::bam64> phases(bench_size);
+		std::vector<double> sines(bench_size);
+		std::vector<double> cosines(bench_size);
+		std::vector<std::complex<double>> phasors(bench_size);
+		pcs::nco tone(12'345'678, 250'000'000);
+
+		auto bench = make_bench("phases of a 12.345678 MHz tone at 250 MS/s, per sample");
+
+		pcs::bam64 phase{ .value = 0 };
+		bench.run("adding the increment in a loop", [&]
+		{
+			const pcs::bam64 increment = tone.increment();
+			pcs::bam64 running = phase;
+			for (auto &out : phases)
+			{
+				out = running;
+				running = running + increment;
+			}
+
+			phase = running;
+
+			ankerl::nanobench::doNotOptimizeAway(phases.data());
+		});
+
+		bench.run("nco::phases", [&]
+		{
+			tone.phases(phases);
+			ankerl::nanobench::doNotOptimizeAway(phases.data());
+		});
+
+		auto trig = make_bench("sines and cosines of the same tone, per sample");
+
+		double radians = 0.0;
+		const double radian_step = pcs::two_pi * 12'345'678.0 / 250'000'000.0;
+		trig.run("std::sin and std::cos of an accumulated double", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+			{
+				sines[i] = std::sin(radians);
+				cosines[i] = std::cos(radians);
+				radians = std::fmod(radians + radian_step, pcs::two_pi);
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(sines.data());
+			ankerl::nanobench::doNotOptimizeAway(cosines.data());
+		});
+
+		trig.run("pcs::sincos of each phase", [&]
+		{
+			const pcs::bam64 increment = tone.increment();
+			pcs::bam64 running = phase;
+			for (std::size_t i = 0; i < bench_size; ++i)
+			{
+				const auto [sin_value, cos_value] = pcs::sincos(running);
+				sines[i] = sin_value;
+				cosines[i] = cos_value;
+				running = running + increment;
+			}
+
+			phase = running;
+
+			ankerl::nanobench::doNotOptimizeAway(sines.data());
+			ankerl::nanobench::doNotOptimizeAway(cosines.data());
+		});
+
+		trig.run("nco::sincos", [&]
+		{
+			tone.sincos(sines, cosines);
+			ankerl::nanobench::doNotOptimizeAway(sines.data());
+			ankerl::nanobench::doNotOptimizeAway(cosines.data());
+		});
+
+		trig.run("nco::sincos, fast", [&]
+		{
+			tone.sincos(sines, cosines, pcs::trig_accuracy::fast);
+			ankerl::nanobench::doNotOptimizeAway(sines.data());
+			ankerl::nanobench::doNotOptimizeAway(cosines.data());
+		});
+
+		trig.run("nco::phasors", [&]
+		{
+			tone.phasors(phasors);
+			ankerl::nanobench::doNotOptimizeAway(phasors.data());
+		});
+	}
+
+	TEST_CASE("radix sort")
+	{
+		// each run copies the unsorted keys first, for every sort
+		std::mt19937_64 gen(0x5047);
+		const unsigned int threads = std::thread::hardware_concurrency();
+
+		for (std::size_t size = 1000; size <= 100'000'000; size *= 10)
+		{
+			std::vector<pcs::bam64> unsorted(size);
+			for (auto &key : unsorted)
+				key.value = gen();
+
+			std::vector<pcs::bam64> keys(size);
+
+			auto bench = make_bench(("sorting " + std::to_string(size) + " bams, per key").c_str());
+			bench.batch(size).warmup(1).minEpochIterations(1);
+			if (size >= 10'000'000)
+				bench.epochs(1);
+
+			bench.run("std::sort", [&]
+			{
+				std::copy(unsorted.begin(), unsorted.end(), keys.begin());
+				std::sort(keys.begin(), keys.end());
+				ankerl::nanobench::doNotOptimizeAway(keys.data());
+			});
+
+			bench.run("radix_sort", [&]
+			{
+				std::copy(unsorted.begin(), unsorted.end(), keys.begin());
+				pcs::radix_sort(keys);
+				ankerl::nanobench::doNotOptimizeAway(keys.data());
+			});
+
+			bench.run("parallel_radix_sort, " + std::to_string(threads) + " thread(s)", [&]
+			{
+				std::copy(unsorted.begin(), unsorted.end(), keys.begin());
+				pcs::parallel_radix_sort(keys);
+				ankerl::nanobench::doNotOptimizeAway(keys.data());
+			});
+		}
+	}
+
+	TEST_CASE("frame graph")
+	{
+		const auto radians = make_values(10.0);
+		std::vector<double> outputs(bench_size);
+
+		// sensor -> vehicle -> bearing -> math, as in the frame graph tests
+		pcs::periodic_frame_graph graph(360.0, -180.0);
+		const auto bearing = graph.add_frame(graph.root(), -1, 90.0, 360.0);
+		const auto vehicle = graph.add_frame(bearing, 1, 30.0, 360.0, -180.0);
+		const auto sensor = graph.add_frame(vehicle, -1, 45.0, pcs::two_pi, -pcs::pi);
+		graph.warm(sensor, graph.root());
+
+		auto bench = make_bench("sensor radians to math degrees, three frames up, per call");
+
+		bench.run("chained convert calls", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+			{
+				const double in_vehicle = pcs::reverse_convert(radians[i], pcs::two_pi, 45.0, -180.0, 360.0);
+				const double in_bearing = pcs::forward_convert(in_vehicle, 360.0, 30.0, 0.0, 360.0);
+				outputs[i] = pcs::reverse_convert(in_bearing, 360.0, 90.0, -180.0, 360.0);
+			}
+
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+
+		// a hash lookup for every value
+		bench.run("periodic_frame_graph::convert", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				outputs[i] = graph.convert(sensor, graph.root(), radians[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+
+		bench.run("frame_converter, batch", [&]
+		{
+			graph.converter(sensor, graph.root()).forward(radians, outputs);
+			ankerl::nanobench::doNotOptimizeAway(outputs.data());
+		});
+	}
+
+#if defined(PCS_HAS_BAM128)
+	TEST_CASE("bam128")
+	{
+		// phase accumulation, where bam128 costs a second add with carry
+		std::vector<pcs::bam64> steps64(bench_size);
+		pcs::bam64_from_turns(make_values(1.0), steps64);
+
+		std::vector<pcs::bam128> steps128(bench_size);
+		for (std::size_t i = 0; i < bench_size; ++i)
+			steps128[i] = pcs::bam128::from_words(steps64[i].value, steps64[i].value ^ 0x5555555555555555);
+
+		auto accumulate_bench = make_bench("phase accumulation");
+
+		accumulate_bench.run("bam64", [&]
+		{
+			auto phase = pcs::bam64{ .value = 0 };
+			for (const auto step : steps64)
+				phase = phase + step;
+
+			ankerl::nanobench::doNotOptimizeAway(phase);
+		});
+
+		accumulate_bench.run("bam128", [&]
+		{
+			auto phase = pcs::bam128{ .value = 0 };
+			for (const auto step : steps128)
+				phase = phase + step;
+
+			ankerl::nanobench::doNotOptimizeAway(phase);
+		});
+
+		// building from turns, where bam128 converts both parts of a dd_real
+		const auto turns = make_values(1000.0);
+		std::vector<pcs::dd_real> dd_turns(bench_size);
+		for (std::size_t i = 0; i < bench_size; ++i)
+			dd_turns[i] = pcs::dd_real(turns[i], turns[i] * 0x1p-60);
+
+		std::vector<pcs::bam64> bams64(bench_size);
+		std::vector<pcs::bam128> bams128(bench_size);
+
+		auto convert_bench = make_bench("convert");
+
+		convert_bench.run("bam64_from_turns_exact(double)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams64[i] = pcs::bam64_from_turns_exact(turns[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(bams64.data());
+		});
+
+		convert_bench.run("bam128_from_turns(dd_real)", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams128[i] = pcs::bam128_from_turns(dd_turns[i]);
+
+			ankerl::nanobench::doNotOptimizeAway(bams128.data());
+		});
+
+		convert_bench.run("bam128::to_bam64()", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				bams64[i] = bams128[i].to_bam64();
+
+			ankerl::nanobench::doNotOptimizeAway(bams64.data());
+		});
+
+		std::vector<double> fractions(bench_size);
+		std::vector<pcs::dd_real> dd_fractions(bench_size);
+
+		convert_bench.run("bam64::fraction()", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				fractions[i] = bams64[i].fraction();
+
+			ankerl::nanobench::doNotOptimizeAway(fractions.data());
+		});
+
+		convert_bench.run("bam128::fraction()", [&]
+		{
+			for (std::size_t i = 0; i < bench_size; ++i)
+				dd_fractions[i] = bams128[i].fraction();
+
+			ankerl::nanobench::doNotOptimizeAway(dd_fractions.data());
+		});
+	}
+#endif
+
+	TEST_CASE("float conversions")
+	{
+		const auto values = make_values(720.0);
+		std::vector<double> results(bench_size);
+		std::vector<pcs::bam64> bams(bench_size);
+
+		std::vector<float> float_values(values.begin(), values.end());
+		std::vector<float> float_results(bench_size);
+		std::vector<pcs::bam32> float_bams(bench_size);
+
+		auto bench = make_bench("double vs float conversions");
+
+		bench.run("forward_convert span (double)", [&]
+		{
+			pcs::forward_convert(values, results, 360.0, 90.0, -180.0, 360.0);
+			ankerl::nanobench::doNotOptimizeAway(results.data());
+		});
+
+		bench.run("forward_convert span (float)", [&]
+		{
+			pcs::forward_convert(float_values, float_results, 360.0f, 90.0f, -180.0f, 360.0f);
+			ankerl::nanobench::doNotOptimizeAway(float_results.data());
+		});
+
+		bench.run("simd::forward_convert (double)", [&]
+		{
+			pcs::simd::forward_convert(values, results, 360.0, 90.0, -180.0, 360.0);
+			ankerl::nanobench::doNotOptimizeAway(results.data());
+		});
+
+		bench.run("simd::forward_convert (float)", [&]
+		{
+			pcs::simd::forward_convert(float_values, float_results, 360.0f, 90.0f, -180.0f, 360.0f);
+			ankerl::nanobench::doNotOptimizeAway(float_results.data());
+		});
+
+		bench.run("simd::from_base (double to bam64)", [&]
+		{
+			pcs::simd::from_base(values, pcs::full_degrees, bams);
+			ankerl::nanobench::doNotOptimizeAway(bams.data());
+		});
+
+		bench.run("simd::from_base (float to bam32)", [&]
+		{
+			pcs::simd::from_base(float_values, 360.0f, float_bams);
+			ankerl::nanobench::doNotOptimizeAway(float_bams.data());
+		});
+	}
+
+	TEST_CASE("dd_real arrays")
+	{
+		// each add, multiply, or divide of two double-doubles is one flop, as is each value that sum() adds, so the
+		// flop/s column is the double-double equivalent of GFLOP/s
+		const auto a_his = make_values(720.0);
+		const auto b_his = make_values(3.0);
+		std::vector<double> a_los(bench_size);
+		std::vector<double> b_los(bench_size);
+		for (std::size_t i = 0; i < bench_size; ++i)
+		{
+			a_los[i] = a_his[i] * 0x1p-60;
+			b_los[i] = -b_his[i] * 0x1p-58;
+		}
+
+		std::vector<double> his(bench_size);
+		std::vector<double> los(bench_size);
+
+		const pcs::cxcm::dd_real::const_dd_real_array a{ .hi = a_his, .lo = a_los };
+		const pcs::cxcm::dd_real::const_dd_real_array b{ .hi = b_his, .lo = b_los };
+		const pcs::cxcm::dd_real::dd_real_array results{ .hi = his, .lo = los };
+
+		constexpr std::pair<pcs::simd::instruction_set, const char *> isas[] =
+		{
+			{ pcs::simd::instruction_set::scalar,	"scalar" },
+			{ pcs::simd::instruction_set::avx2,		"avx2" },
+			{ pcs::simd::instruction_set::avx512,	"avx-512" }
+		};
+
+		using binary_function = void (*)(pcs::cxcm::dd_real::const_dd_real_array, pcs::cxcm::dd_real::const_dd_real_array,
+										 pcs::cxcm::dd_real::dd_real_array, pcs::simd::instruction_set) noexcept;
+
+		constexpr std::pair<binary_function, const char *> operations[] =
+		{
+			{ pcs::cxcm::dd_real::add,		"dd_real add" },
+			{ pcs::cxcm::dd_real::multiply,	"dd_real multiply" },
+			{ pcs::cxcm::dd_real::divide,	"dd_real divide" }
+		};
+
+		for (const auto &[operation, title] : operations)
+		{
+			auto bench = make_bench(title);
+			bench.unit("flop");
+			for (const auto &[isa, name] : isas)
+			{
+				if (isa <= pcs::simd::supported_instruction_set())
+				{
+					bench.run(name, [&]
+					{
+						operation(a, b, results, isa);
+						ankerl::nanobench::doNotOptimizeAway(his.data());
+						ankerl::nanobench::doNotOptimizeAway(los.data());
+					});
+				}
+			}
+		}
+
+		auto sum_bench = make_bench("dd_real sum");
+		sum_bench.unit("flop");
+		for (const auto &[isa, name] : isas)
+		{
+			if (isa <= pcs::simd::supported_instruction_set())
+			{
+				sum_bench.run(name, [&]
+				{
+					ankerl::nanobench::doNotOptimizeAway(pcs::cxcm::dd_real::sum(a, isa));
+				});
+			}
+		}
+	}
+}
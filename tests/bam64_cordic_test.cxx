@@ -0,0 +1,225 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "bam64_cordic.hxx"
+#include "bam64_trig.hxx"
+#include "periodic.hxx"
+
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+#include "doctest.h"
+
+namespace
+{
+	// distance between two bam64 values, in bam64 units
+	long long bam_distance(pcs::bam64 a, pcs::bam64 b)
+	{
+		return std::llabs(static_cast<long long>(a.value - b.value));
+	}
+
+	// values spread over all magnitudes
+	long long random_coordinate(std::mt19937_64 &gen, int max_bits)
+	{
+		const auto magnitude = static_cast<long long>(gen() >> (64 - max_bits)) >> (gen() % static_cast<unsigned long long>(max_bits));
+		return (gen() & 1) ? -magnitude : magnitude;
+	}
+
+	using dd_real = pcs::cxcm::dd_real::dd_real;
+
+	inline constexpr dd_real dd_two_pi(6.283185307179586, 2.4492935982947064e-16);
+
+	dd_real negate(const dd_real &value)
+	{
+		return dd_real(-value.x[0], -value.x[1]);
+	}
+
+	// exact, since each half fits in a double
+	dd_real to_dd(long long value)
+	{
+		return dd_real(static_cast<double>(value >> 32) * 0x1p32) + static_cast<double>(value & 0xffffffffLL);
+	}
+
+	// sine and cosine of an angle in turns, to about 1e-32
+	dd_real sin_reference(const dd_real &turns, dd_real &cos_result)
+	{
+		// reduce to [-1/8, 1/8] turns and a quadrant
+		const double quadrant = std::nearbyint(turns.x[0] * 4.0);
+		const dd_real x = (turns - dd_real(quadrant * 0.25)) * dd_two_pi;
+		const dd_real x2 = x * x;
+
+		// taylor series, which converges quickly for |x| <= pi/4
+		dd_real s = x;
+		dd_real c(1.0);
+		dd_real sin_term = x;
+		dd_real cos_term(1.0);
+		for (int n = 2; n < 40; n += 2)
+		{
+			cos_term = negate(cos_term * x2 / dd_real(static_cast<double>(n * (n - 1))));
+			sin_term = negate(sin_term * x2 / dd_real(static_cast<double>(n * (n + 1))));
+			c = c + cos_term;
+			s = s + sin_term;
+		}
+
+		switch (static_cast<long long>(quadrant) & 3)
+		{
+			case 0:		cos_result = c;				return s;
+			case 1:		cos_result = negate(s);		return c;
+			case 2:		cos_result = negate(c);		return negate(s);
+			default:	cos_result = s;				return negate(c);
+		}
+	}
+
+	// a bam64 value as signed turns in [-1/2, 1/2), which is exact
+	dd_real bam_turns(pcs::bam64 value)
+	{
+		return to_dd(static_cast<long long>(value.value)) * 0x1p-64;
+	}
+
+	// the exact angle of (x, y), in turns, refined from the double atan2() by newton steps
+	dd_real atan2_reference(long long y, long long x)
+	{
+		const dd_real dd_x = to_dd(x);
+		const dd_real dd_y = to_dd(y);
+		dd_real turns(std::atan2(static_cast<double>(y), static_cast<double>(x)) / 6.283185307179586);
+
+		for (int i = 0; i < 2; ++i)
+		{
+			dd_real c;
+			const dd_real s = sin_reference(turns, c);
+
+			// tan() of the remaining angle, which is small enough to be the angle itself
+			turns = turns + ((dd_y * c - dd_x * s) / (dd_x * c + dd_y * s)) / dd_two_pi;
+		}
+
+		return turns;
+	}
+
+	// signed distance from value to reference, in bam64 units
+	double bam_error(pcs::bam64 value, const dd_real &reference)
+	{
+		const dd_real turns = bam_turns(value) - reference;
+		return static_cast<double>(turns - dd_real(std::nearbyint(turns.x[0]))) * 0x1p64;
+	}
+
+}	// namespace
+
+TEST_SUITE("bam64 cordic")
+{
+	TEST_CASE("angle table")
+	{
+		// reference values of atan(2^-i) / 2pi * 2^64, rounded to nearest
+		CHECK_EQ(pcs::detail::cordic_angles[0].value, 0x2000000000000000);
+		CHECK_EQ(pcs::detail::cordic_angles[1].value, 0x12e4051d9df30866);
+		CHECK_EQ(pcs::detail::cordic_angles[2].value, 0x09fb385b5ee39e8e);
+		CHECK_EQ(pcs::detail::cordic_angles[10].value, 0x000a2f980091ba7b);
+		CHECK_EQ(pcs::detail::cordic_angles[30].value, 0x00000000a2f9836e);
+		CHECK_EQ(pcs::detail::cordic_angles[60].value, 0x0000000000000003);
+		CHECK_EQ(pcs::detail::cordic_angles[61].value, 0x0000000000000001);
+	}
+
+	TEST_CASE("atan2_bam")
+	{
+		CHECK_EQ(pcs::atan2_bam(0, 0).value, 0ULL);
+		CHECK_EQ(pcs::atan2_bam(0, 5).value, pcs::none);
+		CHECK_EQ(pcs::atan2_bam(0, -5).value, pcs::half);
+		CHECK_EQ(pcs::atan2_bam(7, 7).value, pcs::eighth);
+		CHECK_EQ(pcs::atan2_bam(-7, -7).value, pcs::five_eighths);
+		CHECK_LE(bam_distance(pcs::atan2_bam(3, 0), pcs::bam64::from_bam_value(pcs::fourth)), 64);
+		CHECK_LE(bam_distance(pcs::atan2_bam(-3, 0), pcs::bam64::from_bam_value(pcs::three_fourths)), 64);
+
+		// the extremes don't overflow
+		CHECK_EQ(pcs::atan2_bam(LLONG_MIN, LLONG_MIN).value, pcs::five_eighths);
+		CHECK_LE(bam_distance(pcs::atan2_bam(LLONG_MIN, 0), pcs::bam64::from_bam_value(pcs::three_fourths)), 64);
+
+		// compared with a double-double reference
+		std::mt19937_64 gen(0xc0d1c);
+		double worst = 0.0;
+		for (int i = 0; i < 100'000; ++i)
+		{
+			const long long y = random_coordinate(gen, 63);
+			const long long x = random_coordinate(gen, 63);
+			if ((x == 0) && (y == 0))
+				continue;
+
+			worst = std::fmax(worst, std::fabs(bam_error(pcs::atan2_bam(y, x), atan2_reference(y, x))));
+		}
+		CHECK_LE(worst, 64.0);
+	}
+
+	TEST_CASE("sincos_fixed")
+	{
+		const auto zero = pcs::sincos_fixed(pcs::bam64::from_bam_value(pcs::none));
+		CHECK_LE(std::llabs(zero.sin), 64);
+		CHECK_LE(std::llabs(zero.cos - pcs::cordic_one), 64);
+
+		const auto three_fourths = pcs::sincos_fixed(pcs::bam64::from_bam_value(pcs::three_fourths));
+		CHECK_LE(std::llabs(three_fourths.sin + pcs::cordic_one), 64);
+		CHECK_LE(std::llabs(three_fourths.cos), 64);
+
+		std::mt19937_64 gen(0x51c05);
+		double worst = 0.0;
+		for (int i = 0; i < 100'000; ++i)
+		{
+			const auto bam = pcs::bam64::from_bam_value(gen());
+			const auto [s, c] = pcs::sincos_fixed(bam);
+
+			// compared with a double-double reference
+			dd_real ref_c;
+			const dd_real ref_s = sin_reference(bam_turns(bam), ref_c);
+			worst = std::fmax(worst, std::fabs(static_cast<double>(to_dd(s) - ref_s * 0x1p62)));
+			worst = std::fmax(worst, std::fabs(static_cast<double>(to_dd(c) - ref_c * 0x1p62)));
+		}
+		CHECK_LE(worst, 64.0);
+	}
+
+	TEST_CASE("rotate")
+	{
+		const auto quarter = pcs::rotate(1000, -20, pcs::bam64::from_bam_value(pcs::fourth));
+		CHECK_EQ(quarter.x, 20);
+		CHECK_EQ(quarter.y, 1000);
+
+		const auto sixth = pcs::rotate(1'000'000, 0, pcs::bam64::from_bam_value(pcs::sixth));
+		CHECK_EQ(sixth.x, 500'000);
+		CHECK_EQ(sixth.y, 866'025);
+
+		const auto origin = pcs::rotate(0, 0, pcs::bam64::from_bam_value(pcs::third));
+		CHECK_EQ(origin.x, 0);
+		CHECK_EQ(origin.y, 0);
+
+		// small enough that the double rotation is accurate to much better than a unit
+		std::mt19937_64 gen(0x4074);
+		double worst = 0.0;
+		for (int i = 0; i < 100'000; ++i)
+		{
+			const long long x = random_coordinate(gen, 40);
+			const long long y = random_coordinate(gen, 40);
+			const auto bam = pcs::bam64::from_bam_value(gen());
+			const auto [s, c] = pcs::sincos(bam);
+			const auto [rx, ry] = pcs::rotate(x, y, bam);
+
+			const double ex = static_cast<double>(x) * c - static_cast<double>(y) * s;
+			const double ey = static_cast<double>(x) * s + static_cast<double>(y) * c;
+			worst = std::fmax(worst, std::fmax(std::fabs(static_cast<double>(rx) - ex), std::fabs(static_cast<double>(ry) - ey)));
+		}
+		CHECK_LE(worst, 1.0);
+	}
+
+	TEST_CASE("constexpr")
+	{
+		constexpr auto angle = pcs::atan2_bam(1, 1);
+		static_assert(angle.value == pcs::eighth);
+
+		constexpr auto point = pcs::rotate(2, 0, pcs::bam64::from_bam_value(pcs::half));
+		static_assert((point.x == -2) && (point.y == 0));
+
+		constexpr auto values = pcs::sincos_fixed(pcs::bam64::from_bam_value(pcs::eighth));
+		static_assert(values.sin - values.cos < 64 && values.cos - values.sin < 64);
+
+		CHECK_EQ(angle.value, pcs::eighth);
+	}
+}
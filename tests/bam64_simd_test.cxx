@@ -0,0 +1,349 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "bam64_simd.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+	// a mix of values near the fundamental period, and values that are many periods away.
+	// an odd size makes sure the scalar tail is used by all the kernels.
+	std::vector<double> make_values(double base, std::size_t size = 10'001)
+	{
+		std::mt19937_64 gen(0xba64);
+		std::uniform_real_distribution<double> near_dist(-2.5 * base, 2.5 * base);
+		std::uniform_real_distribution<double> far_dist(-1.0e9 * base, 1.0e9 * base);
+
+		std::vector<double> values(size);
+		for (std::size_t i = 0; i < size; ++i)
+			values[i] = (i % 4 == 3) ? far_dist(gen) : near_dist(gen);
+
+		// exact multiples and some signed zeros
+		const double specials[] = { 0.0, -0.0, base, -base, 2.0 * base, -2.0 * base, 0.5 * base, -0.5 * base, 0.25 * base, 1.0e15 * base };
+		for (std::size_t i = 0; i < std::size(specials); ++i)
+			values[i * 7] = specials[i];
+
+		return values;
+	}
+
+	std::vector<pcs::bam64> make_bams(std::size_t size = 10'001)
+	{
+		std::mt19937_64 gen(0x64ba);
+
+		std::vector<pcs::bam64> bams(size);
+		for (auto &bam : bams)
+			bam.value = gen();
+
+		// values around the clamp in bam64::fraction(), and the extremes
+		const unsigned long long specials[] = { 0, 1, pcs::epsilon, pcs::half, 0xfffffffffffff7ff, 0xfffffffffffff800,
+												0xfffffffffffff801, 0xfffffffffffffc00, 0xfffffffffffffc01, 0xffffffffffffffff };
+		for (std::size_t i = 0; i < std::size(specials); ++i)
+			bams[i * 5].value = specials[i];
+
+		return bams;
+	}
+
+	constexpr double bases[] = { pcs::detail::turn_base, pcs::detail::minute_base, pcs::detail::degree_base, pcs::detail::radian_base, 100.0, 0.001 };
+
+}	// namespace
+
+TEST_SUITE("bam64 simd kernels")
+{
+	TEST_CASE("instruction set selection")
+	{
+		CHECK_UNARY(pcs::simd::detect_instruction_set() == pcs::simd::supported_instruction_set());
+
+		// scalar up to the supported one
+		const auto runnable = pcs::simd::runnable_instruction_sets();
+		CHECK_UNARY(runnable.front() == pcs::simd::instruction_set::scalar);
+		CHECK_UNARY(runnable.back() == pcs::simd::supported_instruction_set());
+		CHECK_EQ(runnable.size(), static_cast<std::size_t>(pcs::simd::supported_instruction_set()) + 1);
+
+		// asking for more than what is supported still works
+		std::vector<double> values = { 90.0 };
+		std::vector<pcs::bam64> bams(1);
+		pcs::simd::from_base(values, pcs::full_degrees, bams, pcs::simd::instruction_set::avx512);
+		CHECK_EQ(bams[0].value, pcs::fourth);
+
+		// base of zero, like bam64::from_base()
+		pcs::simd::from_base(values, 0.0, bams);
+		CHECK_EQ(bams[0].value, 0ULL);
+	}
+
+	TEST_CASE("from_base is bit-identical to scalar")
+	{
+		for (double base : bases)
+		{
+			const auto values = make_values(base);
+			std::vector<pcs::bam64> bams(values.size());
+
+			for (auto isa : pcs::simd::runnable_instruction_sets())
+			{
+				CAPTURE(base);
+				CAPTURE(static_cast<int>(isa));
+
+				pcs::simd::from_base(values, base, bams, isa);
+
+				std::size_t mismatches = 0;
+				for (std::size_t i = 0; i < values.size(); ++i)
+					mismatches += (bams[i] != pcs::bam64::from_base(values[i], base));
+
+				CHECK_EQ(mismatches, 0);
+			}
+		}
+	}
+
+	TEST_CASE("from_base_alt is bit-identical to scalar")
+	{
+		for (double base : bases)
+		{
+			const auto values = make_values(base);
+			std::vector<pcs::bam64> expected(values.size());
+			std::vector<pcs::bam64> bams(values.size());
+
+			pcs::simd::from_base_alt(values, base, expected, pcs::simd::instruction_set::scalar);
+
+			for (auto isa : pcs::simd::runnable_instruction_sets())
+			{
+				CAPTURE(base);
+				CAPTURE(static_cast<int>(isa));
+
+				pcs::simd::from_base_alt(values, base, bams, isa);
+
+				std::size_t mismatches = 0;
+				for (std::size_t i = 0; i < values.size(); ++i)
+					mismatches += (bams[i] != expected[i]) || ((bams[i].value & 0x7ff) != 0);
+
+				CHECK_EQ(mismatches, 0);
+			}
+		}
+	}
+
+	TEST_CASE("from_base for floats is bit-identical to scalar")
+	{
+		for (double wide_base : bases)
+		{
+			const float base = static_cast<float>(wide_base);
+			const auto wide_values = make_values(wide_base);
+			std::vector<float> values(wide_values.begin(), wide_values.end());
+
+			// the values that can trip up the float kernels
+			const float specials[] = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+									   -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::max(), -std::numeric_limits<float>::denorm_min(),
+									   -0x1p-30f * base, 0x1p23f * base, -0x1.fffffep22f * base, 0.5f * base, -0.5f * base };
+			for (std::size_t i = 0; i < std::size(specials); ++i)
+				values[i * 11 + 1] = specials[i];
+
+			std::vector<pcs::bam32> expected(values.size());
+			std::vector<pcs::bam32> bams(values.size());
+			pcs::bam32::from_base(values, base, expected);
+
+			for (auto isa : pcs::simd::runnable_instruction_sets())
+			{
+				CAPTURE(base);
+				CAPTURE(static_cast<int>(isa));
+
+				pcs::simd::from_base(values, base, bams, isa);
+
+				std::size_t mismatches = 0;
+				for (std::size_t i = 0; i < values.size(); ++i)
+					mismatches += (bams[i] != expected[i]);
+
+				CHECK_EQ(mismatches, 0);
+			}
+
+			// close to the double version, which only rounds once. the float product of the value and the reciprocal can be
+			// off by a float ulp of the turns, which is 2^9 bam32 units for each whole turn, so huge values aren't compared.
+			std::vector<double> doubles(values.begin(), values.end());
+			std::vector<pcs::bam32> wide(values.size());
+			pcs::bam32::from_base(doubles, static_cast<double>(base), wide);
+
+			std::size_t too_far = 0;
+			for (std::size_t i = 0; i < values.size(); ++i)
+			{
+				const double turns = std::abs(doubles[i] / base);
+				if (!(turns < 0x1p21))
+					continue;
+
+				const long long difference = std::abs(static_cast<long long>(static_cast<int>(expected[i].value - wide[i].value)));
+				too_far += (static_cast<double>(difference) > 4.0 + turns * 0x1p10);
+			}
+
+			CHECK_EQ(too_far, 0);
+		}
+
+		// a base of zero makes zero bams
+		std::vector<float> values(37, 1.0f);
+		std::vector<pcs::bam32> bams(values.size(), pcs::bam32{ .value = 1 });
+		pcs::simd::from_base(values, 0.0f, bams);
+		CHECK_UNARY(std::all_of(bams.begin(), bams.end(), [](pcs::bam32 bam) { return bam.value == 0; }));
+
+		// and one at a time
+		CHECK_EQ(pcs::bam32::from_base_float(90.0f, 360.0f).value, 0x40000000u);
+		CHECK_EQ(pcs::bam32::from_base_float(-90.0f, 360.0f).value, 0xc0000000u);
+		CHECK_EQ(pcs::bam32::from_base_float(1.0f, 0.0f).value, 0u);
+	}
+
+	TEST_CASE("to_base is bit-identical to scalar")
+	{
+		const auto bams = make_bams();
+		std::vector<double> values(bams.size());
+
+		for (double base : bases)
+		{
+			for (auto isa : pcs::simd::runnable_instruction_sets())
+			{
+				CAPTURE(base);
+				CAPTURE(static_cast<int>(isa));
+
+				pcs::simd::to_base(bams, base, values, isa);
+
+				std::size_t mismatches = 0;
+				for (std::size_t i = 0; i < bams.size(); ++i)
+					mismatches += (std::bit_cast<unsigned long long>(values[i]) != std::bit_cast<unsigned long long>(bams[i].fraction(base)));
+
+				CHECK_EQ(mismatches, 0);
+			}
+		}
+	}
+
+	TEST_CASE("to_base_alt is bit-identical to scalar")
+	{
+		const auto bams = make_bams();
+		std::vector<double> values(bams.size());
+
+		for (double base : bases)
+		{
+			for (auto isa : pcs::simd::runnable_instruction_sets())
+			{
+				CAPTURE(base);
+				CAPTURE(static_cast<int>(isa));
+
+				pcs::simd::to_base_alt(bams, base, values, isa);
+
+				std::size_t mismatches = 0;
+				for (std::size_t i = 0; i < bams.size(); ++i)
+					mismatches += (std::bit_cast<unsigned long long>(values[i]) != std::bit_cast<unsigned long long>(base * pcs::to_fraction_alt(bams[i].value)));
+
+				CHECK_EQ(mismatches, 0);
+			}
+		}
+	}
+
+	TEST_CASE("atan2 matches scalar")
+	{
+		std::mt19937_64 gen(0xa7a2);
+		std::uniform_real_distribution<double> dist(-100.0, 100.0);
+
+		std::vector<double> ys(10'001);
+		std::vector<double> xs(ys.size());
+		for (std::size_t i = 0; i < ys.size(); ++i)
+		{
+			ys[i] = dist(gen);
+			xs[i] = dist(gen);
+		}
+
+		// axes, diagonals, signed zeros, and the values that give 0
+		constexpr double inf = std::numeric_limits<double>::infinity();
+		constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+		const double specials[][2] = { { 0.0, 0.0 }, { -0.0, -0.0 }, { 0.0, -1.0 }, { -0.0, -1.0 }, { 1.0, 0.0 }, { -1.0, -0.0 },
+									   { 2.0, 2.0 }, { -2.0, 2.0 }, { 1.0, inf }, { inf, -1.0 }, { inf, inf }, { nan, 1.0 }, { 1.0, nan } };
+		for (std::size_t i = 0; i < std::size(specials); ++i)
+		{
+			ys[i * 3] = specials[i][0];
+			xs[i * 3] = specials[i][1];
+		}
+
+		std::vector<pcs::bam64> bams(ys.size());
+		for (auto isa : pcs::simd::runnable_instruction_sets())
+		{
+			CAPTURE(static_cast<int>(isa));
+
+			pcs::simd::atan2(ys, xs, bams, isa);
+
+			// identical unless the compiler fused the scalar multiply-adds
+			long long worst = 0;
+			for (std::size_t i = 0; i < ys.size(); ++i)
+			{
+				const long long difference = std::llabs(static_cast<long long>(bams[i].value - pcs::bam64_atan2(ys[i], xs[i]).value));
+				worst = (difference > worst) ? difference : worst;
+			}
+
+			CHECK_LT(worst, pcs::epsilon / 4);
+		}
+	}
+
+	TEST_CASE("sincos matches scalar")
+	{
+		auto bams = make_bams();
+
+		// quadrant boundaries, table entries, and halfway between entries
+		const unsigned long long specials[] = { pcs::fourth, pcs::three_fourths, pcs::fourth - 1, pcs::half + 1, 1ULL << 54, 3ULL << 53, (1ULL << 53) - 1 };
+		for (std::size_t i = 0; i < std::size(specials); ++i)
+			bams[i * 11 + 1].value = specials[i];
+
+		std::vector<double> sines(bams.size());
+		std::vector<double> cosines(bams.size());
+		for (auto accuracy : { pcs::trig_accuracy::fast, pcs::trig_accuracy::balanced, pcs::trig_accuracy::precise })
+		{
+			for (auto isa : pcs::simd::runnable_instruction_sets())
+			{
+				CAPTURE(static_cast<int>(accuracy));
+				CAPTURE(static_cast<int>(isa));
+
+				pcs::simd::sincos(bams, sines, cosines, accuracy, isa);
+
+				// identical unless the compiler fused the scalar multiply-adds
+				double worst = 0.0;
+				for (std::size_t i = 0; i < bams.size(); ++i)
+				{
+					const auto [sin_value, cos_value] = pcs::sincos(bams[i], accuracy);
+					worst = std::max({ worst, std::abs(sines[i] - sin_value), std::abs(cosines[i] - cos_value) });
+				}
+
+				CHECK_LE(worst, 0x1p-52);
+			}
+		}
+	}
+
+	TEST_CASE("ramp matches accumulation")
+	{
+		const pcs::bam64 start{ .value = 0xfedcba9876543210 };
+		const pcs::bam64 steps[] = { { .value = 0 }, { .value = 1 }, { .value = 0x9e3779b97f4a7c15 }, { .value = ~0ULL }, { .value = pcs::half } };
+
+		// sizes that leave every possible remainder for 8 lanes
+		for (std::size_t size : { 0, 1, 7, 8, 9, 100 })
+		{
+			std::vector<pcs::bam64> ramp(size);
+			for (const auto &step : steps)
+			{
+				for (auto isa : pcs::simd::runnable_instruction_sets())
+				{
+					CAPTURE(size);
+					CAPTURE(static_cast<int>(isa));
+
+					pcs::simd::ramp(start, step, ramp, isa);
+
+					pcs::bam64 phase = start;
+					for (std::size_t i = 0; i < size; ++i)
+					{
+						CHECK_EQ(ramp[i], phase);
+						phase = phase + step;
+					}
+				}
+			}
+		}
+	}
+}
@@ -5,6 +5,9 @@
 //          https://www.boost.org/LICENSE_1_0.txt)
 
 #include "bam64.hxx"
+#include <array>
+#include <limits>
+#include <random>
 
 //#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
@@ -51,6 +54,184 @@ TEST_SUITE("test bam64")
 		}
 	}
 
+	TEST_CASE("batch builders")
+	{
+		constexpr std::array<double, 9> turns = { -2.5, -1.0, -0.75, -0.1, 0.0, 0.1, 0.75, 1.0, 1234.5678 };
+		std::array<double, turns.size()> degrees{};
+		std::array<double, turns.size()> radians{};
+		for (std::size_t i = 0; i < turns.size(); ++i)
+		{
+			degrees[i] = turns[i] * pcs::full_degrees;
+			radians[i] = turns[i] * pcs::two_pi;
+		}
+
+		std::array<pcs::bam64, turns.size()> bams{};
+
+		SUBCASE("power of two base matches scalar exactly")
+		{
+			pcs::bam64_from_turns(turns, bams);
+			for (std::size_t i = 0; i < turns.size(); ++i)
+				CHECK_EQ(bams[i], pcs::bam64_from_turns(turns[i]));
+		}
+
+		SUBCASE("other bases are within a bam epsilon of scalar")
+		{
+			const auto tolerance = pcs::bam64::from_bam_value(pcs::epsilon);
+
+			pcs::bam64_from_degrees(degrees, bams);
+			for (std::size_t i = 0; i < turns.size(); ++i)
+				CHECK_UNARY(pcs::within_distance(bams[i], pcs::bam64_from_degrees(degrees[i]), tolerance));
+
+			pcs::bam64_from_radians(radians, bams);
+			for (std::size_t i = 0; i < turns.size(); ++i)
+				CHECK_UNARY(pcs::within_distance(bams[i], pcs::bam64_from_radians(radians[i]), tolerance));
+
+			pcs::bam64_from_base(degrees, pcs::full_degrees, bams);
+			for (std::size_t i = 0; i < turns.size(); ++i)
+				CHECK_UNARY(pcs::within_distance(bams[i], pcs::bam64_from_base(degrees[i], pcs::full_degrees), tolerance));
+		}
+
+		SUBCASE("zero base and mismatched sizes")
+		{
+			bams.fill(pcs::bam64::from_bam_value(pcs::half));
+			pcs::bam64_from_base(turns, 0.0, bams);
+			for (auto bam : bams)
+				CHECK_EQ(bam.value, 0ULL);
+
+			// only as many values as the smaller span are converted
+			bams.fill(pcs::bam64::from_bam_value(pcs::half));
+			pcs::bam64_from_turns(std::span(turns).first(2), bams);
+			CHECK_EQ(bams[1], pcs::bam64_from_turns(turns[1]));
+			CHECK_EQ(bams[2].value, pcs::half);
+		}
+
+		SUBCASE("constexpr")
+		{
+			constexpr auto batch = []()
+			{
+				std::array<double, 2> values = { 90.0, -90.0 };
+				std::array<pcs::bam64, 2> results{};
+				pcs::bam64_from_degrees(values, results);
+				return results;
+			}();
+
+			CHECK_EQ(batch[0].value, pcs::fourth);
+			CHECK_EQ(batch[1].value, pcs::three_fourths);
+		}
+	}
+
+	TEST_CASE("exact builders")
+	{
+		using pcs::bam_rounding;
+
+		SUBCASE("agrees with from_base() where it is exact")
+		{
+			constexpr double turns[] = { 0.0, 0.1, 0.25, 0.5, 0.75, 0.999, 1.25, 2.75, 12345.678, 0x1.fffffffffffffp-1 };
+			for (double t : turns)
+				CHECK_EQ(pcs::bam64_from_turns_exact(t), pcs::bam64_from_turns(t));
+
+			CHECK_EQ(pcs::bam64_from_turns_exact(-0.25).value, pcs::three_fourths);
+			CHECK_EQ(pcs::bam64_from_turns_exact(-2.5).value, pcs::half);
+			CHECK_EQ(pcs::bam64_from_turns_exact(-0.0).value, 0ULL);
+			CHECK_EQ(pcs::bam64_from_turns_exact(1.0e300).value, 0ULL);
+		}
+
+		SUBCASE("low bits are kept")
+		{
+			// from_base() loses these when adding 1.0 to a small negative fraction
+			CHECK_EQ(pcs::bam64_from_turns_exact(-0x1p-60).value, 0xfffffffffffffff0);
+			CHECK_EQ(pcs::bam64_from_turns_exact(0x1p-64).value, 1ULL);
+			CHECK_EQ(pcs::bam64_from_turns_exact(3.0 + 0x1p-64).value, 0ULL);	// the low bit doesn't fit in the double
+			CHECK_EQ(pcs::bam64_from_turns_exact(0.5 + 0x1p-53).value, 0x8000000000000800);
+		}
+
+		SUBCASE("rounding")
+		{
+			// below one bam unit
+			CHECK_EQ(pcs::bam64_from_turns_exact(0x1.8p-64).value, 1ULL);
+			CHECK_EQ(pcs::bam64_from_turns_exact(0x1.8p-64, bam_rounding::nearest).value, 2ULL);		// tie to even
+			CHECK_EQ(pcs::bam64_from_turns_exact(0x1.4p-64, bam_rounding::nearest).value, 1ULL);
+			CHECK_EQ(pcs::bam64_from_turns_exact(0x1.4p-63, bam_rounding::nearest).value, 2ULL);		// 2.5 ties to 2
+			CHECK_EQ(pcs::bam64_from_turns_exact(0x1.cp-63, bam_rounding::nearest).value, 4ULL);		// 3.5 ties to 4
+			CHECK_EQ(pcs::bam64_from_turns_exact(0x1p-70, bam_rounding::nearest).value, 0ULL);
+			CHECK_EQ(pcs::bam64_from_turns_exact(0x1p-1074, bam_rounding::nearest).value, 0ULL);		// smallest subnormal
+
+			// truncation is towards negative infinity
+			CHECK_EQ(pcs::bam64_from_turns_exact(-0x1p-70).value, 0xffffffffffffffff);
+			CHECK_EQ(pcs::bam64_from_turns_exact(-0x1p-1074).value, 0xffffffffffffffff);
+			CHECK_EQ(pcs::bam64_from_turns_exact(-0x1p-70, bam_rounding::nearest).value, 0ULL);
+			CHECK_EQ(pcs::bam64_from_turns_exact(-0x1.8p-64, bam_rounding::nearest).value, 0xfffffffffffffffe);
+		}
+
+		SUBCASE("power of two bases and special values")
+		{
+			CHECK_EQ(pcs::bam64::from_pow2_base_exact(8.0, 4).value, pcs::half);
+			CHECK_EQ(pcs::bam64::from_pow2_base_exact(-1.0, 2).value, pcs::three_fourths);
+			CHECK_EQ(pcs::bam64::from_pow2_base_exact(1.25, -1).value, pcs::half);
+
+			CHECK_EQ(pcs::bam64_from_turns_exact(std::numeric_limits<double>::infinity()).value, 0ULL);
+			CHECK_EQ(pcs::bam64_from_turns_exact(std::numeric_limits<double>::quiet_NaN()).value, 0ULL);
+
+			constexpr auto three_quarters = pcs::bam64_from_turns_exact(-1.25);
+			CHECK_EQ(three_quarters.value, pcs::three_fourths);
+		}
+	}
+
+	TEST_CASE("precise radians")
+	{
+		using pcs::bam_rounding;
+
+		struct expected_bams
+		{
+			double radians;
+			unsigned long long truncated;
+			unsigned long long nearest;
+		};
+
+		// reference values computed with arbitrary precision arithmetic
+		constexpr expected_bams references[] =
+		{
+			{ 1.0,						0x28be60db9391054a, 0x28be60db9391054a },
+			{ 3.141592653589793,		0x7ffffffffffffe98, 0x7ffffffffffffe98 },
+			{ 6.283185307179586,		0xfffffffffffffd30, 0xfffffffffffffd31 },
+			{ -0.5,						0xeba0cf9236377d5a, 0xeba0cf9236377d5b },
+			{ -1e-10,					0xffffffffee802fc5, 0xffffffffee802fc6 },
+			{ 0x1p-60,					0x0000000000000002, 0x0000000000000003 },
+			{ 2.5e-300,					0x0000000000000000, 0x0000000000000000 },
+			{ -2.5e-300,				0xffffffffffffffff, 0x0000000000000000 },
+			{ 5e-324,					0x0000000000000000, 0x0000000000000000 },
+			{ 123456.789,				0xc21b34465f00376d, 0xc21b34465f00376e },
+			{ 1000000000000000.2,		0x60248b4dac167ec4, 0x60248b4dac167ec4 },
+			{ 1e22,						0xd66f29ef84bc90cc, 0xd66f29ef84bc90cd },
+			{ 1e300,					0xa705623b8bf4109d, 0xa705623b8bf4109e },
+			{ -1e300,					0x58fa9dc4740bef62, 0x58fa9dc4740bef62 },
+			{ 1.7976931348623157e308,	0x7fcc3ea616b1ae40, 0x7fcc3ea616b1ae41 }
+		};
+
+		for (const auto &reference : references)
+		{
+			CAPTURE(reference.radians);
+			CHECK_EQ(pcs::bam64_from_radians_precise(reference.radians).value, reference.truncated);
+			CHECK_EQ(pcs::bam64_from_radians_precise(reference.radians, bam_rounding::nearest).value, reference.nearest);
+		}
+
+		// close to the regular conversion for small values
+		const auto tolerance = pcs::bam64::from_bam_value(4 * pcs::epsilon);
+		for (double radians = -20.0; radians < 20.0; radians += 0.37)
+			CHECK_UNARY(pcs::within_distance(pcs::bam64_from_radians_precise(radians), pcs::bam64_from_radians(radians), tolerance));
+
+		CHECK_EQ(pcs::bam64_from_radians_precise(std::numeric_limits<double>::infinity()).value, 0ULL);
+		CHECK_EQ(pcs::bam64_from_radians_precise(std::numeric_limits<double>::quiet_NaN()).value, 0ULL);
+
+		constexpr auto one_radian = pcs::bam64_from_radians_precise(1.0);
+		CHECK_EQ(one_radian.value, 0x28be60db9391054a);
+
+		// 64x64 -> 128 multiply
+		unsigned long long high = 0;
+		CHECK_EQ(pcs::detail::umul128(0xffffffffffffffff, 0xffffffffffffffff, high), 1ULL);
+		CHECK_EQ(high, 0xfffffffffffffffe);
+	}
+
 	TEST_CASE("bam value")
 	{
 		auto val1 = pcs::bam64::from_bam_value(pcs::fifth);
@@ -126,6 +307,60 @@ TEST_SUITE("test bam64")
 		CHECK_EQ(a / 4, pcs::bam64_from_degrees(15.0));
 	}
 
+	TEST_CASE("exact scaling")
+	{
+		// 128-bit / 64-bit divide
+		unsigned long long remainder = 0;
+		CHECK_EQ(pcs::detail::udiv128(2, 5, 3, remainder), 0xaaaaaaaaaaaaaaacULL);
+		CHECK_EQ(remainder, 1ULL);
+
+		const auto third = pcs::bam64::from_bam_value(0x5555555555555555);
+		CHECK_EQ(third.scale(3, 1).value, 0xffffffffffffffff);
+		CHECK_EQ(third.scale(6, 2).value, 0xffffffffffffffff);
+		CHECK_EQ(third.scale(1, 3).value, 0x1c71c71c71c71c72);
+		CHECK_EQ(third.scale(1, 3, pcs::bam_rounding::truncate).value, 0x1c71c71c71c71c71);
+		CHECK_EQ(third.scale(5, 0).value, 0ULL);
+
+		// whole periods wrap away, even with a huge numerator
+		CHECK_EQ(pcs::bam64::from_bam_value(pcs::fourth).scale(0xfffffffffffffffe, 3).value, 0x2aaaaaaaaaaaaaabULL);
+
+		// ties round to even
+		CHECK_EQ(pcs::bam64::from_bam_value(5).scale(1, 2).value, 2ULL);
+		CHECK_EQ(pcs::bam64::from_bam_value(7).scale(1, 2).value, 4ULL);
+
+		// scaling back and forth is exact, where the double versions drift
+		std::mt19937_64 gen(0x5ca1e);
+		for (int i = 0; i < 1000; ++i)
+		{
+			const auto bam = pcs::bam64::from_bam_value(gen() >> 8);
+			auto scaled = bam;
+			for (unsigned long long n = 2; n < 10; ++n)
+				scaled = scaled.scale(n, 1).scale(1, n);
+
+			CHECK_EQ(scaled, bam);
+		}
+
+		// integer operators wrap around
+		const auto a = pcs::bam64::from_bam_value(pcs::three_fourths + 1);
+		CHECK_EQ((a * 3).value, pcs::fourth + 3);
+		CHECK_EQ((a * -1), -a);
+		CHECK_EQ((3ULL * a), (a * 3));
+		CHECK_EQ((a / 3).value, 0x4000000000000000ULL);
+		CHECK_EQ((a / -3), -(a / 3));
+		CHECK_EQ((a / 0).value, 0ULL);
+
+		// narrow widths too
+		const auto b = pcs::bam16::from_bam_value(0x5555);
+		CHECK_EQ(b.scale(3, 1).value, 0xffff);
+		CHECK_EQ((b * 7).value, 0x5553);
+		CHECK_EQ((b / 5U).value, 0x1111);
+
+		// usable at compile time
+		constexpr auto sixth = pcs::bam64::from_bam_value(pcs::half).scale(1, 3);
+		static_assert(sixth.value == 0x2aaaaaaaaaaaaaab);
+		CHECK_EQ(sixth.value, 0x2aaaaaaaaaaaaaab);
+	}
+
 	TEST_CASE("comparisons")
 	{
 		// ordering and equality
@@ -151,4 +386,89 @@ TEST_SUITE("test bam64")
 		CHECK_UNARY(e == f);						// in this case, raw values don't differ while they represent the same angle
 		CHECK_UNARY(pcs::within_distance(e, f, pcs::bam64::from_bam_value(pcs::epsilon)));
 	}
+
+	TEST_CASE("bam widths")
+	{
+		SUBCASE("builders")
+		{
+			CHECK_EQ(pcs::bam8::from_base(45.0, pcs::full_degrees).value, 0x20);
+			CHECK_EQ(pcs::bam16::from_base(-90.0, pcs::full_degrees).value, 0xc000);
+			CHECK_EQ(pcs::bam32::from_base(120.0, pcs::full_degrees).value, 0x55555555);
+			CHECK_EQ(pcs::bam16::from_turns_exact(0.25).value, 0x4000);
+			CHECK_EQ(pcs::bam16::from_turns_exact(-0.25).value, 0xc000);
+			CHECK_EQ(pcs::bam16::from_turns_exact(0x1.0003p-2).value, 0x4000);
+			CHECK_EQ(pcs::bam16::from_turns_exact(0x1.0003p-2, pcs::bam_rounding::nearest).value, 0x4001);
+			CHECK_EQ(pcs::bam16::from_pow2_base_exact(96.0, 7).value, 0xc000);
+
+			constexpr std::array<double, 4> degrees = { -90.0, 0.0, 45.0, 721.0 };
+			std::array<pcs::bam16, degrees.size()> bams{};
+			pcs::bam16::from_base(degrees, pcs::full_degrees, bams);
+			for (std::size_t i = 0; i < degrees.size(); ++i)
+				CHECK_EQ(bams[i], pcs::bam16::from_base(degrees[i], pcs::full_degrees));
+		}
+
+		SUBCASE("properties")
+		{
+			// every narrow value is exact as a double, right up to a full period
+			CHECK_EQ(pcs::bam16::from_bam_value(0xffff).fraction(), 65535.0 / 65536.0);
+			CHECK_EQ(pcs::bam32::from_bam_value(0x40000000).fraction(pcs::full_degrees), 90.0);
+			CHECK_EQ(pcs::bam16::from_bam_value(0x4000).complement(pcs::full_degrees), 270.0);
+			CHECK_EQ(pcs::bam16::from_bam_value(0x4000).opposite(pcs::full_degrees), 270.0);
+			CHECK_EQ(pcs::bam16::from_bam_value(0xc000).normal(pcs::full_degrees), -90.0);
+			CHECK_EQ(pcs::bam8::from_bam_value(0x80).normal(pcs::full_degrees), 180.0);
+		}
+
+		SUBCASE("operators")
+		{
+			const auto a = pcs::bam16::from_bam_value(0xf000);
+			const auto b = pcs::bam16::from_bam_value(0x2000);
+
+			CHECK_EQ((a + b).value, 0x1000);
+			CHECK_EQ((b - a).value, 0x3000);
+			CHECK_EQ((-b).value, 0xe000);
+			CHECK_EQ((~b).value, 0xe000);
+			CHECK_EQ(b.make_opposite().value, 0xa000);
+			CHECK_EQ((b * 3).value, 0x6000);
+			CHECK_EQ((b / 2).value, 0x1000);
+			CHECK_EQ((-pcs::bam8::from_bam_value(0)).value, 0);
+
+			CHECK_UNARY(pcs::bam16::from_bam_value(0xfffe).within_tolerance(pcs::bam16::from_bam_value(2)));
+			CHECK_UNARY(!pcs::bam16::from_bam_value(0xfffd).within_tolerance(pcs::bam16::from_bam_value(2)));
+			CHECK_UNARY(pcs::within_distance(a, b, pcs::bam16::from_bam_value(0x3000)));
+			CHECK_UNARY(a > b);
+		}
+
+		SUBCASE("widening and narrowing")
+		{
+			CHECK_EQ(pcs::bam16::from_bam_value(0x4000).widen<unsigned long long>().value, pcs::fourth);
+			CHECK_EQ(pcs::bam8::from_bam_value(0xab).widen<unsigned int>().value, 0xab000000);
+			CHECK_EQ(pcs::bam8::from_bam_value(0xab).widen<unsigned char>().value, 0xab);
+
+			const auto third = pcs::bam64::from_bam_value(pcs::third);
+			CHECK_EQ(third.narrow<unsigned short>().value, 0x5555);
+			CHECK_EQ(third.narrow<unsigned char>().value, 0x55);
+			CHECK_EQ(pcs::bam64::from_bam_value(pcs::two_thirds).narrow<unsigned short>().value, 0xaaab);
+			CHECK_EQ(pcs::bam64::from_bam_value(pcs::two_thirds).narrow<unsigned short>(pcs::bam_rounding::truncate).value, 0xaaaa);
+
+			// ties to even, and wrapping around from just below a full period
+			CHECK_EQ(pcs::bam32::from_bam_value(0x00008000).narrow<unsigned short>().value, 0x0000);
+			CHECK_EQ(pcs::bam32::from_bam_value(0x00018000).narrow<unsigned short>().value, 0x0002);
+			CHECK_EQ(pcs::bam32::from_bam_value(0x00018001).narrow<unsigned short>().value, 0x0002);
+			CHECK_EQ(pcs::bam32::from_bam_value(0x00017fff).narrow<unsigned short>().value, 0x0001);
+			CHECK_EQ(pcs::bam64::from_bam_value(0xffffffffffffffff).narrow<unsigned short>().value, 0x0000);
+			CHECK_EQ(pcs::bam64::from_bam_value(0xffffffffffffffff).narrow<unsigned short>(pcs::bam_rounding::truncate).value, 0xffff);
+
+			// widening is lossless, so narrowing gets the original back
+			for (unsigned int value = 0; value <= 0xffff; value += 0x101)
+			{
+				const auto original = pcs::bam16::from_bam_value(static_cast<unsigned short>(value));
+				CHECK_EQ(original.widen<unsigned long long>().narrow<unsigned short>(), original);
+				CHECK_EQ(original.widen<unsigned int>().narrow<unsigned short>(pcs::bam_rounding::truncate), original);
+			}
+
+			// usable at compile time
+			constexpr auto narrowed = pcs::bam64::from_bam_value(pcs::eighth).narrow<unsigned char>();
+			static_assert(narrowed.value == 0x20);
+		}
+	}
 }
@@ -0,0 +1,162 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "bam64_cordic.hxx"
+#include "bam64_trig.hxx"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+	// reference sine and cosine. the angle is reduced to within 1/8 turn of a quadrant boundary in bam space first,
+	// so the conversion to radians only rounds a small value, and the standard library gets an accurate argument.
+	pcs::sin_cos reference_sincos(pcs::bam64 bam)
+	{
+		const unsigned long long nearest_quadrant = (bam.value + 0x2000000000000000) & 0xc000000000000000;
+		const double offset = static_cast<double>(static_cast<long long>(bam.value - nearest_quadrant)) * pcs::detail::radians_per_bam;
+		const double s = std::sin(offset);
+		const double c = std::cos(offset);
+
+		switch (nearest_quadrant >> 62)
+		{
+			case 1:		return { c, -s };
+			case 2:		return { -s, -c };
+			case 3:		return { -c, s };
+			default:	return { s, c };
+		}
+	}
+
+	std::vector<pcs::bam64> random_bams(std::size_t count)
+	{
+		std::mt19937_64 gen(0x7419);
+		std::vector<pcs::bam64> bams(count);
+		for (auto &bam : bams)
+			bam.value = gen();
+
+		return bams;
+	}
+
+	double max_error(const std::vector<pcs::bam64> &bams, pcs::trig_accuracy accuracy)
+	{
+		double error = 0.0;
+		for (auto bam : bams)
+		{
+			const auto [s, c] = pcs::sincos(bam, accuracy);
+			const auto [ref_s, ref_c] = reference_sincos(bam);
+			error = std::fmax(error, std::fmax(std::fabs(s - ref_s), std::fabs(c - ref_c)));
+		}
+
+		return error;
+	}
+
+}	// namespace
+
+TEST_SUITE("bam64 trig")
+{
+	TEST_CASE("exact angles")
+	{
+		CHECK_EQ(pcs::sin(pcs::bam64::from_bam_value(pcs::none)), 0.0);
+		CHECK_EQ(pcs::cos(pcs::bam64::from_bam_value(pcs::none)), 1.0);
+		CHECK_EQ(pcs::sin(pcs::bam64::from_bam_value(pcs::fourth)), 1.0);
+		CHECK_EQ(pcs::cos(pcs::bam64::from_bam_value(pcs::fourth)), 0.0);
+		CHECK_EQ(pcs::sin(pcs::bam64::from_bam_value(pcs::half)), 0.0);
+		CHECK_EQ(pcs::cos(pcs::bam64::from_bam_value(pcs::half)), -1.0);
+		CHECK_EQ(pcs::sin(pcs::bam64::from_bam_value(pcs::three_fourths)), -1.0);
+		CHECK_EQ(pcs::cos(pcs::bam64::from_bam_value(pcs::three_fourths)), 0.0);
+
+		CHECK_EQ(pcs::sin(pcs::bam64::from_bam_value(pcs::twelfth)), doctest::Approx(0.5).epsilon(1e-15));
+		CHECK_EQ(pcs::cos(pcs::bam64::from_bam_value(pcs::sixth)), doctest::Approx(0.5).epsilon(1e-15));
+
+		// usable at compile time
+		constexpr auto eighth = pcs::sincos(pcs::bam64::from_bam_value(pcs::eighth));
+		CHECK_EQ(eighth.sin, doctest::Approx(std::sqrt(0.5)).epsilon(1e-15));
+		CHECK_EQ(eighth.cos, doctest::Approx(std::sqrt(0.5)).epsilon(1e-15));
+	}
+
+	TEST_CASE("accuracy tiers")
+	{
+		const auto bams = random_bams(200'000);
+
+		const double fast_error = max_error(bams, pcs::trig_accuracy::fast);
+		const double balanced_error = max_error(bams, pcs::trig_accuracy::balanced);
+		const double precise_error = max_error(bams, pcs::trig_accuracy::precise);
+
+		CHECK_LT(fast_error, 5.0e-9);
+		CHECK_LT(balanced_error, 3.0e-15);
+		CHECK_LT(precise_error, 3.0e-16);
+	}
+
+	TEST_CASE("batch sincos")
+	{
+		const auto bams = random_bams(1001);
+		std::vector<double> sines(bams.size());
+		std::vector<double> cosines(bams.size());
+
+		pcs::sincos(bams, sines, cosines);
+
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < bams.size(); ++i)
+			mismatches += (sines[i] != pcs::sin(bams[i])) || (cosines[i] != pcs::cos(bams[i]));
+
+		CHECK_EQ(mismatches, 0);
+	}
+
+	TEST_CASE("atan2")
+	{
+		CHECK_EQ(pcs::bam64_atan2(0.0, 0.0).value, 0ULL);
+		CHECK_EQ(pcs::bam64_atan2(0.0, 2.0).value, pcs::none);
+		CHECK_EQ(pcs::bam64_atan2(3.0, 3.0).value, pcs::eighth);
+		CHECK_EQ(pcs::bam64_atan2(2.0, 0.0).value, pcs::fourth);
+		CHECK_EQ(pcs::bam64_atan2(3.0, -3.0).value, pcs::three_eighths);
+		CHECK_EQ(pcs::bam64_atan2(0.0, -2.0).value, pcs::half);
+		CHECK_EQ(pcs::bam64_atan2(-3.0, -3.0).value, pcs::five_eighths);
+		CHECK_EQ(pcs::bam64_atan2(-2.0, 0.0).value, pcs::three_fourths);
+		CHECK_EQ(pcs::bam64_atan2(-3.0, 3.0).value, pcs::seven_eighths);
+		CHECK_EQ(pcs::bam64_atan2(1.0, std::numeric_limits<double>::infinity()).value, pcs::none);
+		CHECK_EQ(pcs::bam64_atan2(std::numeric_limits<double>::quiet_NaN(), 1.0).value, 0ULL);
+
+		// the cordic version is within 64 bam units, so with integer inputs it is a good reference
+		std::mt19937_64 gen(0xa7a2);
+		long long worst = 0;
+		for (int i = 0; i < 200'000; ++i)
+		{
+			const long long y = static_cast<long long>(gen()) >> (11 + gen() % 40);
+			const long long x = static_cast<long long>(gen()) >> (11 + gen() % 40);
+			const auto expected = pcs::atan2_bam(y, x);
+			const auto actual = pcs::bam64_atan2(static_cast<double>(y), static_cast<double>(x));
+			const long long error = std::llabs(static_cast<long long>(actual.value - expected.value));
+			worst = (error > worst) ? error : worst;
+		}
+
+		// documented as under 0.25 pcs::epsilon
+		CHECK_LT(worst, (pcs::epsilon / 4) + 64);
+
+		// batch version
+		std::vector<double> ys(1001);
+		std::vector<double> xs(ys.size());
+		std::uniform_real_distribution<double> dist(-10.0, 10.0);
+		for (std::size_t i = 0; i < ys.size(); ++i)
+		{
+			ys[i] = dist(gen);
+			xs[i] = dist(gen);
+		}
+
+		std::vector<pcs::bam64> bams(ys.size());
+		pcs::bam64_atan2(ys, xs, bams);
+
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < bams.size(); ++i)
+			mismatches += (bams[i] != pcs::bam64_atan2(ys[i], xs[i]));
+
+		CHECK_EQ(mismatches, 0);
+	}
+}
@@ -0,0 +1,86 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "circular_reduce.hxx"
+
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+	// headings around a quarter turn, with a size that leaves a partial last chunk
+	std::vector<pcs::bam64> make_headings(std::size_t size = 5 * pcs::detail::circular_chunk_size + 123)
+	{
+		std::mt19937_64 gen(0x4ead);
+		std::normal_distribution<double> dist(0.25, 0.1);
+
+		std::vector<pcs::bam64> headings(size);
+		for (auto &heading : headings)
+			heading = pcs::bam64_from_turns(dist(gen));
+
+		return headings;
+	}
+
+}	// namespace
+
+TEST_SUITE("test circular reduce")
+{
+	TEST_CASE("same bits for any thread count")
+	{
+		const auto headings = make_headings();
+		const auto one = pcs::circular_reduce(headings, 1);
+		CHECK_EQ(one.count, headings.size());
+
+		for (unsigned int threads : { 2u, 3u, 7u, 16u, 0u })
+		{
+			CAPTURE(threads);
+			const auto many = pcs::circular_reduce(headings, threads);
+			CHECK_EQ(many.count, one.count);
+			CHECK_EQ(many.sin_sum[0], one.sin_sum[0]);
+			CHECK_EQ(many.sin_sum[1], one.sin_sum[1]);
+			CHECK_EQ(many.cos_sum[0], one.cos_sum[0]);
+			CHECK_EQ(many.cos_sum[1], one.cos_sum[1]);
+			CHECK_EQ(pcs::circular_mean(headings, threads), one.mean());
+		}
+
+		// the sincos kernels give the same bits as the scalar code, so the instruction set doesn't matter either
+		const auto scalar = pcs::circular_reduce(headings, 4, pcs::trig_accuracy::precise, pcs::simd::instruction_set::scalar);
+		CHECK_EQ(scalar.mean(), one.mean());
+	}
+
+	TEST_CASE("matches streaming statistics")
+	{
+		const auto headings = make_headings();
+
+		pcs::compensated_circular_stats streaming;
+		streaming.add(headings);
+
+		const auto reduced = pcs::circular_reduce(headings);
+		const auto difference = static_cast<long long>(reduced.mean().value - streaming.mean().value);
+		CHECK_LT((difference < 0) ? -difference : difference, 1LL << 16);
+		CHECK_EQ(pcs::circular_resultant_length(headings), doctest::Approx(streaming.resultant_length()).epsilon(1e-14));
+		CHECK_EQ(pcs::circular_variance(headings), doctest::Approx(streaming.circular_variance()).epsilon(1e-13));
+
+		// near the center of the distribution
+		const auto from_center = static_cast<long long>(pcs::circular_mean(headings).value - pcs::fourth);
+		CHECK_LT(static_cast<double>((from_center < 0) ? -from_center : from_center) * 0x1p-64, 0.001);
+	}
+
+	TEST_CASE("small and empty")
+	{
+		const std::vector<pcs::bam64> none;
+		CHECK_EQ(pcs::circular_reduce(none).count, 0);
+		CHECK_EQ(pcs::circular_mean(none).value, 0);
+		CHECK_EQ(pcs::circular_resultant_length(none), 0.0);
+
+		const std::vector<pcs::bam64> three{ pcs::bam64_from_degrees(350.0), pcs::bam64_from_degrees(10.0), pcs::bam64{ .value = 0 } };
+		const auto stats = pcs::circular_reduce(three, 8);
+		CHECK_EQ(stats.count, 3);
+		const auto mean = static_cast<long long>(stats.mean().value);
+		CHECK_LT((mean < 0) ? -mean : mean, 1LL << 12);
+	}
+}
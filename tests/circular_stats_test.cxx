@@ -0,0 +1,141 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "circular_stats.hxx"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+	// distance between two bam64 values, in turns
+	double turn_distance(pcs::bam64 a, pcs::bam64 b)
+	{
+		const auto difference = static_cast<long long>(a.value - b.value);
+		return std::abs(static_cast<double>(difference)) * 0x1p-64;
+	}
+
+	// samples spread by up to +/- spread turns around center
+	std::vector<pcs::bam64> make_samples(std::size_t count, double center, double spread, unsigned long long seed)
+	{
+		std::mt19937_64 gen(seed);
+		std::uniform_real_distribution<double> dist(-spread, spread);
+
+		std::vector<pcs::bam64> samples(count);
+		for (auto &sample : samples)
+			sample = pcs::bam64_from_turns(center + dist(gen));
+
+		return samples;
+	}
+
+}	// namespace
+
+TEST_SUITE("test circular stats")
+{
+	TEST_CASE("basic statistics")
+	{
+		pcs::circular_stats<> stats;
+		CHECK(stats.empty());
+		CHECK_EQ(stats.resultant_length(), 0.0);
+		CHECK_EQ(stats.mean().value, 0);
+
+		// the mean of 350 and 10 degrees is 0, not 180
+		stats.add(pcs::bam64_from_degrees(350.0));
+		stats.add(pcs::bam64_from_degrees(10.0));
+		CHECK_EQ(stats.count, 2);
+		CHECK_LT(turn_distance(stats.mean(), pcs::bam64{ .value = 0 }), 1e-15);
+		CHECK_EQ(stats.resultant_length(), doctest::Approx(std::cos(pcs::pi / 18.0)));
+
+		// all the same direction
+		pcs::circular_stats<> same;
+		for (int i = 0; i < 10; ++i)
+			same.add(pcs::bam64{ .value = pcs::three_fourths });
+		CHECK_EQ(same.mean().value, pcs::three_fourths);
+		CHECK_EQ(same.resultant_length(), doctest::Approx(1.0));
+		CHECK_EQ(same.circular_variance(), doctest::Approx(0.0).epsilon(1e-12));
+
+		// evenly spread
+		pcs::circular_stats<> spread;
+		for (unsigned long long i = 0; i < 8; ++i)
+			spread.add(pcs::bam64{ .value = i << 61 });
+		CHECK_LT(spread.resultant_length(), 1e-15);
+		CHECK_EQ(spread.circular_variance(), doctest::Approx(1.0));
+
+		// removing gets back to where it was
+		stats.remove(pcs::bam64_from_degrees(10.0));
+		CHECK_EQ(stats.count, 1);
+		CHECK_LT(turn_distance(stats.mean(), pcs::bam64_from_degrees(350.0)), 1e-15);
+
+		stats.clear();
+		CHECK(stats.empty());
+	}
+
+	TEST_CASE("merge")
+	{
+		const auto samples = make_samples(10'000, 0.3, 0.2, 0x5eed);
+		const std::span<const pcs::bam64> all(samples);
+
+		pcs::compensated_circular_stats whole;
+		whole.add(all);
+
+		// four partial results, like four threads, in any order
+		pcs::compensated_circular_stats parts[4];
+		for (std::size_t i = 0; i < 4; ++i)
+			parts[i].add(all.subspan(i * 2500, 2500));
+
+		pcs::compensated_circular_stats merged;
+		merged.merge(parts[2]);
+		merged.merge(parts[0]);
+		merged.merge(parts[3]);
+		merged.merge(parts[1]);
+
+		CHECK_EQ(merged.count, whole.count);
+		CHECK_LE(turn_distance(merged.mean(), whole.mean()), 1e-15);
+		CHECK_EQ(merged.resultant_length(), doctest::Approx(whole.resultant_length()).epsilon(1e-15));
+
+		// the mean is near the center, and the plain sums agree closely
+		pcs::circular_stats<> plain;
+		plain.add(all);
+		CHECK_LT(turn_distance(whole.mean(), pcs::bam64_from_turns(0.3)), 0.01);
+		CHECK_LT(turn_distance(plain.mean(), whole.mean()), 1e-12);
+	}
+
+	TEST_CASE("sliding window")
+	{
+		CHECK_THROWS_AS(pcs::sliding_circular_stats<>(0), std::invalid_argument);
+
+		const auto samples = make_samples(5'000, -0.1, 0.45, 0xf00d);
+		constexpr std::size_t window_size = 100;
+
+		pcs::sliding_circular_stats<true> window(window_size);
+		CHECK_EQ(window.window_size(), window_size);
+
+		for (std::size_t i = 0; i < samples.size(); ++i)
+		{
+			window.add(samples[i]);
+			CHECK_EQ(window.count(), (i < window_size) ? (i + 1) : window_size);
+
+			// the same as starting over with just the samples in the window
+			if ((i % 97) == 0)
+			{
+				const std::size_t first = (i < window_size) ? 0 : (i + 1 - window_size);
+				pcs::compensated_circular_stats fresh;
+				fresh.add(std::span<const pcs::bam64>(samples).subspan(first, i + 1 - first));
+
+				CHECK_LT(turn_distance(window.mean(), fresh.mean()), 1e-14);
+				CHECK_EQ(window.resultant_length(), doctest::Approx(fresh.resultant_length()).epsilon(1e-13));
+			}
+		}
+
+		window.clear();
+		CHECK_EQ(window.count(), 0);
+		window.add(pcs::bam64{ .value = pcs::half });
+		CHECK_EQ(window.mean().value, pcs::half);
+	}
+}
@@ -5,10 +5,99 @@
 //          https://www.boost.org/LICENSE_1_0.txt)
 
 #include "periodic.hxx"
+#include "periodic_simd.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
 
 //#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
+namespace
+{
+	struct float_parameters
+	{
+		float input_period;
+		float input_origin;
+		float output_min;
+		float output_period;
+	};
+
+	constexpr float_parameters float_cases[] =
+	{
+		{ .input_period = 1.0f,			.input_origin = 0.25f,	.output_min = -0.5f,	.output_period = 1.0f },
+		{ .input_period = 360.0f,		.input_origin = 90.0f,	.output_min = -180.0f,	.output_period = 360.0f },
+		{ .input_period = 6.2831855f,	.input_origin = -1.0f,	.output_min = 0.0f,		.output_period = 360.0f },
+		{ .input_period = 0.25f,		.input_origin = 3.0f,	.output_min = 0.0f,		.output_period = 24.0f }
+	};
+
+	// the worst error of the float conversion compared to the double one, over every stride-th float bit pattern, as a
+	// fraction of what float rounding allows. that is a few float ulps of the largest normalized term, times output_period,
+	// measured around the circle, so a wrap at the edge of the output range is no error at all. inputs so large that the
+	// allowance is a big part of the period don't have a meaningful answer in float, and are skipped.
+	double worst_float_error(const float_parameters &p, bool forward, unsigned long long stride)
+	{
+		constexpr std::size_t chunk = 4096;
+		std::vector<float> inputs(chunk);
+		std::vector<float> outputs(chunk);
+		std::vector<double> wide_inputs(chunk);
+		std::vector<double> wide_outputs(chunk);
+
+		const double origin = std::abs(static_cast<double>(p.input_origin) / p.output_period);
+		const double minimum = std::abs(static_cast<double>(p.output_min) / p.output_period) + 1.0;
+
+		double worst = 0.0;
+		for (unsigned long long start = 0; start < 0x100000000; start += chunk * stride)
+		{
+			std::size_t count = 0;
+			for (unsigned long long bits = start; (bits < 0x100000000) && (count < chunk); bits += stride)
+			{
+				const float value = std::bit_cast<float>(static_cast<unsigned int>(bits));
+				if (std::isfinite(value))
+				{
+					inputs[count] = value;
+					wide_inputs[count] = value;
+					++count;
+				}
+			}
+
+			const auto used = std::span<float>(outputs).first(count);
+			const auto wide_used = std::span<double>(wide_outputs).first(count);
+			if (forward)
+			{
+				pcs::simd::forward_convert(std::span<const float>(inputs).first(count), used, p.input_period, p.input_origin, p.output_min, p.output_period);
+				pcs::forward_convert(std::span<const double>(wide_inputs).first(count), wide_used, p.input_period, p.input_origin, p.output_min, p.output_period);
+			}
+			else
+			{
+				pcs::simd::reverse_convert(std::span<const float>(inputs).first(count), used, p.input_period, p.input_origin, p.output_min, p.output_period);
+				pcs::reverse_convert(std::span<const double>(wide_inputs).first(count), wide_used, p.input_period, p.input_origin, p.output_min, p.output_period);
+			}
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const double largest = std::max({ std::abs(wide_inputs[i] / p.input_period), origin, minimum });
+				const double allowed = 4.0 * std::ldexp(1.0, std::ilogb(largest) - 23) * p.output_period;
+				if (allowed > 0.125 * p.output_period)
+					continue;
+
+				const double difference = std::fmod(std::abs(static_cast<double>(outputs[i]) - wide_outputs[i]), static_cast<double>(p.output_period));
+				worst = std::max(worst, std::min(difference, p.output_period - difference) / allowed);
+			}
+		}
+
+		return worst;
+	}
+
+}	// namespace
+
 TEST_SUITE("test pcs")
 {
 	TEST_CASE("forward and reverse")
@@ -66,4 +155,362 @@ TEST_SUITE("test pcs")
 		}
 
 	}
-}
\ No newline at end of file
+
+	TEST_CASE("batch forward and reverse")
+	{
+		struct parameters
+		{
+			double input_period;
+			double input_origin;
+			double output_min;
+			double output_period;
+		};
+
+		// power of two input periods use a reciprocal, the others divide
+		constexpr parameters cases[] =
+		{
+			{ .input_period = 1.0,		.input_origin = 0.25,	.output_min = -0.5,		.output_period = 1.0 },
+			{ .input_period = 360.0,	.input_origin = 90.0,	.output_min = -180.0,	.output_period = 360.0 },
+			{ .input_period = 0.25,		.input_origin = 3.0,	.output_min = 0.0,		.output_period = 24.0 },
+			{ .input_period = 6.283185307179586,	.input_origin = -1.0,	.output_min = -3.141592653589793,	.output_period = 6.283185307179586 },
+			{ .input_period = 1024.0,	.input_origin = 0.1,	.output_min = 0.3,		.output_period = 0.7 }
+		};
+
+		// an odd size makes sure the scalar tail is used by all the kernels
+		std::mt19937_64 gen(0xc0417);
+		std::uniform_real_distribution<double> dist(-5000.0, 5000.0);
+		std::vector<double> inputs(1001);
+		for (auto &input : inputs)
+			input = dist(gen);
+		inputs[0] = 0.0;
+		inputs[1] = -0.0;
+		inputs[2] = 0.25;
+		inputs[3] = 1.0e12;
+
+		std::vector<double> outputs(inputs.size());
+
+		auto mismatches = [&](const parameters &p, bool forward)
+		{
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < inputs.size(); ++i)
+			{
+				const double expected = forward ? pcs::forward_convert(inputs[i], p.input_period, p.input_origin, p.output_min, p.output_period)
+												: pcs::reverse_convert(inputs[i], p.input_period, p.input_origin, p.output_min, p.output_period);
+				count += (std::bit_cast<unsigned long long>(outputs[i]) != std::bit_cast<unsigned long long>(expected));
+			}
+			return count;
+		};
+
+		for (const auto &p : cases)
+		{
+			pcs::forward_convert(inputs, outputs, p.input_period, p.input_origin, p.output_min, p.output_period);
+			CHECK_EQ(mismatches(p, true), 0);
+
+			pcs::reverse_convert(inputs, outputs, p.input_period, p.input_origin, p.output_min, p.output_period);
+			CHECK_EQ(mismatches(p, false), 0);
+
+			const auto converter = pcs::forward_period_converter{ .input_period = p.input_period, .output_period = p.output_period,
+																	.input_origin = p.input_origin, .output_min = p.output_min };
+			converter.forward(inputs, outputs);
+			CHECK_EQ(mismatches(p, true), 0);
+
+			for (auto isa : { pcs::simd::instruction_set::scalar, pcs::simd::instruction_set::sse42,
+							  pcs::simd::instruction_set::avx2, pcs::simd::instruction_set::avx512 })
+			{
+				if (isa > pcs::simd::supported_instruction_set())
+					continue;
+
+				pcs::simd::forward_convert(inputs, outputs, p.input_period, p.input_origin, p.output_min, p.output_period, isa);
+				CHECK_EQ(mismatches(p, true), 0);
+
+				pcs::simd::reverse_convert(inputs, outputs, p.input_period, p.input_origin, p.output_min, p.output_period, isa);
+				CHECK_EQ(mismatches(p, false), 0);
+			}
+		}
+	}
+
+	TEST_CASE("constexpr rounding of small values")
+	{
+		// zero results keep the sign of the input, like the standard functions
+		static_assert(pcs::cxcm::is_negative_zero(pcs::cxcm::ceil(-0.5)));
+		static_assert(pcs::cxcm::is_negative_zero(pcs::cxcm::trunc(-0.75f)));
+		static_assert(pcs::cxcm::is_negative_zero(pcs::cxcm::round(-0.25)));
+		static_assert(pcs::cxcm::is_negative_zero(pcs::cxcm::round_even(-0.5f)));
+		static_assert(!pcs::cxcm::is_negative_zero(pcs::cxcm::ceil(0.5f)));
+
+		// the largest values below 0.5 round to zero
+		static_assert(pcs::cxcm::round(0.49999997f) == 0.0f);
+		static_assert(pcs::cxcm::round(-0.49999999999999994) == 0.0);
+		static_assert(pcs::cxcm::round_even(0.49999999999999994) == 0.0);
+		static_assert(pcs::cxcm::round(0.5f) == 1.0f);
+		static_assert(pcs::cxcm::round_even(0.5) == 0.0);
+
+		CHECK_UNARY(pcs::cxcm::is_negative_zero(pcs::cxcm::round_even(-0.25)));
+		CHECK_EQ(pcs::cxcm::round_even(0.49999997f), 0.0f);
+	}
+
+	TEST_CASE("span rounding")
+	{
+		// the same bits as the cxcm scalar functions at runtime, for every instruction set, both types, and odd sizes for the
+		// scalar tails. round_even() and fract() take the constexpr path at runtime, so that gets checked too.
+		auto check = []<typename T>(T)
+		{
+			std::mt19937_64 gen(0x50c0);
+			std::vector<T> values(1001);
+			for (auto &value : values)
+			{
+				// integers, halves, and everything in between, from tiny to too big to have a fraction
+				const int exponent = static_cast<int>(gen() % 80) - 30;
+				const T magnitude = std::ldexp(static_cast<T>(gen() % 64) / T(4), exponent);
+				value = (gen() & 1) ? -magnitude : magnitude;
+			}
+
+			const T specials[] =
+			{
+				T(0), -T(0), T(0.5), T(-0.5), T(1.5), T(-1.5), T(2.5), T(-2.5), std::nextafter(T(0.5), T(0)), std::nextafter(T(-0.5), T(0)),
+				std::nextafter(T(0.5), T(1)), std::nextafter(T(-0.5), T(-1)), T(0.25), T(-0.25), T(-0.75),
+				pcs::cxcm::limits::largest_fractional_value<T>, -pcs::cxcm::limits::largest_fractional_value<T>,
+				std::numeric_limits<T>::denorm_min(), -std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::max(),
+				std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity(), std::numeric_limits<T>::quiet_NaN()
+			};
+
+			std::copy(std::begin(specials), std::end(specials), values.begin());
+
+			using bits = std::conditional_t<sizeof(T) == 8, unsigned long long, unsigned int>;
+			std::vector<T> results(values.size());
+			auto mismatches = [&](auto expected)
+			{
+				std::size_t count = 0;
+				for (std::size_t i = 0; i < values.size(); ++i)
+				{
+					const T value = expected(values[i]);
+					count += std::isnan(value) ? !std::isnan(results[i]) : (std::bit_cast<bits>(results[i]) != std::bit_cast<bits>(value));
+				}
+				return count;
+			};
+
+			for (auto isa : { pcs::simd::instruction_set::scalar, pcs::simd::instruction_set::sse42,
+							  pcs::simd::instruction_set::avx2, pcs::simd::instruction_set::avx512 })
+			{
+				if (isa > pcs::simd::supported_instruction_set())
+					continue;
+
+				CAPTURE(static_cast<int>(isa));
+
+				pcs::cxcm::floor(values, results, isa);
+				CHECK_EQ(mismatches([](T value) { return pcs::cxcm::floor(value); }), 0);
+
+				pcs::cxcm::ceil(values, results, isa);
+				CHECK_EQ(mismatches([](T value) { return pcs::cxcm::ceil(value); }), 0);
+
+				pcs::cxcm::trunc(values, results, isa);
+				CHECK_EQ(mismatches([](T value) { return pcs::cxcm::trunc(value); }), 0);
+
+				pcs::cxcm::round(values, results, isa);
+				CHECK_EQ(mismatches([](T value) { return pcs::cxcm::round(value); }), 0);
+
+				pcs::cxcm::round_even(values, results, isa);
+				CHECK_EQ(mismatches([](T value) { return pcs::cxcm::round_even(value); }), 0);
+				CHECK_EQ(mismatches([](T value) { return std::nearbyint(value); }), 0);
+
+				pcs::cxcm::fract(values, results, isa);
+				CHECK_EQ(mismatches([](T value) { return pcs::cxcm::fract(value); }), 0);
+
+				// in place
+				results = values;
+				pcs::cxcm::floor(results, results, isa);
+				CHECK_EQ(mismatches([](T value) { return pcs::cxcm::floor(value); }), 0);
+			}
+		};
+
+		check(0.0);
+		check(0.0f);
+	}
+
+	TEST_CASE("compiled converters")
+	{
+		const auto converter = pcs::forward_period_converter{ .input_period = 360.0, .output_period = 6.283185307179586,
+															  .input_origin = 1.0, .output_min = -3.141592653589793 };
+		const auto reverse_converter = pcs::reverse_period_converter{ .input_period = 360.0, .output_period = 6.283185307179586,
+																	  .input_origin = 1.0, .output_min = -3.141592653589793 };
+
+		const auto compiled = pcs::compiled_forward_converter(converter);
+		const auto compiled_reverse = pcs::compiled_reverse_converter(reverse_converter);
+
+		// the documented bound is a couple of ulps of the largest normalized term, times the output period
+		auto within = [&](double actual, double expected, double input_value)
+		{
+			double difference = std::fabs(actual - expected);
+			if (difference > converter.output_period / 2.0)
+				difference = std::fabs(difference - converter.output_period);
+
+			const double largest = std::fmax(std::fabs(input_value / converter.input_period),
+											 std::fabs(converter.output_min / converter.output_period) + 1.0);
+			return difference <= 4.0 * std::numeric_limits<double>::epsilon() * largest * converter.output_period;
+		};
+
+		std::mt19937_64 gen(0xc0a1);
+		std::uniform_real_distribution<double> dist(-1.0e6, 1.0e6);
+		std::size_t failures = 0;
+		for (int i = 0; i < 100'000; ++i)
+		{
+			const double value = (i % 2 == 0) ? dist(gen) : dist(gen) * 1.0e-5;
+			failures += !within(compiled(value), converter(value), value);
+			failures += !within(compiled.reverse(value), converter.reverse(value), value);
+			failures += !within(compiled_reverse(value), reverse_converter(value), value);
+			failures += !within(compiled_reverse.reverse(value), reverse_converter.reverse(value), value);
+		}
+		CHECK_EQ(failures, 0);
+
+		// the defaults are the same as the default converters, and exact values stay exact
+		constexpr auto identity = pcs::compiled_forward_converter{};
+		static_assert(identity(2.75) == 0.75);
+		static_assert(identity.reverse(2.75) == 0.25);
+		CHECK_EQ(pcs::compiled_forward_converter(pcs::forward_period_converter{ .input_period = 360.0, .output_period = 360.0, .output_min = -180.0 })(270.0), -90.0);
+
+		// batch versions
+		std::vector<double> inputs(1001);
+		for (auto &input : inputs)
+			input = dist(gen);
+
+		std::vector<double> outputs(inputs.size());
+		compiled.forward(inputs, outputs);
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < inputs.size(); ++i)
+			mismatches += (outputs[i] != compiled(inputs[i]));
+
+		compiled_reverse.reverse(inputs, outputs);
+		for (std::size_t i = 0; i < inputs.size(); ++i)
+			mismatches += (outputs[i] != compiled_reverse.reverse(inputs[i]));
+
+		CHECK_EQ(mismatches, 0);
+	}
+
+#if defined(PCS_STATIC_CONVERTERS)
+	TEST_CASE("static converters")
+	{
+		// identical to the runtime converter with the same parameters
+		auto mismatches = []<pcs::period_converter Static, pcs::period_converter Runtime>(const Static &fixed, const Runtime &runtime)
+		{
+			std::mt19937_64 gen(0x57a7);
+			std::uniform_real_distribution<double> dist(-1.0e4, 1.0e4);
+
+			std::size_t count = 0;
+			for (int i = 0; i < 10'000; ++i)
+			{
+				const double value = dist(gen);
+				count += (std::bit_cast<unsigned long long>(fixed(value)) != std::bit_cast<unsigned long long>(runtime(value)));
+				count += (std::bit_cast<unsigned long long>(fixed.reverse(value)) != std::bit_cast<unsigned long long>(runtime.reverse(value)));
+			}
+			return count;
+		};
+
+		constexpr auto degrees = pcs::static_forward_converter<360.0, 360.0, 0.0, -180.0>{};
+		CHECK_EQ(mismatches(degrees, pcs::forward_period_converter{ .input_period = 360.0, .output_period = 360.0, .output_min = -180.0 }), 0);
+
+		constexpr auto radians_to_degrees = pcs::static_forward_converter<6.283185307179586, 360.0, 90.0>{};
+		CHECK_EQ(mismatches(radians_to_degrees, pcs::forward_period_converter{ .input_period = 6.283185307179586, .output_period = 360.0, .input_origin = 90.0 }), 0);
+
+		constexpr auto turns_to_degrees = pcs::static_forward_converter<1.0, 360.0>{};
+		CHECK_EQ(mismatches(turns_to_degrees, pcs::forward_period_converter{ .output_period = 360.0 }), 0);
+
+		constexpr auto power_of_two = pcs::static_reverse_converter<0.125, 1.0, 0.25, -0.5>{};
+		CHECK_EQ(mismatches(power_of_two, pcs::reverse_period_converter{ .input_period = 0.125, .input_origin = 0.25, .output_min = -0.5 }), 0);
+
+		// the parameters are visible the same way as the runtime converter's members
+		static_assert(degrees.input_period == 360.0 && degrees.output_min == -180.0);
+		static_assert(turns_to_degrees(2.25) == 90.0);
+		static_assert(degrees(-270.0) == 90.0);
+
+		// batch versions
+		const std::vector<double> inputs = { -720.5, -90.0, 0.0, 179.0, 180.0, 1234.5 };
+		std::vector<double> outputs(inputs.size());
+		degrees.forward(inputs, outputs);
+		for (std::size_t i = 0; i < inputs.size(); ++i)
+			CHECK_EQ(outputs[i], degrees(inputs[i]));
+	}
+#endif
+
+	TEST_CASE("float conversions")
+	{
+		// the simd float kernels give the same bits as the scalar float functions
+		std::mt19937_64 gen(0xf1a7);
+		std::uniform_real_distribution<float> dist(-5000.0f, 5000.0f);
+		std::vector<float> inputs(1001);
+		for (auto &input : inputs)
+			input = dist(gen);
+		inputs[0] = 0.0f;
+		inputs[1] = -0.0f;
+		inputs[2] = 0.25f;
+		inputs[3] = 1.0e12f;
+
+		std::vector<float> outputs(inputs.size());
+		auto mismatches = [&](const float_parameters &p, bool forward)
+		{
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < inputs.size(); ++i)
+			{
+				const float expected = forward ? pcs::forward_convert(inputs[i], p.input_period, p.input_origin, p.output_min, p.output_period)
+											   : pcs::reverse_convert(inputs[i], p.input_period, p.input_origin, p.output_min, p.output_period);
+				count += (std::bit_cast<unsigned int>(outputs[i]) != std::bit_cast<unsigned int>(expected));
+			}
+			return count;
+		};
+
+		for (const auto &p : float_cases)
+		{
+			pcs::forward_convert(inputs, outputs, p.input_period, p.input_origin, p.output_min, p.output_period);
+			CHECK_EQ(mismatches(p, true), 0);
+
+			const auto converter = pcs::basic_forward_period_converter<float>{ .input_period = p.input_period, .output_period = p.output_period,
+																			   .input_origin = p.input_origin, .output_min = p.output_min };
+			converter.reverse(inputs, outputs);
+			CHECK_EQ(mismatches(p, false), 0);
+
+			for (auto isa : { pcs::simd::instruction_set::scalar, pcs::simd::instruction_set::sse42,
+							  pcs::simd::instruction_set::avx2, pcs::simd::instruction_set::avx512 })
+			{
+				if (isa > pcs::simd::supported_instruction_set())
+					continue;
+
+				pcs::simd::forward_convert(inputs, outputs, p.input_period, p.input_origin, p.output_min, p.output_period, isa);
+				CHECK_EQ(mismatches(p, true), 0);
+
+				pcs::simd::reverse_convert(inputs, outputs, p.input_period, p.input_origin, p.output_min, p.output_period, isa);
+				CHECK_EQ(mismatches(p, false), 0);
+			}
+		}
+
+		// the other converters work in float too
+#if defined(PCS_STATIC_CONVERTERS)
+		constexpr auto degrees = pcs::static_forward_converter<360.0, 360.0, 0.0, -180.0, float>{};
+		static_assert(degrees(-270.0f) == 90.0f);
+#endif
+		static_assert(pcs::forward_convert(-270.0f, 360.0f, 0.0f, -180.0f, 360.0f) == 90.0f);
+
+		// float is only used when every argument is a float. anything else is converted in double, as it always was.
+		static_assert(std::is_same_v<decltype(pcs::forward_convert(1.5f, 360.0f, 0.0f, 0.0f, 360.0f)), float>);
+		static_assert(std::is_same_v<decltype(pcs::reverse_convert(1.5f, 360.0f, 0.0f, 0.0f, 360.0f)), float>);
+		static_assert(std::is_same_v<decltype(pcs::forward_convert(1.5f, 360.0, 0.0, 0.0, 360.0)), double>);
+		static_assert(std::is_same_v<decltype(pcs::reverse_convert(1.5f, 360.0f, 0.0f, 0.0f, 360.0)), double>);
+		static_assert(std::is_same_v<decltype(pcs::forward_convert(90, 360, 0, 0, 360)), double>);
+		static_assert(std::is_same_v<decltype(pcs::forward_convert(1.5L, 360.0L, 0.0L, 0.0L, 360.0L)), double>);
+
+		const float mixed_input = 100.1f;
+		CHECK_EQ(pcs::forward_convert(mixed_input, 1.0 / 3.0, 0.1, 0.0, 360.0), pcs::forward_convert(static_cast<double>(mixed_input), 1.0 / 3.0, 0.1, 0.0, 360.0));
+		CHECK_EQ(pcs::reverse_convert(mixed_input, 1.0 / 3.0, 0.1, 0.0, 360.0), pcs::reverse_convert(static_cast<double>(mixed_input), 1.0 / 3.0, 0.1, 0.0, 360.0));
+		CHECK_NE(pcs::forward_convert(mixed_input, 1.0 / 3.0, 0.1, 0.0, 360.0), static_cast<double>(pcs::forward_convert(mixed_input, 1.0f / 3.0f, 0.1f, 0.0f, 360.0f)));
+
+		const auto compiled = pcs::basic_compiled_forward_converter<float>(pcs::basic_forward_period_converter<float>{ .input_period = 360.0f, .output_period = 360.0f, .output_min = -180.0f });
+		CHECK_EQ(compiled(-270.0f), doctest::Approx(90.0f));
+		CHECK_EQ(compiled.reverse(90.0f), doctest::Approx(-90.0f));
+
+		// within a few float ulps of the double conversions, for a sample of every float. float_sweep_test.cxx has every float.
+		for (const auto &p : float_cases)
+		{
+			CAPTURE(p.input_period);
+			CHECK_LE(worst_float_error(p, true, 4099), 1.0);
+			CHECK_LE(worst_float_error(p, false, 4099), 1.0);
+		}
+	}
+}
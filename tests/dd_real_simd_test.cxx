@@ -0,0 +1,278 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dd_real_simd.hxx"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+	using dd_real = pcs::cxcm::dd_real::dd_real;
+
+	// normalized double-doubles stored as two arrays
+	struct dd_values
+	{
+		std::vector<double> hi;
+		std::vector<double> lo;
+
+		explicit dd_values(std::size_t size) : hi(size), lo(size)
+		{
+		}
+
+		pcs::cxcm::dd_real::dd_real_array array() noexcept					{ return { .hi = hi, .lo = lo }; }
+		pcs::cxcm::dd_real::const_dd_real_array array() const noexcept		{ return { .hi = hi, .lo = lo }; }
+	};
+
+	// magnitudes from 2^-max_exponent to 2^max_exponent, with low parts down to 2^-60 of the high parts. the wide range
+	// reaches where the products and quotients overflow or underflow. an odd size makes the tails get used.
+	dd_values make_values(std::uint64_t seed, int max_exponent, std::size_t size = 10'001)
+	{
+		std::mt19937_64 gen(seed);
+		std::uniform_real_distribution<double> mantissa_dist(-2.0, 2.0);
+		std::uniform_int_distribution<int> exponent_dist(-max_exponent, max_exponent);
+		std::uniform_real_distribution<double> low_dist(-0x1p-53, 0x1p-53);
+		std::uniform_int_distribution<int> low_exponent_dist(0, 7);
+
+		dd_values values(size);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			const double hi = std::ldexp(mantissa_dist(gen), exponent_dist(gen));
+			const double lo = hi * std::ldexp(low_dist(gen), -low_exponent_dist(gen));
+			values.hi[i] = pcs::cxcm::dd_real::quick_two_sum(hi, lo, values.lo[i]);
+		}
+
+		// exact values, signed zeros, and values that aren't finite
+		const dd_real specials[] = { dd_real(0.0, 0.0), dd_real(-0.0, 0.0), dd_real(-0.0, -0.0), dd_real(1.0, 0.0), dd_real(-3.0, 0x1p-60),
+									 dd_real(std::numeric_limits<double>::max(), 0.0), dd_real(std::numeric_limits<double>::denorm_min(), 0.0),
+									 dd_real(std::numeric_limits<double>::infinity(), 0.0), dd_real(std::numeric_limits<double>::quiet_NaN(), 0.0) };
+		for (std::size_t i = 0; (i < std::size(specials)) && (i * 11 < size); ++i)
+		{
+			values.hi[i * 11] = specials[i].x[0];
+			values.lo[i * 11] = specials[i].x[1];
+		}
+
+		return values;
+	}
+
+	// the same bits, except NaNs only need to be NaNs, since their signs and payloads depend on operand order
+	bool same_bits(double a, double b) noexcept
+	{
+		return (std::isnan(a) && std::isnan(b)) || (std::bit_cast<unsigned long long>(a) == std::bit_cast<unsigned long long>(b));
+	}
+
+	bool same_bits(dd_real a, dd_real b) noexcept
+	{
+		return same_bits(a.x[0], b.x[0]) && same_bits(a.x[1], b.x[1]);
+	}
+
+	// a binary span function and the operator it has to match
+	using binary_function = void (*)(pcs::cxcm::dd_real::const_dd_real_array, pcs::cxcm::dd_real::const_dd_real_array,
+									 pcs::cxcm::dd_real::dd_real_array, pcs::simd::instruction_set) noexcept;
+
+	void check_binary(binary_function function, dd_real (*expected)(const dd_real &, const dd_real &), const dd_values &a, const dd_values &b)
+	{
+		for (auto isa : pcs::simd::runnable_instruction_sets())
+		{
+			CAPTURE(static_cast<int>(isa));
+
+			dd_values results(a.hi.size());
+			function(a.array(), b.array(), results.array(), isa);
+
+			std::size_t mismatches = 0;
+			for (std::size_t i = 0; i < a.hi.size(); ++i)
+			{
+				if (!same_bits(results.array()[i], expected(a.array()[i], b.array()[i])))
+					++mismatches;
+			}
+
+			CHECK_EQ(mismatches, 0);
+		}
+	}
+
+	// splitmix64, so the same values can be made at compile time and at runtime
+	constexpr std::uint64_t next_random(std::uint64_t &state) noexcept
+	{
+		std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	// magnitudes from 2^-30 to 2^31, with low parts down to 2^-60 of the high parts
+	constexpr dd_real random_dd_real(std::uint64_t &state) noexcept
+	{
+		const std::uint64_t bits = next_random(state);
+		const std::uint64_t sign = bits & 0x8000'0000'0000'0000ull;
+		const std::uint64_t exponent = 1023ull - 30ull + (bits >> 57) % 61ull;
+		const double hi = std::bit_cast<double>(sign | (exponent << 52) | (next_random(state) & 0x000f'ffff'ffff'ffffull));
+		const double lo = hi * std::bit_cast<double>((1023ull - 53ull - (bits >> 54) % 8ull) << 52) * (static_cast<double>(bits & 0xffff) / 0x1p16 - 0.5);
+
+		double error = 0.0;
+		const double sum = pcs::cxcm::dd_real::quick_two_sum(hi, lo, error);
+		return dd_real(sum, error);
+	}
+
+	constexpr std::size_t constexpr_product_count = 500;
+
+	// the inputs, then their products, as dd_real * dd_real and dd_real * double
+	constexpr std::array<dd_real, 4 * constexpr_product_count> make_products() noexcept
+	{
+		std::array<dd_real, 4 * constexpr_product_count> values{};
+		std::uint64_t state = 0x5eed;
+		for (std::size_t i = 0; i < constexpr_product_count; ++i)
+		{
+			const dd_real a = random_dd_real(state);
+			const dd_real b = random_dd_real(state);
+			values[4 * i] = a;
+			values[4 * i + 1] = b;
+			values[4 * i + 2] = a * b;
+			values[4 * i + 3] = a * b.x[0];
+		}
+
+		return values;
+	}
+
+	dd_real add_operator(const dd_real &a, const dd_real &b)			{ return a + b; }
+	dd_real subtract_operator(const dd_real &a, const dd_real &b)		{ return a - b; }
+	dd_real multiply_operator(const dd_real &a, const dd_real &b)		{ return a * b; }
+	dd_real divide_operator(const dd_real &a, const dd_real &b)			{ return a / b; }
+
+}	// namespace
+
+TEST_SUITE("dd_real simd kernels")
+{
+	TEST_CASE("add and subtract are bit-identical to the operators")
+	{
+		// similar magnitudes, so the low parts matter, and very different ones
+		check_binary(pcs::cxcm::dd_real::add, add_operator, make_values(0xadd, 4), make_values(0xadd2, 4));
+		check_binary(pcs::cxcm::dd_real::add, add_operator, make_values(0xadd, 1000), make_values(0xadd2, 1000));
+		check_binary(pcs::cxcm::dd_real::subtract, subtract_operator, make_values(0x5b, 4), make_values(0x5b2, 4));
+		check_binary(pcs::cxcm::dd_real::subtract, subtract_operator, make_values(0x5b, 1000), make_values(0x5b2, 1000));
+	}
+
+	TEST_CASE("multiply is bit-identical to the operator")
+	{
+		check_binary(pcs::cxcm::dd_real::multiply, multiply_operator, make_values(0x3a, 30), make_values(0x3a2, 30));
+
+		// products that overflow, underflow, or go through subnormals
+		check_binary(pcs::cxcm::dd_real::multiply, multiply_operator, make_values(0x3a, 1000), make_values(0x3a2, 1000));
+	}
+
+	TEST_CASE("constexpr products are bit-identical to runtime ones")
+	{
+		// constant evaluation can't use fma instructions, so it has to round the same way without them
+		static constexpr auto constexpr_products = make_products();
+
+		std::vector<dd_real> values(constexpr_products.begin(), constexpr_products.end());
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < values.size(); i += 4)
+		{
+			if (!same_bits(values[i] * values[i + 1], constexpr_products[i + 2]) || !same_bits(values[i] * values[i + 1].x[0], constexpr_products[i + 3]))
+				++mismatches;
+		}
+
+		CHECK_EQ(mismatches, 0);
+
+		// products that nearly cancel the addend are where an unfused multiply_add() differs the most
+		static constexpr double a = 1.0 + 0x1p-52;
+		static constexpr double b = 1.0 - 0x1p-53;
+		static constexpr double c = -1.0;
+		static constexpr double constexpr_fused = pcs::cxcm::dd_real::multiply_add(a, b, c);
+
+		const std::vector<double> inputs = { a, b, c };
+		CHECK_UNARY(same_bits(pcs::cxcm::dd_real::multiply_add(inputs[0], inputs[1], inputs[2]), constexpr_fused));
+	}
+
+	TEST_CASE("divide is bit-identical to the operator")
+	{
+		check_binary(pcs::cxcm::dd_real::divide, divide_operator, make_values(0xd1, 30), make_values(0xd12, 30));
+		check_binary(pcs::cxcm::dd_real::divide, divide_operator, make_values(0xd1, 1000), make_values(0xd12, 1000));
+	}
+
+	TEST_CASE("short arrays, and results in place")
+	{
+		const auto a = make_values(0x5407, 30, 40);
+		const auto b = make_values(0x5408, 30, 40);
+
+		for (auto isa : pcs::simd::runnable_instruction_sets())
+		{
+			CAPTURE(static_cast<int>(isa));
+
+			// every tail length, and a result that is shorter than the inputs
+			for (std::size_t size = 0; size <= 20; ++size)
+			{
+				CAPTURE(size);
+
+				dd_values results(size);
+				pcs::cxcm::dd_real::multiply(a.array(), b.array(), results.array(), isa);
+
+				for (std::size_t i = 0; i < size; ++i)
+					CHECK_UNARY(same_bits(results.array()[i], a.array()[i] * b.array()[i]));
+			}
+
+			auto in_place = a;
+			pcs::cxcm::dd_real::divide(in_place.array(), b.array(), in_place.array(), isa);
+			for (std::size_t i = 0; i < a.hi.size(); ++i)
+				CHECK_UNARY(same_bits(in_place.array()[i], a.array()[i] / b.array()[i]));
+		}
+	}
+
+	TEST_CASE("sum is the same for every instruction set")
+	{
+		for (std::size_t size : { std::size_t{0}, std::size_t{1}, std::size_t{31}, std::size_t{32}, std::size_t{33}, std::size_t{10'001} })
+		{
+			CAPTURE(size);
+
+			const auto values = make_values(0x50, 10, size);
+			const dd_real expected = pcs::cxcm::dd_real::sum(values.array(), pcs::simd::instruction_set::scalar);
+
+			for (auto isa : pcs::simd::runnable_instruction_sets())
+			{
+				CAPTURE(static_cast<int>(isa));
+				CHECK_UNARY(same_bits(pcs::cxcm::dd_real::sum(values.array(), isa), expected));
+			}
+		}
+
+		// the low parts are kept. these are all exact, so the order doesn't matter.
+		dd_values values(1000);
+		for (std::size_t i = 0; i < values.hi.size(); ++i)
+		{
+			values.hi[i] = 1.0;
+			values.lo[i] = 0x1p-60;
+		}
+
+		for (auto isa : pcs::simd::runnable_instruction_sets())
+		{
+			CAPTURE(static_cast<int>(isa));
+
+			const dd_real total = pcs::cxcm::dd_real::sum(values.array(), isa);
+			CHECK_EQ(total.x[0], 1000.0);
+			CHECK_EQ(total.x[1], 1000.0 * 0x1p-60);
+		}
+	}
+
+	TEST_CASE("dd_real_array")
+	{
+		std::vector<double> hi = { 1.0, 2.0, 3.0 };
+		std::vector<double> lo = { 0x1p-60, 0x1p-59 };
+
+		const pcs::cxcm::dd_real::dd_real_array values{ .hi = hi, .lo = lo };
+		const pcs::cxcm::dd_real::const_dd_real_array read_only = values;
+
+		CHECK_EQ(values.size(), 2);
+		CHECK_EQ(read_only.size(), 2);
+		CHECK_EQ(read_only[1].x[0], 2.0);
+		CHECK_EQ(read_only[1].x[1], 0x1p-59);
+	}
+}
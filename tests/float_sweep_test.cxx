@@ -0,0 +1,504 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "bam64.hxx"
+#include "bam64_simd.hxx"
+#include "periodic.hxx"
+#include "periodic_simd.hxx"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+//
+// exhaustive checks of the float paths, over all 2^32 float bit patterns. the bit patterns are split into chunks that
+// the threads take in turn, one thread per core, and each check counts the ulp errors against a reference in a histogram.
+// these take a while, so they aren't part of the periodic tests. they are built into their own float_sweep executable,
+// with src/float_sweep.cxx, and it runs them all by default.
+//
+
+namespace
+{
+	constexpr unsigned long long float_count = 0x100000000;
+	constexpr std::size_t chunk_size = 0x10000;
+
+	// floats in order, so the distance between two of them is the number of ulps between them. -0 and +0 are 1 ulp apart.
+	constexpr unsigned int ordered(float value) noexcept
+	{
+		const unsigned int bits = std::bit_cast<unsigned int>(value);
+		return ((bits & 0x80000000) != 0) ? ~bits : (bits | 0x80000000);
+	}
+
+	// error counts by powers of two: exact, 1, 2-3, 4-7, and so on. results where only one side is nan are counted on their
+	// own, as are inputs that a check doesn't compare.
+	struct ulp_histogram
+	{
+		std::array<unsigned long long, 34> counts = {};
+		unsigned long long nan_mismatches = 0;
+		unsigned long long skipped = 0;
+		unsigned long long max_ulps = 0;
+		unsigned int worst_input = 0;
+		unsigned int nan_input = 0;
+
+		void add(unsigned int input, unsigned long long ulps) noexcept
+		{
+			++counts[static_cast<std::size_t>(std::bit_width(ulps))];
+			if (ulps > max_ulps)
+			{
+				max_ulps = ulps;
+				worst_input = input;
+			}
+		}
+
+		void add(unsigned int input, float result, float reference) noexcept
+		{
+			// the usual case, which keeps the sweeps quick
+			if (std::bit_cast<unsigned int>(result) == std::bit_cast<unsigned int>(reference))
+			{
+				++counts[0];
+				return;
+			}
+
+			const bool result_nan = (result != result);
+			const bool reference_nan = (reference != reference);
+
+			if (result_nan != reference_nan)
+			{
+				if (nan_mismatches++ == 0)
+					nan_input = input;
+			}
+			else
+			{
+				const unsigned int a = ordered(result);
+				const unsigned int b = ordered(reference);
+				add(input, result_nan ? 0 : (a > b) ? (a - b) : (b - a));
+			}
+		}
+
+		// the chunks are taken in order, but the threads finish them in any order, so ties go to the smaller input
+		void merge(const ulp_histogram &other) noexcept
+		{
+			for (std::size_t i = 0; i < counts.size(); ++i)
+				counts[i] += other.counts[i];
+
+			if ((other.max_ulps > max_ulps) || ((other.max_ulps == max_ulps) && (other.worst_input < worst_input)))
+			{
+				max_ulps = other.max_ulps;
+				worst_input = other.worst_input;
+			}
+
+			if ((other.nan_mismatches != 0) && ((nan_mismatches == 0) || (other.nan_input < nan_input)))
+				nan_input = other.nan_input;
+
+			nan_mismatches += other.nan_mismatches;
+			skipped += other.skipped;
+		}
+	};
+
+	// one line per histogram, with only the buckets that have anything in them
+	void report(const char *name, const ulp_histogram &histogram)
+	{
+		std::cout << std::left << std::setw(36) << name << std::right << std::dec;
+		for (std::size_t i = 0; i < histogram.counts.size(); ++i)
+		{
+			if (histogram.counts[i] == 0)
+				continue;
+
+			if (i < 2)
+				std::cout << "  " << i << ": ";
+			else
+				std::cout << "  " << (1ULL << (i - 1)) << "-" << ((1ULL << i) - 1) << ": ";
+
+			std::cout << histogram.counts[i];
+		}
+
+		std::cout << "  (max " << histogram.max_ulps << " at 0x" << std::hex << histogram.worst_input << std::dec << ")";
+
+		if (histogram.nan_mismatches != 0)
+			std::cout << "  nan mismatches: " << histogram.nan_mismatches << " from 0x" << std::hex << histogram.nan_input << std::dec;
+
+		if (histogram.skipped != 0)
+			std::cout << "  not compared: " << histogram.skipped;
+
+		std::cout << '\n';
+	}
+
+	// calls check(first_bits, inputs, histograms) for every chunk of float bit patterns, on one thread per core. every
+	// thread has its own histograms, which are merged at the end, so nothing is shared but the next chunk to take.
+	template <std::size_t Count, typename Check>
+	std::array<ulp_histogram, Count> sweep(Check check)
+	{
+		const unsigned int thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+		std::vector<std::array<ulp_histogram, Count>> partials(thread_count);
+		std::atomic<unsigned long long> next_chunk = 0;
+
+		auto work = [&](std::array<ulp_histogram, Count> &thread_histograms)
+		{
+			std::vector<float> inputs(chunk_size);
+			for (unsigned long long first = next_chunk.fetch_add(chunk_size); first < float_count; first = next_chunk.fetch_add(chunk_size))
+			{
+				for (std::size_t i = 0; i < chunk_size; ++i)
+					inputs[i] = std::bit_cast<float>(static_cast<unsigned int>(first + i));
+
+				check(static_cast<unsigned int>(first), std::span<const float>(inputs), thread_histograms);
+			}
+		};
+
+		{
+			// the jthreads are joined at the end of the block
+			std::vector<std::jthread> threads;
+			for (unsigned int i = 1; i < thread_count; ++i)
+				threads.emplace_back(work, std::ref(partials[i]));
+
+			work(partials[0]);
+		}
+
+		std::array<ulp_histogram, Count> histograms;
+		for (const auto &partial : partials)
+		{
+			for (std::size_t i = 0; i < Count; ++i)
+				histograms[i].merge(partial[i]);
+		}
+
+		return histograms;
+	}
+
+	// reports every histogram, then checks them against the largest error allowed
+	template <std::size_t Count>
+	void check_histograms(const char *const (&names)[Count], const std::array<ulp_histogram, Count> &histograms, unsigned long long allowed_ulps)
+	{
+		for (std::size_t i = 0; i < Count; ++i)
+			report(names[i], histograms[i]);
+
+		for (std::size_t i = 0; i < Count; ++i)
+		{
+			const std::string name = names[i];
+			CAPTURE(name);
+			CHECK_LE(histograms[i].max_ulps, allowed_ulps);
+			CHECK_EQ(histograms[i].nan_mismatches, 0);
+		}
+	}
+
+	//
+	// references
+	//
+
+	// like the rest of cxcm, fract() leaves nan, infinity, zero, and values without a fractional part as they are. otherwise
+	// x - floor(x) is exact in double, or so close to 1 that rounding it to float gives the correctly rounded fract() anyway.
+	float reference_fract(float value)
+	{
+		if (!std::isfinite(value) || (value == 0.0f) || (std::abs(value) > pcs::cxcm::limits::largest_fractional_value<float>))
+			return value;
+
+		const double wide = value;
+		return static_cast<float>(wide - std::floor(wide));
+	}
+
+	// the float square root of a double square root is correctly rounded, since double has more than 2 * 24 + 2 bits
+	float reference_sqrt(float value)
+	{
+		return static_cast<float>(std::sqrt(static_cast<double>(value)));
+	}
+
+	// cxcm gives +infinity for both zeros. otherwise this has a double rounding, so it can be an ulp away from the
+	// correctly rounded result, but only when the exact result is within 2^-29 ulps of halfway between two floats.
+	float reference_rsqrt(float value)
+	{
+		if (value == 0.0f)
+			return std::numeric_limits<float>::infinity();
+
+		return static_cast<float>(1.0 / std::sqrt(static_cast<double>(value)));
+	}
+
+	// floor(value * 2^32) modulo 2^32, worked out exactly from the bits, and zero for nan and infinity
+	unsigned int reference_turns(float value)
+	{
+		const unsigned int bits = std::bit_cast<unsigned int>(value);
+		const int biased_exponent = static_cast<int>((bits >> 23) & 0xff);
+		if (biased_exponent == 0xff)
+			return 0;
+
+		// value = mantissa * 2^(exponent - 32), after scaling by 2^32
+		const long long magnitude = (bits & 0x7fffff) | ((biased_exponent != 0) ? 0x800000 : 0);
+		const long long mantissa = ((bits & 0x80000000) != 0) ? -magnitude : magnitude;
+		const int exponent = ((biased_exponent != 0) ? biased_exponent : 1) - 150 + 32;
+
+		if (exponent >= 32)
+			return 0;
+
+		if (exponent >= 0)
+			return static_cast<unsigned int>(static_cast<unsigned long long>(mantissa) << exponent);
+
+		// an arithmetic shift is a floor, and everything is gone after 25 bits
+		return static_cast<unsigned int>(mantissa >> std::min(-exponent, 25));
+	}
+
+	// the distance between two bams, the short way around the circle
+	unsigned long long bam_distance(pcs::bam32 a, pcs::bam32 b) noexcept
+	{
+		const unsigned int difference = a.value - b.value;
+		return (difference > 0x80000000) ? (0ULL - difference) & 0xffffffff : difference;
+	}
+
+	// the size of a float ulp at a double magnitude, from the exponent bits, which is much quicker than std::ilogb()
+	double float_ulp(double magnitude) noexcept
+	{
+		return std::bit_cast<double>(std::bit_cast<unsigned long long>(magnitude) & 0x7ff0000000000000) * 0x1p-23;
+	}
+
+	// how many float ulps of size unit the error is, rounded up, so any error at all is at least an ulp
+	unsigned long long scaled_ulps(double error, double unit) noexcept
+	{
+		const double ulps = error / unit;
+		const unsigned long long whole = static_cast<unsigned long long>(ulps);
+		return whole + ((static_cast<double>(whole) < ulps) ? 1 : 0);
+	}
+
+}	// namespace
+
+TEST_SUITE("exhaustive float sweeps")
+{
+	TEST_CASE("rounding functions")
+	{
+		// the scalar versions are the constexpr functions, which is what constant expressions get, and the span versions
+		// are the simd kernels. the references are the standard library functions.
+		constexpr const char *names[] =
+		{
+			"floor (constexpr)",		"floor (span)",
+			"ceil (constexpr)",			"ceil (span)",
+			"trunc (constexpr)",		"trunc (span)",
+			"round (constexpr)",		"round (span)",
+			"round_even",				"round_even (span)",
+			"fract",					"fract (span)"
+		};
+
+		const auto histograms = sweep<std::size(names)>([](unsigned int first, std::span<const float> inputs, auto &thread_histograms)
+		{
+			std::vector<float> spans(inputs.size());
+			auto check = [&](std::size_t index, auto function, auto span_function, auto reference)
+			{
+				span_function(inputs, std::span<float>(spans));
+				for (std::size_t i = 0; i < inputs.size(); ++i)
+				{
+					const float expected = reference(inputs[i]);
+					thread_histograms[index].add(first + static_cast<unsigned int>(i), function(inputs[i]), expected);
+					thread_histograms[index + 1].add(first + static_cast<unsigned int>(i), spans[i], expected);
+				}
+			};
+
+			check(0,	[](float x) { return pcs::cxcm::strict::detail::constexpr_floor(x); },
+						[](auto in, auto out) { pcs::cxcm::floor(in, out); },
+						[](float x) { return std::floor(x); });
+
+			check(2,	[](float x) { return pcs::cxcm::strict::detail::constexpr_ceil(x); },
+						[](auto in, auto out) { pcs::cxcm::ceil(in, out); },
+						[](float x) { return std::ceil(x); });
+
+			check(4,	[](float x) { return pcs::cxcm::strict::detail::constexpr_trunc(x); },
+						[](auto in, auto out) { pcs::cxcm::trunc(in, out); },
+						[](float x) { return std::trunc(x); });
+
+			check(6,	[](float x) { return pcs::cxcm::strict::detail::constexpr_round(x); },
+						[](auto in, auto out) { pcs::cxcm::round(in, out); },
+						[](float x) { return std::round(x); });
+
+			check(8,	[](float x) { return pcs::cxcm::round_even(x); },
+						[](auto in, auto out) { pcs::cxcm::round_even(in, out); },
+						[](float x) { return std::nearbyint(x); });
+
+			check(10,	[](float x) { return pcs::cxcm::fract(x); },
+						[](auto in, auto out) { pcs::cxcm::fract(in, out); },
+						reference_fract);
+		});
+
+		check_histograms(names, histograms, 0);
+	}
+
+	TEST_CASE("square roots")
+	{
+		// cxcm::sqrt() is std::sqrt() at runtime, so the one to check is the constexpr version
+		constexpr const char *names[] = { "sqrt (constexpr)", "rsqrt" };
+
+		const auto histograms = sweep<std::size(names)>([](unsigned int first, std::span<const float> inputs, auto &thread_histograms)
+		{
+			for (std::size_t i = 0; i < inputs.size(); ++i)
+			{
+				const unsigned int bits = first + static_cast<unsigned int>(i);
+				thread_histograms[0].add(bits, pcs::cxcm::strict::detail::constexpr_sqrt(inputs[i]), reference_sqrt(inputs[i]));
+				thread_histograms[1].add(bits, pcs::cxcm::rsqrt(inputs[i]), reference_rsqrt(inputs[i]));
+			}
+		});
+
+		report(names[0], histograms[0]);
+		report(names[1], histograms[1]);
+
+		CHECK_EQ(histograms[0].max_ulps, 0);
+		CHECK_EQ(histograms[0].nan_mismatches, 0);
+
+		// the reference itself can be an ulp away
+		CHECK_LE(histograms[1].max_ulps, 1);
+		CHECK_EQ(histograms[1].nan_mismatches, 0);
+	}
+
+	TEST_CASE("float bam builders")
+	{
+		// in turns, dividing by a base of 1 is exact, so the builders have to be exact too. the errors are in bam32 units.
+		constexpr const char *turn_names[] = { "bam32::from_base_float turns", "bam32::from_base turns (span)", "simd::from_base turns" };
+
+		const auto turn_histograms = sweep<std::size(turn_names)>([](unsigned int first, std::span<const float> inputs, auto &thread_histograms)
+		{
+			std::vector<pcs::bam32> spans(inputs.size());
+			std::vector<pcs::bam32> simds(inputs.size());
+			pcs::bam32::from_base(inputs, 1.0f, spans);
+			pcs::simd::from_base(inputs, 1.0f, simds);
+
+			for (std::size_t i = 0; i < inputs.size(); ++i)
+			{
+				const unsigned int bits = first + static_cast<unsigned int>(i);
+				const pcs::bam32 expected = { .value = reference_turns(inputs[i]) };
+				thread_histograms[0].add(bits, bam_distance(pcs::bam32::from_base_float(inputs[i], 1.0f), expected));
+				thread_histograms[1].add(bits, bam_distance(spans[i], expected));
+				thread_histograms[2].add(bits, bam_distance(simds[i], expected));
+			}
+		});
+
+		check_histograms(turn_names, turn_histograms, 0);
+
+		// in degrees, the turns are rounded to float, so the errors are in float ulps of the turns, but never less than a
+		// bam32 unit. the reference is the double builder. values of 2^21 turns or more have float ulps that are a big part
+		// of a turn, so they aren't compared.
+		constexpr const char *degree_names[] = { "bam32::from_base_float degrees", "bam32::from_base degrees (span)", "simd::from_base degrees" };
+
+		const auto degree_histograms = sweep<std::size(degree_names)>([](unsigned int first, std::span<const float> inputs, auto &thread_histograms)
+		{
+			std::vector<pcs::bam32> spans(inputs.size());
+			std::vector<pcs::bam32> simds(inputs.size());
+			pcs::bam32::from_base(inputs, 360.0f, spans);
+			pcs::simd::from_base(inputs, 360.0f, simds);
+
+			for (std::size_t i = 0; i < inputs.size(); ++i)
+			{
+				const unsigned int bits = first + static_cast<unsigned int>(i);
+				const double turns = static_cast<double>(inputs[i]) / 360.0;
+				if (!(std::abs(turns) < 0x1p21))
+				{
+					for (auto &histogram : thread_histograms)
+						++histogram.skipped;
+
+					continue;
+				}
+
+				const pcs::bam32 expected = pcs::bam32::from_base(static_cast<double>(inputs[i]), 360.0);
+				const double unit = std::max(1.0, float_ulp(turns) * 0x1p32);
+				thread_histograms[0].add(bits, scaled_ulps(static_cast<double>(bam_distance(pcs::bam32::from_base_float(inputs[i], 360.0f), expected)), unit));
+				thread_histograms[1].add(bits, scaled_ulps(static_cast<double>(bam_distance(spans[i], expected)), unit));
+				thread_histograms[2].add(bits, scaled_ulps(static_cast<double>(bam_distance(simds[i], expected)), unit));
+			}
+		});
+
+		check_histograms(degree_names, degree_histograms, 2);
+	}
+
+	TEST_CASE("periodic conversions")
+	{
+		struct conversion
+		{
+			float input_period;
+			float input_origin;
+			float output_min;
+			float output_period;
+		};
+
+		constexpr conversion conversions[] =
+		{
+			{ .input_period = 360.0f,		.input_origin = 90.0f,	.output_min = -180.0f,	.output_period = 360.0f },
+			{ .input_period = 6.2831855f,	.input_origin = -1.0f,	.output_min = 0.0f,		.output_period = 360.0f },
+			{ .input_period = 0.25f,		.input_origin = 3.0f,	.output_min = 0.0f,		.output_period = 24.0f }
+		};
+
+		constexpr const char *names[] =
+		{
+			"forward_convert degrees",		"reverse_convert degrees",
+			"forward_convert radians",		"reverse_convert radians",
+			"forward_convert hours",		"reverse_convert hours"
+		};
+
+		// the simd float kernels against the double ones, which give the same bits as the scalar double functions. the errors are in float ulps of the largest normalized term, times
+		// output_period, measured around the circle, so a wrap at the edge of the output range is no error at all. inputs so
+		// large that an ulp is more than 1/32 of the period don't have a meaningful answer in float, and aren't compared.
+		const auto histograms = sweep<std::size(names)>([&](unsigned int first, std::span<const float> inputs, auto &thread_histograms)
+		{
+			std::vector<float> outputs(inputs.size());
+			std::vector<double> wide_inputs(inputs.begin(), inputs.end());
+			std::vector<double> wide_outputs(inputs.size());
+			std::vector<double> units(inputs.size());
+
+			for (std::size_t c = 0; c < std::size(conversions); ++c)
+			{
+				const auto &p = conversions[c];
+				const double origin = std::abs(static_cast<double>(p.input_origin) / p.output_period);
+				const double minimum = std::abs(static_cast<double>(p.output_min) / p.output_period) + 1.0;
+				const double reciprocal = 1.0 / p.input_period;
+
+				// the same for both directions, with zero for inputs that aren't compared, and nan for nan and infinity
+				for (std::size_t i = 0; i < inputs.size(); ++i)
+				{
+					const double largest = std::max(std::max(std::abs(wide_inputs[i] * reciprocal), origin), minimum);
+					const double unit = float_ulp(largest) * p.output_period;
+					units[i] = !std::isfinite(inputs[i]) ? wide_inputs[i] - wide_inputs[i] : (unit > p.output_period / 32.0) ? 0.0 : unit;
+				}
+
+				for (bool forward : { true, false })
+				{
+					auto &histogram = thread_histograms[2 * c + (forward ? 0 : 1)];
+					if (forward)
+					{
+						pcs::simd::forward_convert(inputs, std::span<float>(outputs), p.input_period, p.input_origin, p.output_min, p.output_period);
+						pcs::simd::forward_convert(std::span<const double>(wide_inputs), std::span<double>(wide_outputs), p.input_period, p.input_origin, p.output_min, p.output_period);
+					}
+					else
+					{
+						pcs::simd::reverse_convert(inputs, std::span<float>(outputs), p.input_period, p.input_origin, p.output_min, p.output_period);
+						pcs::simd::reverse_convert(std::span<const double>(wide_inputs), std::span<double>(wide_outputs), p.input_period, p.input_origin, p.output_min, p.output_period);
+					}
+
+					for (std::size_t i = 0; i < inputs.size(); ++i)
+					{
+						const unsigned int bits = first + static_cast<unsigned int>(i);
+						if (units[i] > 0.0)
+						{
+							// both are in the output range, so they are less than a period apart
+							const double difference = std::abs(static_cast<double>(outputs[i]) - wide_outputs[i]);
+							histogram.add(bits, scaled_ulps(std::min(difference, p.output_period - difference), units[i]));
+						}
+						else if (units[i] == 0.0)
+						{
+							++histogram.skipped;
+						}
+						else
+						{
+							histogram.add(bits, outputs[i], static_cast<float>(wide_outputs[i]));
+						}
+					}
+				}
+			}
+		});
+
+		check_histograms(names, histograms, 4);
+	}
+}
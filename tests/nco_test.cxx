@@ -0,0 +1,155 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "nco.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "doctest.h"
+
+TEST_SUITE("test nco")
+{
+	TEST_CASE("phase increments")
+	{
+		// dyadic fractions of a turn are exact either way
+		CHECK_EQ(pcs::nco::phase_increment(1, 4).value, pcs::fourth);
+		CHECK_EQ(pcs::nco::phase_increment(1.0, 4.0).value, pcs::fourth);
+		CHECK_EQ(pcs::nco::phase_increment(24'000, 48'000).value, pcs::half);
+		CHECK_EQ(pcs::nco::phase_increment(48'000, 48'000).value, 0);
+		CHECK_EQ(pcs::nco::phase_increment(-1, 8).value, pcs::seven_eighths);
+		CHECK_EQ(pcs::nco::phase_increment(5.0, 4.0).value, pcs::fourth);
+
+		// 1/3 of a turn is 0x5555...5 and a third of a unit, which rounds down
+		CHECK_EQ(pcs::nco::phase_increment(1, 3).value, 0x5555555555555555);
+		CHECK_EQ(pcs::nco::phase_increment(2, 3).value, 0xaaaaaaaaaaaaaaab);
+		CHECK_EQ(pcs::nco::phase_increment(-1, 3), -pcs::nco::phase_increment(1, 3));
+
+		CHECK_EQ(pcs::nco::phase_increment(1, 0).value, 0);
+		CHECK_EQ(pcs::nco::phase_increment(1.0, 0.0).value, 0);
+		CHECK_EQ(pcs::nco::phase_increment(std::nan(""), 1.0).value, 0);
+
+		// ties go to even, however small or large the inputs
+		CHECK_EQ(pcs::nco::phase_increment(0x1p-65, 1.0).value, 0);
+		CHECK_EQ(pcs::nco::phase_increment(0x1.8p-64, 1.0).value, 2);
+		CHECK_EQ(pcs::nco::phase_increment(0x1.4p-63, 1.0).value, 2);
+		CHECK_EQ(pcs::nco::phase_increment(3.0, 0x1p65).value, 2);
+		CHECK_EQ(pcs::nco::phase_increment(0x1p-1000, 0x1p-1073).value, 0);
+		CHECK_EQ(pcs::nco::phase_increment(5e-324, 0x1p-1010).value, 1);
+		CHECK_EQ(pcs::nco::phase_increment(0x1.8p1000, 0x1p1001).value, 0xc000000000000000);
+		CHECK_EQ(pcs::nco::phase_increment(1e300, 1.0).value, 0);
+
+		// the double version agrees with the exact integer one, for integer rates that fit in a double, even with the frequency
+		// up to twice the sample rate
+		std::mt19937_64 gen(0x7c0);
+		for (int i = 0; i < 100'000; ++i)
+		{
+			const long long sample_rate = static_cast<long long>(1 + (gen() >> (13 + gen() % 50)));
+			const long long frequency = static_cast<long long>(gen() % (4 * static_cast<unsigned long long>(sample_rate))) - 2 * sample_rate;
+			CAPTURE(frequency);
+			CAPTURE(sample_rate);
+			const auto exact = pcs::nco::phase_increment(frequency, sample_rate);
+			REQUIRE_EQ(pcs::nco::phase_increment(static_cast<double>(frequency), static_cast<double>(sample_rate)), exact);
+
+			// scaling both by a power of two doesn't change the ratio
+			const int scale = static_cast<int>(gen() % 1801) - 900;
+			REQUIRE_EQ(pcs::nco::phase_increment(std::ldexp(static_cast<double>(frequency), scale),
+												 std::ldexp(static_cast<double>(sample_rate), scale)), exact);
+		}
+
+		// and with small fractions of a turn, whose high part has bits below a unit
+		CHECK_EQ(pcs::nco::phase_increment(1.0, 3e6), pcs::nco::phase_increment(1, 3'000'000));
+		CHECK_EQ(pcs::nco::phase_increment(7.0, 9'007'199'254'740'991.0), pcs::nco::phase_increment(7, 9'007'199'254'740'991LL));
+	}
+
+	TEST_CASE("oscillator")
+	{
+		pcs::nco tone(1'000, 48'000);
+		CHECK_EQ(tone.increment(), pcs::nco::phase_increment(1, 48));
+		CHECK_EQ(tone.frequency(), doctest::Approx(1000.0).epsilon(1e-15));
+		CHECK_EQ(tone.sample_rate(), 48'000.0);
+
+		// 48 samples of 1 kHz at 48 kHz is one turn, give or take the rounding of the increment
+		for (int i = 0; i < 48; ++i)
+			static_cast<void>(tone.next());
+
+		const auto after = static_cast<long long>(tone.phase().value);
+		CHECK_LT((after < 0) ? -after : after, 48);
+
+		// advance() is the same as that many next() calls
+		pcs::nco stepped(0.3, 1.0, pcs::bam64{ .value = 12345 });
+		pcs::nco skipped = stepped;
+		for (int i = 0; i < 1000; ++i)
+			static_cast<void>(stepped.next());
+
+		skipped.advance(1000);
+		CHECK_EQ(skipped.phase(), stepped.phase());
+
+		// negative frequencies
+		const pcs::nco down(-1'000, 48'000);
+		CHECK_EQ(down.frequency(), doctest::Approx(-1000.0).epsilon(1e-15));
+		CHECK_EQ(pcs::nco(pcs::bam64{ .value = pcs::half }).frequency(), 0.5);
+
+		CHECK_THROWS_AS(pcs::nco(1.0, 0.0), std::invalid_argument);
+		CHECK_THROWS_AS(pcs::nco(1.0, -48'000.0), std::invalid_argument);
+		CHECK_THROWS_AS(pcs::nco(INFINITY, 1.0), std::invalid_argument);
+		CHECK_THROWS_AS(pcs::nco(1, 0), std::invalid_argument);
+	}
+
+	TEST_CASE("blocks")
+	{
+		const std::size_t size = 1000;
+		for (auto isa : pcs::simd::runnable_instruction_sets())
+		{
+			CAPTURE(static_cast<int>(isa));
+
+			// blocks of odd sizes, with a change of frequency between two of them, match one sample at a time
+			pcs::nco blocks(12'345'678.0, 250e6, pcs::bam64{ .value = 0xdeadbeef });
+			pcs::nco reference = blocks;
+
+			std::vector<pcs::bam64> phases(size);
+			blocks.phases(std::span<pcs::bam64>(phases).first(333), isa);
+			blocks.set_frequency(-3'000'000);
+			blocks.phases(std::span<pcs::bam64>(phases).subspan(333), isa);
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				if (i == 333)
+					reference.set_frequency(-3'000'000);
+
+				REQUIRE_EQ(phases[i], reference.next());
+			}
+
+			CHECK_EQ(blocks.phase(), reference.phase());
+			CHECK_EQ(blocks.increment(), pcs::nco::phase_increment(-3'000'000, 250'000'000));
+
+			// sines and cosines, across more than one batch
+			std::vector<double> sines(size);
+			std::vector<double> cosines(size);
+			std::vector<std::complex<double>> phasors(size);
+			pcs::nco trig = reference;
+			pcs::nco complex = reference;
+			trig.sincos(sines, cosines, pcs::trig_accuracy::precise, isa);
+			complex.phasors(phasors, pcs::trig_accuracy::precise, isa);
+			CHECK_EQ(trig.phase(), complex.phase());
+
+			double worst = 0.0;
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				const auto [sin_value, cos_value] = pcs::sincos(reference.next());
+				worst = std::max({ worst, std::abs(sines[i] - sin_value), std::abs(cosines[i] - cos_value),
+								   std::abs(phasors[i].real() - cos_value), std::abs(phasors[i].imag() - sin_value) });
+			}
+
+			// see the simd sincos tests
+			CHECK_LE(worst, 0x1p-52);
+			CHECK_EQ(trig.phase(), reference.phase());
+		}
+	}
+}
@@ -0,0 +1,168 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "periodic_frame_graph.hxx"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+	// distance between two values, allowing for wraparound
+	double periodic_distance(double a, double b, double period)
+	{
+		const double difference = std::fmod(std::abs(a - b), period);
+		return (difference < (period - difference)) ? difference : (period - difference);
+	}
+
+}	// namespace
+
+TEST_SUITE("test periodic frame graph")
+{
+	TEST_CASE("composed conversions")
+	{
+		// math angles in degrees at the root, counterclockwise from east
+		pcs::periodic_frame_graph graph(360.0, -180.0);
+		const auto math = graph.root();
+
+		// bearings are clockwise from north, which is at 90 degrees math
+		const auto bearing = graph.add_frame(math, -1, 90.0, 360.0);
+
+		// a vehicle heading 30 degrees, with relative bearings in [-180, 180)
+		const auto vehicle = graph.add_frame(bearing, 1, 30.0, 360.0, -180.0);
+
+		// a sensor in radians, counterclockwise, mounted 45 degrees to the right of the vehicle's nose
+		const auto sensor = graph.add_frame(vehicle, -1, 45.0, pcs::two_pi, -pcs::pi);
+
+		CHECK_EQ(graph.size(), 4);
+
+		CHECK_EQ(graph.convert(bearing, math, 0.0), doctest::Approx(90.0));
+		CHECK_EQ(graph.convert(bearing, math, 90.0), doctest::Approx(0.0));
+		CHECK_EQ(graph.convert(bearing, math, 180.0), doctest::Approx(-90.0));
+		CHECK_EQ(graph.convert(math, bearing, 0.0), doctest::Approx(90.0));
+		CHECK_EQ(graph.convert(math, bearing, 180.0), doctest::Approx(270.0));
+
+		CHECK_EQ(graph.convert(vehicle, bearing, 0.0), doctest::Approx(30.0));
+		CHECK_LT(periodic_distance(graph.convert(vehicle, bearing, -30.0), 0.0, 360.0), 1e-12);
+		CHECK_EQ(graph.convert(vehicle, math, 0.0), doctest::Approx(60.0));
+		CHECK_EQ(graph.convert(bearing, vehicle, 0.0), doctest::Approx(-30.0));
+
+		CHECK_EQ(graph.convert(sensor, vehicle, pcs::pi / 4.0), doctest::Approx(0.0));
+		CHECK_EQ(graph.convert(sensor, math, 0.0), doctest::Approx(15.0));
+		CHECK_EQ(graph.convert(math, sensor, 15.0), doctest::Approx(0.0));
+		CHECK_EQ(graph.convert(sensor, sensor, 1.0), doctest::Approx(1.0));
+
+		// the fused converter matches converting one step at a time
+		std::mt19937_64 gen(0xf4a3e);
+		std::uniform_real_distribution<double> dist(-10.0, 10.0);
+		for (int i = 0; i < 1000; ++i)
+		{
+			const double radians = dist(gen);
+			const double in_vehicle = pcs::reverse_convert(radians, pcs::two_pi, 45.0, -180.0, 360.0);
+			const double in_bearing = pcs::forward_convert(in_vehicle, 360.0, 30.0, 0.0, 360.0);
+			const double in_math = pcs::reverse_convert(in_bearing, 360.0, 90.0, -180.0, 360.0);
+
+			CHECK_LT(periodic_distance(graph.convert(sensor, math, radians), in_math, 360.0), 1e-11);
+			CHECK_LT(periodic_distance(graph.convert(math, sensor, graph.convert(sensor, math, radians)), radians, pcs::two_pi), 1e-12);
+		}
+
+		// outputs are in the destination's range
+		const auto to_sensor = graph.converter(math, sensor);
+		for (double degrees = -720.0; degrees <= 720.0; degrees += 7.5)
+		{
+			const double radians = to_sensor(degrees);
+			CHECK_GE(radians, -pcs::pi);
+			CHECK_LT(radians, pcs::pi);
+		}
+	}
+
+	TEST_CASE("fused converters")
+	{
+		pcs::periodic_frame_graph graph(360.0);
+		const auto bearing = graph.add_frame(graph.root(), -1, 90.0, 360.0);
+		const auto flipped = graph.add_frame(bearing, -1, 0.0, 1.0);
+
+		// two opposite orientations collapse to the same orientation
+		CHECK_EQ(graph.converter(bearing, graph.root()).orientation, -1);
+		CHECK_EQ(graph.converter(flipped, graph.root()).orientation, 1);
+
+		// reverse() swaps the orientation, like the other converters
+		const auto converter = graph.converter(bearing, graph.root());
+		CHECK_EQ(converter.reverse(90.0), doctest::Approx(180.0));
+
+		std::vector<double> input{ 0.0, 90.0, 180.0, 270.0 };
+		std::vector<double> output(input.size());
+		converter.forward(input, output);
+		CHECK_EQ(output[0], doctest::Approx(90.0));
+		CHECK_EQ(output[2], doctest::Approx(270.0));
+		CHECK_EQ(output[3], doctest::Approx(180.0));
+
+		// right at the boundary, so it can wrap either way, e.g., when the compiler uses fma
+		CHECK_LT(periodic_distance(output[1], 0.0, 360.0), 1e-12);
+
+		converter.reverse(input, output);
+		for (std::size_t i = 0; i < input.size(); ++i)
+			CHECK_EQ(output[i], converter.reverse(input[i]));
+	}
+
+	TEST_CASE("cache")
+	{
+		pcs::periodic_frame_graph graph(360.0);
+		const auto bearing = graph.add_frame(graph.root(), -1, 90.0, 360.0);
+		const auto vehicle = graph.add_frame(bearing, 1, 30.0, 360.0);
+		const auto sensor = graph.add_frame(vehicle, 1, 10.0, 360.0);
+		const auto other = graph.add_frame(graph.root(), 1, 5.0, 360.0);
+
+		CHECK_EQ(graph.find(sensor, graph.root()), nullptr);
+		graph.warm(sensor, graph.root());
+		REQUIRE_NE(graph.find(sensor, graph.root()), nullptr);
+		CHECK_EQ(graph.find(graph.root(), sensor), nullptr);
+		CHECK_EQ((*graph.find(sensor, graph.root()))(0.0), doctest::Approx(50.0));
+
+		// moving the vehicle moves the sensor, but not the frames beside it
+		graph.warm(other, graph.root());
+		graph.set_origin(vehicle, 40.0);
+		CHECK_EQ(graph.find(sensor, graph.root()), nullptr);
+		CHECK_EQ(graph.convert(sensor, graph.root(), 0.0), doctest::Approx(40.0));
+		CHECK_EQ(graph.convert(other, graph.root(), 0.0), doctest::Approx(5.0));
+
+		// growing keeps the cached pairs
+		std::vector<pcs::frame_id> frames{ graph.root(), bearing, vehicle, sensor, other };
+		for (int i = 0; i < 20; ++i)
+			frames.push_back(graph.add_frame(frames[i], (i % 2) ? 1 : -1, 1.0 * i, 360.0));
+
+		for (auto from : frames)
+			for (auto to : frames)
+				graph.warm(from, to);
+
+		for (auto from : frames)
+		{
+			for (auto to : frames)
+			{
+				REQUIRE_NE(graph.find(from, to), nullptr);
+				CHECK_LT(periodic_distance(graph.convert(to, from, (*graph.find(from, to))(123.0)), 123.0, 360.0), 1e-11);
+			}
+		}
+
+		graph.clear_cache();
+		CHECK_EQ(graph.find(sensor, graph.root()), nullptr);
+	}
+
+	TEST_CASE("errors")
+	{
+		CHECK_THROWS_AS(pcs::periodic_frame_graph(0.0), std::invalid_argument);
+
+		pcs::periodic_frame_graph graph;
+		CHECK_THROWS_AS(graph.add_frame(7, 1, 0.0, 1.0), std::out_of_range);
+		CHECK_THROWS_AS(graph.add_frame(graph.root(), 0, 0.0, 1.0), std::invalid_argument);
+		CHECK_THROWS_AS(graph.add_frame(graph.root(), 1, 0.0, 0.0), std::invalid_argument);
+		CHECK_THROWS_AS(graph.set_origin(graph.root(), 0.0), std::invalid_argument);
+		CHECK_THROWS_AS(static_cast<void>(graph.convert(graph.root(), 3, 0.0)), std::out_of_range);
+	}
+}
@@ -0,0 +1,125 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "periodic_frame_graph.hxx"
+#include "periodic_transform.hxx"
+
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+TEST_SUITE("test periodic transform")
+{
+	TEST_CASE("bearing example")
+	{
+		// from the README, bearing to math in turns is theta = -1 and P = 0.25
+		const auto bearing_to_math = pcs::periodic_transform::from_origin(-1, 0.25);
+
+		CHECK_EQ(bearing_to_math(pcs::bam64{ .value = 0 }), pcs::bam64{ .value = pcs::fourth });
+		CHECK_EQ(bearing_to_math(pcs::bam64{ .value = pcs::fourth }), pcs::bam64{ .value = 0 });
+		CHECK_EQ(bearing_to_math(pcs::bam64{ .value = pcs::half }), pcs::bam64{ .value = pcs::three_fourths });
+
+		// the inverse is the same, since the two origins are both a quarter turn along
+		CHECK_EQ(bearing_to_math.inverse(), bearing_to_math);
+		CHECK_EQ(bearing_to_math * bearing_to_math.inverse(), pcs::identity_transform());
+
+		// the same orientation example, where math is a quarter turn backwards from a counterclockwise bearing
+		const auto ccw_bearing_to_math = pcs::periodic_transform::from_origin(1, 0.25);
+		CHECK_EQ(ccw_bearing_to_math.inverse().offset.value, pcs::three_fourths);
+		CHECK_EQ(ccw_bearing_to_math.inverse().input_origin(), 0.75);
+
+		// doubles, with the periods
+		const auto degrees = pcs::periodic_transform::from_origin(-1, 90.0, 360.0, 360.0);
+		CHECK_EQ(degrees.convert(90.0), doctest::Approx(0.0));
+		CHECK_EQ(degrees.convert(180.0, -180.0), doctest::Approx(-90.0));
+		CHECK_EQ(degrees.convert(30.0), pcs::reverse_convert(30.0, 360.0, 90.0, 0.0, 360.0));
+	}
+
+	TEST_CASE("algebra")
+	{
+		std::mt19937_64 gen(0x7a4f);
+		for (int i = 0; i < 1000; ++i)
+		{
+			const pcs::periodic_transform a{ .orientation = static_cast<std::int8_t>((gen() & 1) ? 1 : -1), .offset = { .value = gen() } };
+			const pcs::periodic_transform b{ .orientation = static_cast<std::int8_t>((gen() & 1) ? 1 : -1), .offset = { .value = gen() } };
+			const pcs::periodic_transform c{ .orientation = static_cast<std::int8_t>((gen() & 1) ? 1 : -1), .offset = { .value = gen() } };
+			const pcs::bam64 x{ .value = gen() };
+
+			// composition is applying one after the other, exactly
+			CHECK_EQ((a * b)(x), a(b(x)));
+			CHECK_EQ((a * b) * c, a * (b * c));
+			CHECK_EQ(a.inverse()(a(x)), x);
+			CHECK_EQ(a * a.inverse(), pcs::identity_transform());
+			CHECK_EQ((a * b).inverse(), b.inverse() * a.inverse());
+		}
+
+		// the periods follow the outer systems
+		const auto a = pcs::periodic_transform::from_origin(1, 10.0, pcs::two_pi, 360.0);
+		const auto b = pcs::periodic_transform::from_origin(-1, 0.5, 360.0, 1.0);
+		CHECK_EQ((b * a).input_period, pcs::two_pi);
+		CHECK_EQ((b * a).output_period, 1.0);
+		CHECK_EQ(a.inverse().input_period, 360.0);
+		CHECK_EQ(a.inverse().output_period, pcs::two_pi);
+
+		// usable at compile time
+		constexpr auto turned = pcs::periodic_transform::from_origin(-1, 0.25) * pcs::periodic_transform::from_origin(1, 0.5);
+		static_assert(turned.orientation == -1);
+		static_assert(turned.offset.value == pcs::three_fourths);
+	}
+
+	TEST_CASE("converters")
+	{
+		const auto forward = pcs::forward_period_converter{ .input_period = 360.0, .output_period = pcs::two_pi, .input_origin = 1.0, .output_min = -pcs::pi };
+		const auto reverse = pcs::reverse_period_converter{ .input_period = 360.0, .output_period = pcs::two_pi, .input_origin = 1.0, .output_min = -pcs::pi };
+
+		const auto from_forward = pcs::periodic_transform::from_converter(forward);
+		const auto from_reverse = pcs::periodic_transform::from_converter(reverse);
+		CHECK_EQ(from_forward.orientation, 1);
+		CHECK_EQ(from_reverse.orientation, -1);
+
+		for (double value = -720.0; value <= 720.0; value += 12.5)
+		{
+			CHECK_EQ(from_forward.convert(value, -pcs::pi), doctest::Approx(forward(value)));
+			CHECK_EQ(from_reverse.convert(value, -pcs::pi), doctest::Approx(reverse(value)));
+		}
+	}
+
+	TEST_CASE("batch apply")
+	{
+		std::mt19937_64 gen(0xba7c);
+		std::vector<pcs::bam64> input(1000);
+		for (auto &value : input)
+			value.value = gen();
+
+		std::vector<pcs::bam64> output(input.size());
+		for (int orientation : { 1, -1 })
+		{
+			const pcs::periodic_transform transform{ .orientation = static_cast<std::int8_t>(orientation), .offset = { .value = gen() } };
+			transform.apply(input, output);
+			for (std::size_t i = 0; i < input.size(); ++i)
+				CHECK_EQ(output[i], transform(input[i]));
+		}
+
+		// only as many values as the shorter span
+		std::vector<pcs::bam64> shorter(10, pcs::bam64{ .value = 0 });
+		pcs::identity_transform().apply(input, shorter);
+		CHECK_EQ(shorter[9], input[9]);
+	}
+
+	TEST_CASE("frame graph transforms")
+	{
+		pcs::periodic_frame_graph graph(360.0, -180.0);
+		const auto bearing = graph.add_frame(graph.root(), -1, 90.0, 360.0);
+		const auto vehicle = graph.add_frame(bearing, 1, 30.0, 360.0, -180.0);
+
+		// stored bams go between frames without any floating-point
+		const auto vehicle_to_math = graph.transform(vehicle, graph.root());
+		CHECK_EQ(vehicle_to_math.orientation, -1);
+		CHECK_EQ(vehicle_to_math(pcs::bam64{ .value = 0 }).fraction(360.0), doctest::Approx(60.0));
+		CHECK_EQ(vehicle_to_math.input_period, 360.0);
+		CHECK_EQ(graph.transform(graph.root(), vehicle), vehicle_to_math.inverse());
+	}
+}
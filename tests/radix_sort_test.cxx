@@ -0,0 +1,191 @@
+//          Copyright David Browne 2025.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "radix_sort.hxx"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+	std::vector<pcs::bam64> make_keys(std::size_t size, unsigned long long mask, unsigned long long seed)
+	{
+		std::mt19937_64 gen(seed);
+		std::vector<pcs::bam64> keys(size);
+		for (auto &key : keys)
+			key.value = gen() & mask;
+
+		return keys;
+	}
+
+	// copyable, but without a default constructor
+	struct index_payload
+	{
+		explicit index_payload(std::size_t value) : index(value)
+		{
+		}
+
+		std::size_t index;
+	};
+
+}	// namespace
+
+TEST_SUITE("test radix sort")
+{
+	TEST_CASE("matches std::sort")
+	{
+		const unsigned long long masks[] =
+		{
+			~0ULL,							// every pass
+			~0x7ffULL,						// 53 bits, the lowest pass is skipped
+			0x00000000ffffffffULL,			// the upper passes are skipped
+			0x0000000000000f0fULL,			// lots of duplicates
+			0ULL							// all the same
+		};
+
+		for (auto mask : masks)
+		{
+			CAPTURE(mask);
+			for (std::size_t size : { 0, 1, 2, 100, 5000 })
+			{
+				auto keys = make_keys(size, mask, size + 17);
+				auto expected = keys;
+				std::sort(expected.begin(), expected.end());
+
+				pcs::radix_sort(keys);
+				CHECK_EQ(keys, expected);
+			}
+		}
+
+		// a small arc across zero
+		auto arc = make_keys(3000, 0xfffffffULL, 0xa2c);
+		for (std::size_t i = 0; i < arc.size(); i += 2)
+			arc[i] = -arc[i];
+
+		auto expected = arc;
+		std::sort(expected.begin(), expected.end());
+		pcs::radix_sort(arc);
+		CHECK_EQ(arc, expected);
+	}
+
+	TEST_CASE("payloads")
+	{
+		auto keys = make_keys(10'000, 0xff00000000000000ULL, 0x9a1);
+		const auto original = keys;
+
+		std::vector<std::size_t> payloads(keys.size());
+		for (std::size_t i = 0; i < payloads.size(); ++i)
+			payloads[i] = i;
+
+		pcs::radix_sort(std::span<pcs::bam64>(keys), std::span<std::size_t>(payloads));
+
+		// stable, so equal keys keep their order
+		CHECK(std::is_sorted(keys.begin(), keys.end()));
+		for (std::size_t i = 0; i < keys.size(); ++i)
+		{
+			CHECK_EQ(original[payloads[i]], keys[i]);
+			if ((i > 0) && (keys[i] == keys[i - 1]))
+				CHECK_LT(payloads[i - 1], payloads[i]);
+		}
+
+		std::vector<double> too_few(3);
+		CHECK_THROWS_AS(pcs::radix_sort(std::span<pcs::bam64>(keys), std::span<double>(too_few)), std::invalid_argument);
+		CHECK_THROWS_AS(pcs::parallel_radix_sort(std::span<pcs::bam64>(keys), std::span<double>(too_few)), std::invalid_argument);
+	}
+
+	TEST_CASE("payloads without a default constructor")
+	{
+		const std::size_t size = 2 * pcs::detail::radix_parallel_minimum + 3;
+		const auto original = make_keys(size, 0x0000ff0000ff0000ULL, 0xdef);
+
+		// far more threads than there are keys or cores gets clamped
+		for (unsigned int threads : { 1u, 3u, 100'000u })
+		{
+			CAPTURE(threads);
+			auto keys = original;
+			std::vector<index_payload> payloads;
+			for (std::size_t i = 0; i < size; ++i)
+				payloads.emplace_back(i);
+
+			if (threads == 1)
+				pcs::radix_sort(std::span<pcs::bam64>(keys), std::span<index_payload>(payloads));
+			else
+				pcs::parallel_radix_sort(std::span<pcs::bam64>(keys), std::span<index_payload>(payloads), threads);
+
+			CHECK(std::is_sorted(keys.begin(), keys.end()));
+			std::size_t mismatches = 0;
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				if (original[payloads[i].index] != keys[i])
+					++mismatches;
+			}
+			CHECK_EQ(mismatches, 0);
+		}
+	}
+
+	TEST_CASE("parallel matches serial")
+	{
+		const std::size_t size = 3 * pcs::detail::radix_parallel_minimum + 5;
+		for (auto mask : { ~0ULL, ~0x7ffULL, 0x0000000000ff00ffULL })
+		{
+			CAPTURE(mask);
+			auto serial_keys = make_keys(size, mask, 0x5e1);
+			std::vector<unsigned int> serial_payloads(size);
+			for (std::size_t i = 0; i < size; ++i)
+				serial_payloads[i] = static_cast<unsigned int>(i);
+
+			const auto original_keys = serial_keys;
+			const auto original_payloads = serial_payloads;
+			pcs::radix_sort(std::span<pcs::bam64>(serial_keys), std::span<unsigned int>(serial_payloads));
+
+			for (unsigned int threads : { 2u, 3u, 7u, 0u })
+			{
+				CAPTURE(threads);
+				auto keys = original_keys;
+				auto payloads = original_payloads;
+				pcs::parallel_radix_sort(std::span<pcs::bam64>(keys), std::span<unsigned int>(payloads), threads);
+				CHECK_EQ(keys, serial_keys);
+				CHECK_EQ(payloads, serial_payloads);
+
+				auto alone = original_keys;
+				pcs::parallel_radix_sort(alone, threads);
+				CHECK_EQ(alone, serial_keys);
+
+				// parallel_radix_sort() doesn't use more threads than there are cores, so this uses them however many there are
+				if (threads != 0)
+				{
+					auto forced_keys = original_keys;
+					auto forced_payloads = original_payloads;
+					pcs::detail::radix_sort<true, unsigned int>(forced_keys, forced_payloads.data(), threads);
+					CHECK_EQ(forced_keys, serial_keys);
+					CHECK_EQ(forced_payloads, serial_payloads);
+				}
+			}
+		}
+	}
+
+	TEST_CASE("thread counts")
+	{
+		using pcs::detail::radix_parallel_minimum;
+		const std::size_t cores = std::thread::hardware_concurrency();
+
+		// at least one, even for nothing to sort
+		CHECK_EQ(pcs::detail::radix_thread_count(0, 0), 1);
+		CHECK_EQ(pcs::detail::radix_thread_count(100'000, 10), 1);
+
+		// one for every radix_parallel_minimum keys
+		CHECK_LE(pcs::detail::radix_thread_count(100'000, 3 * radix_parallel_minimum + 5), 3);
+
+		// and no more than there are cores
+		const std::size_t many = pcs::detail::radix_thread_count(100'000, 1'000'000 * radix_parallel_minimum);
+		CHECK_LE(many, (cores == 0) ? 100'000 : cores);
+		CHECK_EQ(pcs::detail::radix_thread_count(2, 1'000'000 * radix_parallel_minimum), (cores == 1) ? 1 : 2);
+	}
+}